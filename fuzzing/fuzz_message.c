@@ -3,39 +3,53 @@
 
 #include "parse_tx.h"
 
-// mock validate_address to avoid crypto function calls
-bool validate_address(const char *address)
+// mock decode_address to avoid crypto function calls (no checksum check)
+bool decode_address(Compressed *pub_key, const char *address)
 {
     if (strnlen(address, MINA_ADDRESS_LEN) != MINA_ADDRESS_LEN - 1) {
         return false;
     }
 
+    read_public_key_compressed(pub_key, address);
+
+    return true;
+}
+
+// mock encode_address, the inverse of the mock above
+bool encode_address(char *address, const size_t len, const Compressed *pub_key)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    if (len != MINA_ADDRESS_LEN) {
+        return false;
+    }
+
+    for (size_t i = 0; i < MINA_ADDRESS_LEN - 1; i++) {
+        uint8_t b = pub_key->x[i / 2 % FIELD_BYTES];
+        address[i] = hex[i % 2 ? b & 0x0f : b >> 4];
+    }
+    address[MINA_ADDRESS_LEN - 1] = '\0';
+
     return true;
 }
 
 int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
     tx_t tx;
-    ui_t ui;
 
-    if (!parse_tx(Data, Size, &tx, &ui)) {
+    if (!parse_tx(Data, Size, &tx)) {
         return 0;
     }
 
-    // determines the length of each UI field to ensure that uninitialized
-    // memory will be catched by sanitizers
+    // formats every review field and determines its length to ensure that
+    // uninitialized memory will be catched by sanitizers
+    char field[TX_FIELD_MAX_LEN];
     size_t len = 0;
 
-    len += strlen(ui.from);
-    len += strlen(ui.to);
-    len += strlen(ui.amount);
-    len += strlen(ui.fee);
-    len += strlen(ui.total);
-    len += strlen(ui.nonce);
-    len += strlen(ui.valid_until);
-    len += strlen(ui.memo);
-    len += strlen(ui.type);
-    len += strlen(ui.from_title);
-    len += strlen(ui.to_title);
+    for (tx_field_t f = 0; f < TX_FIELD_COUNT; f++) {
+        if (format_tx_field(field, sizeof(field), &tx, f)) {
+            len += strlen(field);
+        }
+    }
 
     // use the resulting length to prevents compiler optimization
     assert(len > 0 && len < 4096);
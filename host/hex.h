@@ -0,0 +1,18 @@
+// Hex parsing shared by the host tools
+
+#pragma once
+
+// Value of a hex digit, or -1
+static inline int hex_nibble(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
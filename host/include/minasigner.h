@@ -0,0 +1,129 @@
+// libminasigner - Mina transaction signer for the host
+//
+//     The device signer sources (src/) built natively, behind a small API
+//     that only uses fixed size byte arrays and plain C types.  Field
+//     elements and scalars are 32 byte big-endian integers.
+//
+//     All functions are thread safe and return MINASIGNER_OK on success.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MINASIGNER_BUILD) && defined(__GNUC__)
+    #define MINASIGNER_API __attribute__((visibility("default")))
+#else
+    #define MINASIGNER_API
+#endif
+
+#define MINASIGNER_API_VERSION 3
+
+#define MINASIGNER_FIELD_BYTES  32
+#define MINASIGNER_SCALAR_BYTES 32
+#define MINASIGNER_ADDRESS_LEN  56 // includes null-byte
+#define MINASIGNER_MEMO_LEN     32 // excludes null-byte
+
+#define MINASIGNER_TESTNET 0x00
+#define MINASIGNER_MAINNET 0x01
+
+#define MINASIGNER_PAYMENT    0x00
+#define MINASIGNER_DELEGATION 0x04
+
+typedef enum {
+    MINASIGNER_OK                =  0,
+    MINASIGNER_ERR_ARGUMENT      = -1, // malformed or out of range input
+    MINASIGNER_ERR_ADDRESS       = -2, // invalid address
+    MINASIGNER_ERR_KEY           = -3, // invalid secret or public key
+    MINASIGNER_ERR_SIGNATURE     = -4, // signature does not verify
+    MINASIGNER_ERR_INTERNAL      = -5
+} minasigner_status_t;
+
+typedef struct {
+    uint8_t x[MINASIGNER_FIELD_BYTES];
+    uint8_t y[MINASIGNER_FIELD_BYTES];
+} minasigner_public_key_t;
+
+typedef struct {
+    uint8_t                 secret[MINASIGNER_SCALAR_BYTES];
+    minasigner_public_key_t pub;
+} minasigner_keypair_t;
+
+typedef struct {
+    uint8_t rx[MINASIGNER_FIELD_BYTES];
+    uint8_t s[MINASIGNER_SCALAR_BYTES];
+} minasigner_signature_t;
+
+typedef struct {
+    uint8_t  tag;                           // MINASIGNER_PAYMENT or MINASIGNER_DELEGATION
+    char     from[MINASIGNER_ADDRESS_LEN];
+    char     to[MINASIGNER_ADDRESS_LEN];    // receiver or delegate
+    uint64_t amount;                        // nanomina, 0 for delegations
+    uint64_t fee;                           // nanomina
+    uint32_t nonce;
+    uint32_t valid_until;
+    char     memo[MINASIGNER_MEMO_LEN + 1];
+} minasigner_transaction_t;
+
+// Returns MINASIGNER_API_VERSION of the library
+MINASIGNER_API int minasigner_api_version(void);
+
+// Computes the keypair for a secret scalar in [1, group order)
+MINASIGNER_API minasigner_status_t minasigner_keypair_from_secret(minasigner_keypair_t *kp,
+                                                                  const uint8_t secret[MINASIGNER_SCALAR_BYTES]);
+
+// Sets the BIP39 mnemonic (and optional passphrase) that accounts are
+// derived from; call before deriving keys from several threads.  Without
+// it the MINA_MNEMONIC environment variable is used.  (version 2)
+MINASIGNER_API minasigner_status_t minasigner_set_mnemonic(const char *mnemonic,
+                                                           const char *passphrase);
+
+// Derives the keypair of BIP44 account 44'/12586'/account'/0/0 like the
+// device (version 2)
+MINASIGNER_API minasigner_status_t minasigner_keypair_from_account(minasigner_keypair_t *kp,
+                                                                   uint32_t account);
+
+// Encodes a public key as a null-terminated base58 check address
+MINASIGNER_API minasigner_status_t minasigner_address(char address[MINASIGNER_ADDRESS_LEN],
+                                                      const minasigner_public_key_t *pub);
+
+// Checks the length, version bytes and checksum of an address
+MINASIGNER_API minasigner_status_t minasigner_address_validate(const char *address);
+
+// Signs a payment or delegation with the same rules as the device.  Fails
+// with MINASIGNER_ERR_KEY unless kp->pub is the public key of kp->secret
+// and tx->from (the source and fee payer) is its address.
+MINASIGNER_API minasigner_status_t minasigner_sign_transaction(minasigner_signature_t *sig,
+                                                               const minasigner_keypair_t *kp,
+                                                               const minasigner_transaction_t *tx,
+                                                               uint8_t network_id);
+
+// Signs count transactions, txs[i] with kps[i] on network_ids[i], like
+// minasigner_sign_transaction() and sets status[i] to its result.  The
+// nonces of up to eight transactions are derived at once.  Returns
+// MINASIGNER_OK if all were signed, else the first error (version 3)
+MINASIGNER_API minasigner_status_t minasigner_sign_transactions(minasigner_signature_t *sigs,
+                                                                minasigner_status_t *status,
+                                                                const minasigner_keypair_t *const kps[],
+                                                                const minasigner_transaction_t *txs,
+                                                                const uint8_t *network_ids,
+                                                                size_t count);
+
+// Verifies a transaction signature
+MINASIGNER_API minasigner_status_t minasigner_verify_transaction(const minasigner_signature_t *sig,
+                                                                 const minasigner_public_key_t *pub,
+                                                                 const minasigner_transaction_t *tx,
+                                                                 uint8_t network_id);
+
+// Poseidon hash of field elements with the network's signature prefix
+MINASIGNER_API minasigner_status_t minasigner_poseidon(uint8_t out[MINASIGNER_FIELD_BYTES],
+                                                       const uint8_t (*in)[MINASIGNER_FIELD_BYTES],
+                                                       size_t len, uint8_t network_id);
+
+#ifdef __cplusplus
+}
+#endif
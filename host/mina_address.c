@@ -0,0 +1,476 @@
+// Bulk Mina address validation and encoding
+//
+//     Applies exactly the device address rules (src/crypto.c) to
+//     newline-delimited input.  The input is memory mapped and split at
+//     line boundaries across worker threads; each worker formats into its
+//     own buffer and the buffers are written out in input order.  Workers
+//     compute the base58 check checksums of CX_SHA256_LANES lines at once
+//     (cx_sha256d_multi).
+//
+//     Usage: mina_address [-j threads] validate|encode|derive [file]
+//
+//         validate  <address>             -> valid|invalid\t<address>
+//         encode    <hex x><hex y> (128)  -> <address>|invalid\t<input>
+//         derive    <account>             -> <account>\t<address>|invalid\t<input>
+//
+//     derive uses the device key derivation with the BIP39 mnemonic in
+//     MINA_MNEMONIC (and optional MINA_PASSPHRASE).
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "crypto.h"
+#include "cx_sha256_multi.h"
+#include "hex.h"
+#include "os.h"
+
+#define MAX_THREADS 256
+
+typedef enum {
+    MODE_VALIDATE,
+    MODE_ENCODE,
+    MODE_DERIVE
+} address_mode_t;
+
+typedef struct {
+    char  *data;
+    size_t len;
+    size_t cap;
+} outbuf_t;
+
+// A line whose address bytes wait for their checksum
+typedef struct {
+    const char *line;
+    size_t      len;
+    bool        ok;
+    RawAddress  raw;
+} pending_t;
+
+typedef struct {
+    address_mode_t mode;
+    const char *begin;
+    const char *end;
+    outbuf_t    out;
+    pending_t   pending[CX_SHA256_LANES];
+    size_t      pending_len;
+    size_t      valid;
+    size_t      invalid;
+    bool        failed;
+} job_t;
+
+static bool out_append(outbuf_t *out, const char *s, size_t len)
+{
+    if (out->len + len > out->cap) {
+        size_t cap = out->cap ? out->cap : 4096;
+        while (cap < out->len + len) {
+            cap *= 2;
+        }
+        char *data = realloc(out->data, cap);
+        if (!data) {
+            return false;
+        }
+        out->data = data;
+        out->cap = cap;
+    }
+    memcpy(out->data + out->len, s, len);
+    out->len += len;
+    return true;
+}
+
+static bool out_result(job_t *job, const char *prefix, const char *line, size_t len)
+{
+    return out_append(&job->out, prefix, strlen(prefix))
+        && out_append(&job->out, line, len)
+        && out_append(&job->out, "\n", 1);
+}
+
+static bool parse_field(Field f, const char *hex)
+{
+    for (size_t i = 0; i < FIELD_BYTES; i++) {
+        int hi = hex_nibble(hex[2*i]);
+        int lo = hex_nibble(hex[2*i + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        f[i] = hi << 4 | lo;
+    }
+    return true;
+}
+
+static void compress(Compressed *c, const Affine *pub)
+{
+    field_copy(c->x, pub->x);
+    c->is_odd = field_is_odd(pub->y);
+}
+
+static bool validate_line(pending_t *p)
+{
+    char address[MINA_ADDRESS_LEN];
+
+    // raw_address_decode needs a terminated string
+    if (p->len >= MINA_ADDRESS_LEN || memchr(p->line, '\0', p->len)) {
+        return false;
+    }
+    memcpy(address, p->line, p->len);
+    address[p->len] = '\0';
+    return raw_address_decode(&p->raw, address);
+}
+
+static bool encode_line(pending_t *p)
+{
+    Affine pub;
+    Compressed c;
+
+    if (p->len != 4*FIELD_BYTES
+            || !parse_field(pub.x, p->line)
+            || !parse_field(pub.y, p->line + 2*FIELD_BYTES)
+            || !affine_is_on_curve(&pub)) {
+        return false;
+    }
+    compress(&c, &pub);
+    raw_address_from_key(&p->raw, &c);
+    return true;
+}
+
+static bool derive_line(pending_t *p)
+{
+    uint32_t account = 0;
+    size_t i;
+
+    for (i = 0; i < p->len && p->line[i] >= '0' && p->line[i] <= '9'; i++) {
+        uint32_t digit = p->line[i] - '0';
+        if (account > (0x7fffffff - digit) / 10) {
+            // Hardened index bit, checked before account can wrap
+            return false;
+        }
+        account = account * 10 + digit;
+    }
+    if (i != p->len || p->len == 0) {
+        return false;
+    }
+
+    volatile bool ok = false;
+    BEGIN_TRY {
+        TRY {
+            Keypair kp;
+            Compressed c;
+            generate_keypair(&kp, account);
+            explicit_bzero(kp.priv, sizeof(kp.priv));
+            compress(&c, &kp.pub);
+            raw_address_from_key(&p->raw, &c);
+            ok = true;
+        }
+        CATCH_OTHER(e) {
+            ok = false;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    return ok;
+}
+
+// Checksums the pending lines and formats their results
+static bool flush(job_t *job)
+{
+    uint8_t digest[CX_SHA256_LANES][CX_SHA256_SIZE];
+    unsigned char *out[CX_SHA256_LANES];
+    const unsigned char *in[CX_SHA256_LANES];
+    size_t count = 0;
+
+    for (size_t i = 0; i < job->pending_len; i++) {
+        if (job->pending[i].ok) {
+            in[count] = (const unsigned char *)&job->pending[i].raw;
+            out[count++] = digest[i];
+        }
+    }
+    cx_sha256d_multi(out, in, RAW_ADDRESS_CHECKED_LEN, count);
+
+    for (size_t i = 0; i < job->pending_len; i++) {
+        pending_t *p = &job->pending[i];
+        char address[MINA_ADDRESS_LEN];
+        bool ok;
+
+        if (p->ok && job->mode == MODE_VALIDATE) {
+            p->ok = memcmp(p->raw.checksum, digest[i], sizeof(p->raw.checksum)) == 0;
+        }
+        else if (p->ok) {
+            memcpy(p->raw.checksum, digest[i], sizeof(p->raw.checksum));
+            p->ok = raw_address_encode(address, sizeof(address), &p->raw);
+        }
+
+        if (!p->ok) {
+            job->invalid++;
+            ok = out_result(job, "invalid\t", p->line, p->len);
+        }
+        else if (job->mode == MODE_VALIDATE) {
+            job->valid++;
+            ok = out_result(job, "valid\t", p->line, p->len);
+        }
+        else if (job->mode == MODE_ENCODE) {
+            job->valid++;
+            ok = out_result(job, "", address, MINA_ADDRESS_LEN - 1);
+        }
+        else {
+            job->valid++;
+            ok = out_append(&job->out, p->line, p->len)
+                && out_result(job, "\t", address, MINA_ADDRESS_LEN - 1);
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+
+    job->pending_len = 0;
+    return true;
+}
+
+static void *worker(void *arg)
+{
+    job_t *job = arg;
+    const char *p = job->begin;
+
+    while (p < job->end) {
+        const char *nl = memchr(p, '\n', job->end - p);
+        const char *eol = nl ? nl : job->end;
+        size_t len = eol - p;
+        if (len > 0 && p[len - 1] == '\r') {
+            len--;
+        }
+
+        if (len > 0) {
+            pending_t *pending = &job->pending[job->pending_len++];
+            pending->line = p;
+            pending->len = len;
+            switch (job->mode) {
+                case MODE_VALIDATE:
+                    pending->ok = validate_line(pending);
+                    break;
+                case MODE_ENCODE:
+                    pending->ok = encode_line(pending);
+                    break;
+                default:
+                    pending->ok = derive_line(pending);
+                    break;
+            }
+            if (job->pending_len == CX_SHA256_LANES && !flush(job)) {
+                job->failed = true;
+                return NULL;
+            }
+        }
+        p = eol + 1;
+    }
+
+    if (!flush(job)) {
+        job->failed = true;
+    }
+    return NULL;
+}
+
+static bool write_all(int fd, const char *data, size_t len)
+{
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+// Reads a non-mappable input (pipe, terminal) into memory
+static char *read_stream(int fd, size_t *len)
+{
+    size_t cap = 1 << 20;
+    char *data = malloc(cap);
+    *len = 0;
+
+    while (data) {
+        if (*len == cap) {
+            char *grown = realloc(data, cap * 2);
+            if (!grown) {
+                free(data);
+                return NULL;
+            }
+            data = grown;
+            cap *= 2;
+        }
+        ssize_t n = read(fd, data + *len, cap - *len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            free(data);
+            return NULL;
+        }
+        if (n == 0) {
+            break;
+        }
+        *len += n;
+    }
+
+    return data;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "Usage: %s [-j threads] validate|encode|derive [file]\n", argv0);
+}
+
+int main(int argc, char *argv[])
+{
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:h")) != -1) {
+        switch (opt) {
+            case 'j':
+                threads = strtol(optarg, NULL, 10);
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (optind >= argc || argc - optind > 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    address_mode_t mode;
+    if (strcmp(argv[optind], "validate") == 0) {
+        mode = MODE_VALIDATE;
+    }
+    else if (strcmp(argv[optind], "encode") == 0) {
+        mode = MODE_ENCODE;
+    }
+    else if (strcmp(argv[optind], "derive") == 0) {
+        if (!getenv("MINA_MNEMONIC")) {
+            fprintf(stderr, "derive needs MINA_MNEMONIC\n");
+            return 2;
+        }
+        mode = MODE_DERIVE;
+    }
+    else {
+        usage(argv[0]);
+        return 2;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    if (threads > MAX_THREADS) {
+        threads = MAX_THREADS;
+    }
+
+    // Jobs hold the batching state of each worker, too large for the stack
+    job_t *jobs = calloc(threads, sizeof(*jobs));
+    if (!jobs) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    int fd = STDIN_FILENO;
+    if (argc - optind == 2 && strcmp(argv[optind + 1], "-") != 0) {
+        fd = open(argv[optind + 1], O_RDONLY);
+        if (fd < 0) {
+            perror(argv[optind + 1]);
+            return 1;
+        }
+    }
+
+    char *input = NULL;
+    size_t input_len = 0;
+    bool mapped = false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        input_len = st.st_size;
+        if (input_len > 0) {
+            input = mmap(NULL, input_len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (input == MAP_FAILED) {
+                perror("mmap");
+                return 1;
+            }
+            madvise(input, input_len, MADV_SEQUENTIAL);
+            mapped = true;
+        }
+    }
+    else {
+        input = read_stream(fd, &input_len);
+        if (!input) {
+            perror("read");
+            return 1;
+        }
+    }
+
+    // Split the input at line boundaries
+    pthread_t tids[MAX_THREADS];
+    bool started[MAX_THREADS];
+    const char *begin = input;
+    const char *end = input + input_len;
+    size_t count = 0;
+    for (long i = 0; i < threads && begin < end; i++) {
+        const char *split = (i == threads - 1) ? end : begin + (end - begin) / (threads - i);
+        if (split < end) {
+            const char *nl = memchr(split, '\n', end - split);
+            split = nl ? nl + 1 : end;
+        }
+        jobs[count] = (job_t){ .mode = mode, .begin = begin, .end = split };
+        begin = split;
+        count++;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        started[i] = pthread_create(&tids[i], NULL, worker, &jobs[i]) == 0;
+        if (!started[i]) {
+            // Fall back to running the job on this thread
+            worker(&jobs[i]);
+        }
+    }
+
+    int rc = 0;
+    size_t valid = 0, invalid = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (started[i]) {
+            pthread_join(tids[i], NULL);
+        }
+        if (jobs[i].failed) {
+            fprintf(stderr, "Out of memory\n");
+            rc = 1;
+        }
+        else if (rc == 0 && !write_all(STDOUT_FILENO, jobs[i].out.data, jobs[i].out.len)) {
+            perror("write");
+            rc = 1;
+        }
+        valid += jobs[i].valid;
+        invalid += jobs[i].invalid;
+        free(jobs[i].out.data);
+    }
+    free(jobs);
+
+    if (mapped) {
+        munmap(input, input_len);
+    }
+    else {
+        free(input);
+    }
+    if (fd != STDIN_FILENO) {
+        close(fd);
+    }
+
+    fprintf(stderr, "%zu valid, %zu invalid\n", valid, invalid);
+
+    return rc;
+}
@@ -0,0 +1,953 @@
+// APDU client for the Speculos APDU-over-TCP proxy
+//
+//     Sends the app's commands (see src/main.c and doc/api.asc) to the
+//     emulator at LEDGER_PROXY_ADDRESS:LEDGER_PROXY_PORT, either one at a
+//     time or as a batch.  In batch mode a sender thread builds and writes
+//     the next APDUs while the main thread parses responses, and the
+//     latency of every APDU is reported.
+//
+//     Framing: request  length (4, big-endian) | APDU
+//              response length (4, big-endian) | data | SW (2)
+//
+//     Usage: mina_apdu [-H host] [-p port] <command> [args...]
+//            mina_apdu [-H host] [-p port] batch [-w window] [-n repeat] [file]
+//            mina_apdu [-H host] [-p port] bench [-n iterations] [-r runs]
+//            mina_apdu [-H host] [-p port] op-counts
+//
+//     Commands:
+//         get-conf
+//         get-addr <account>
+//         sign-tx <account> <from> <to> <amount> <fee> <nonce> <valid_until>
+//                 <memo> <payment|delegation> <testnet|mainnet>
+//         sign-msg <account> <testnet|mainnet> <message>
+//         test-crypto
+//         stack-profile [reset]
+//         stats [reset]
+//         raw <hex>
+//
+//     Amounts and fees are in nanomina.  Batch files hold one command per
+//     line; arguments containing spaces may be double quoted.
+//
+//     bench runs the crypto benchmarks of an app built with BENCHMARKS=1
+//     (INS_BENCHMARK) and prints the same JSON lines as crypto_bench.  The
+//     emulator exposes no cycle or instruction counts, so the time per
+//     operation is the difference between APDUs running the case for
+//     zero and for n iterations, which cancels the transport overhead.
+//
+//     op-counts prints the operation counts of every benchmark case of an
+//     app built with OP_COUNTERS=1 (INS_OP_COUNTS), in the same JSON lines
+//     as crypto_ops.
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hex.h"
+#include "op_counters.h"
+
+#define CLA               0xe0
+#define INS_GET_CONF      0x01
+#define INS_GET_ADDR      0x02
+#define INS_SIGN_TX       0x03
+#define INS_TEST_CRYPTO   0x04
+#define INS_SIGN_MSG      0x05
+#define INS_BENCHMARK     0x06
+#define INS_STACK_PROFILE 0x07
+#define INS_GET_STATS     0x08
+#define INS_OP_COUNTS     0x09
+
+#define P1_FIRST 0x00
+#define P1_MORE  0x80
+
+#define APDU_HEADER_LEN   5
+#define APDU_MAX_DATA_LEN 255
+#define ADDRESS_LEN       55
+#define MEMO_LEN          32
+#define MESSAGE_MAX_LEN   4096
+#define SIGN_TX_LEN       172
+#define BENCH_NAME_LEN    24
+
+// A sign-msg command is the largest: two passes over the message
+#define MAX_APDUS_PER_COMMAND (2 * (MESSAGE_MAX_LEN + 9 + APDU_MAX_DATA_LEN - 1) / APDU_MAX_DATA_LEN)
+#define MAX_ARGS 16
+
+#define ARRAY_LEN(array) (sizeof(array) / sizeof(array[0]))
+
+typedef struct {
+    uint8_t buf[APDU_HEADER_LEN + APDU_MAX_DATA_LEN];
+    size_t  len;
+} apdu_t;
+
+typedef struct {
+    uint8_t  data[1024];
+    size_t   len;
+    uint16_t sw;
+} response_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Names of INS 0x00-0x09 for the diagnostics reports, 0x00 stands for other INS
+static const char *INS_NAMES[] = { "other", "get-conf", "get-addr", "sign-tx", "test-crypto",
+                                   "sign-msg", "bench", "stack-profile", "stats", "op-counts" };
+
+#define OP_COUNTER_NAME(id, name) name,
+
+static const char *OP_NAMES[] = { OP_COUNTERS(OP_COUNTER_NAME) };
+
+static uint32_t read_be32(const uint8_t *in)
+{
+    return (uint32_t)in[0] << 24 | in[1] << 16 | in[2] << 8 | in[3];
+}
+
+static void write_be(uint8_t *out, const uint64_t value, const size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        out[len - 1 - i] = value >> (8 * i);
+    }
+}
+
+static void apdu_init(apdu_t *apdu, uint8_t ins, uint8_t p1, uint8_t p2,
+                      const uint8_t *data, size_t len)
+{
+    apdu->buf[0] = CLA;
+    apdu->buf[1] = ins;
+    apdu->buf[2] = p1;
+    apdu->buf[3] = p2;
+    apdu->buf[4] = len;
+    memcpy(apdu->buf + APDU_HEADER_LEN, data, len);
+    apdu->len = APDU_HEADER_LEN + len;
+}
+
+static bool parse_uint(uint64_t *out, const char *s, uint64_t max)
+{
+    char *end;
+
+    if (*s == '\0' || *s == '-') {
+        return false;
+    }
+    errno = 0;
+    unsigned long long value = strtoull(s, &end, 10);
+    if (errno || *end != '\0' || value > max) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+static bool parse_network(uint8_t *out, const char *s)
+{
+    if (strcmp(s, "testnet") == 0) {
+        *out = 0x00;
+        return true;
+    }
+    if (strcmp(s, "mainnet") == 0) {
+        *out = 0x01;
+        return true;
+    }
+    return false;
+}
+
+// Builds the APDUs of a command, returns the number of APDUs or -1
+static int build_command(apdu_t *apdus, int argc, char *argv[])
+{
+    uint8_t data[MESSAGE_MAX_LEN + 9];
+    uint64_t account, amount, fee, nonce, valid_until;
+    uint8_t network_id;
+
+    if (argc < 1) {
+        return -1;
+    }
+    const char *cmd = argv[0];
+
+    if (strcmp(cmd, "get-conf") == 0 && argc == 1) {
+        apdu_init(&apdus[0], INS_GET_CONF, 0, 0, NULL, 0);
+        return 1;
+    }
+
+    if (strcmp(cmd, "test-crypto") == 0 && argc == 1) {
+        apdu_init(&apdus[0], INS_TEST_CRYPTO, 0, 0, NULL, 0);
+        return 1;
+    }
+
+    // Apps built with STACK_PROFILING=1
+    if (strcmp(cmd, "stack-profile") == 0
+            && (argc == 1 || (argc == 2 && strcmp(argv[1], "reset") == 0))) {
+        apdu_init(&apdus[0], INS_STACK_PROFILE, argc == 2, 0, NULL, 0);
+        return 1;
+    }
+
+    if (strcmp(cmd, "stats") == 0
+            && (argc == 1 || (argc == 2 && strcmp(argv[1], "reset") == 0))) {
+        apdu_init(&apdus[0], INS_GET_STATS, argc == 2, 0, NULL, 0);
+        return 1;
+    }
+
+    if (strcmp(cmd, "get-addr") == 0 && argc == 2) {
+        if (!parse_uint(&account, argv[1], UINT32_MAX)) {
+            return -1;
+        }
+        write_be(data, account, 4);
+        apdu_init(&apdus[0], INS_GET_ADDR, 0, 0, data, 4);
+        return 1;
+    }
+
+    if (strcmp(cmd, "sign-tx") == 0 && argc == 11) {
+        uint8_t tag;
+        if (!parse_uint(&account, argv[1], UINT32_MAX)
+                || strlen(argv[2]) != ADDRESS_LEN
+                || strlen(argv[3]) != ADDRESS_LEN
+                || !parse_uint(&amount, argv[4], UINT64_MAX)
+                || !parse_uint(&fee, argv[5], UINT64_MAX)
+                || !parse_uint(&nonce, argv[6], UINT32_MAX)
+                || !parse_uint(&valid_until, argv[7], UINT32_MAX)
+                || strlen(argv[8]) > MEMO_LEN
+                || !parse_network(&network_id, argv[10])) {
+            return -1;
+        }
+        if (strcmp(argv[9], "payment") == 0) {
+            tag = 0x00;
+        }
+        else if (strcmp(argv[9], "delegation") == 0) {
+            tag = 0x04;
+        }
+        else {
+            return -1;
+        }
+
+        memset(data, 0, SIGN_TX_LEN);
+        write_be(data, account, 4);
+        memcpy(data + 4, argv[2], ADDRESS_LEN);
+        memcpy(data + 59, argv[3], ADDRESS_LEN);
+        write_be(data + 114, amount, 8);
+        write_be(data + 122, fee, 8);
+        write_be(data + 130, nonce, 4);
+        write_be(data + 134, valid_until, 4);
+        memcpy(data + 138, argv[8], strlen(argv[8]));
+        data[170] = tag;
+        data[171] = network_id;
+        apdu_init(&apdus[0], INS_SIGN_TX, 0, 0, data, SIGN_TX_LEN);
+        return 1;
+    }
+
+    if (strcmp(cmd, "sign-msg") == 0 && argc == 4) {
+        size_t msg_len = strlen(argv[3]);
+        if (!parse_uint(&account, argv[1], UINT32_MAX)
+                || !parse_network(&network_id, argv[2])
+                || msg_len > MESSAGE_MAX_LEN) {
+            return -1;
+        }
+
+        // The message is sent twice (see src/sign_msg.c): the first pass
+        // is prefixed with account | network_id | length
+        int n = 0;
+        write_be(data, account, 4);
+        data[4] = network_id;
+        write_be(data + 5, msg_len, 4);
+        memcpy(data + 9, argv[3], msg_len);
+        for (uint8_t p2 = 0; p2 <= 1; p2++) {
+            const uint8_t *p = p2 == 0 ? data : data + 9;
+            size_t left = p2 == 0 ? msg_len + 9 : msg_len;
+            uint8_t p1 = P1_FIRST;
+            do {
+                size_t chunk = left < APDU_MAX_DATA_LEN ? left : APDU_MAX_DATA_LEN;
+                apdu_init(&apdus[n++], INS_SIGN_MSG, p1, p2, p, chunk);
+                p += chunk;
+                left -= chunk;
+                p1 = P1_MORE;
+            } while (left > 0);
+        }
+        return n;
+    }
+
+    if (strcmp(cmd, "raw") == 0 && argc == 2) {
+        size_t len = strlen(argv[1]);
+        if (len % 2 || len / 2 < APDU_HEADER_LEN || len / 2 > sizeof(apdus[0].buf)) {
+            return -1;
+        }
+        for (size_t i = 0; i < len / 2; i++) {
+            int hi = hex_nibble(argv[1][2*i]), lo = hex_nibble(argv[1][2*i + 1]);
+            if (hi < 0 || lo < 0) {
+                return -1;
+            }
+            apdus[0].buf[i] = hi << 4 | lo;
+        }
+        apdus[0].len = len / 2;
+        return 1;
+    }
+
+    return -1;
+}
+
+static bool write_full(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool read_full(int fd, void *buf, size_t len)
+{
+    uint8_t *p = buf;
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool apdu_send(int fd, const apdu_t *apdu)
+{
+    uint8_t frame[4 + sizeof(apdu->buf)];
+
+    write_be(frame, apdu->len, 4);
+    memcpy(frame + 4, apdu->buf, apdu->len);
+    return write_full(fd, frame, 4 + apdu->len);
+}
+
+static bool apdu_recv(int fd, response_t *resp)
+{
+    uint8_t header[4], sw[2];
+
+    if (!read_full(fd, header, sizeof(header))) {
+        return false;
+    }
+    resp->len = (size_t)header[0] << 24 | header[1] << 16 | header[2] << 8 | header[3];
+    if (resp->len > sizeof(resp->data)) {
+        return false;
+    }
+    if (!read_full(fd, resp->data, resp->len) || !read_full(fd, sw, sizeof(sw))) {
+        return false;
+    }
+    resp->sw = sw[0] << 8 | sw[1];
+    return true;
+}
+
+static int proxy_connect(const char *host, const char *port)
+{
+    struct addrinfo hints = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM };
+    struct addrinfo *res, *ai;
+    int fd = -1;
+
+    int rc = getaddrinfo(host, port, &hints, &res);
+    if (rc != 0) {
+        fprintf(stderr, "%s:%s: %s\n", host, port, gai_strerror(rc));
+        return -1;
+    }
+    for (ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    if (fd < 0) {
+        fprintf(stderr, "%s:%s: %s\n", host, port, strerror(errno));
+        return -1;
+    }
+
+    // APDUs are small, send them immediately
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    return fd;
+}
+
+static void print_hex(FILE *f, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        fprintf(f, "%02x", data[i]);
+    }
+}
+
+// Prints the final response of a command
+static void print_response(const char *cmd, const response_t *resp)
+{
+    if (resp->sw != 0x9000) {
+        printf("Error: status word %04x\n", resp->sw);
+        return;
+    }
+
+    if (strcmp(cmd, "get-conf") == 0 && resp->len >= 3) {
+        printf("%u.%u.%u\n", resp->data[0], resp->data[1], resp->data[2]);
+    }
+    else if (strcmp(cmd, "get-addr") == 0) {
+        printf("%.*s\n", (int)strnlen((const char *)resp->data, resp->len), resp->data);
+    }
+    else if (strcmp(cmd, "stack-profile") == 0 && resp->len >= 2) {
+        // Stack size, then the high-water mark per INS (other INS in 0x00)
+        unsigned size = resp->data[0] << 8 | resp->data[1];
+        printf("stack size %u bytes\n", size);
+        for (size_t i = 0; 2 + 2*i + 1 < resp->len && i < ARRAY_LEN(INS_NAMES); i++) {
+            unsigned used = resp->data[2 + 2*i] << 8 | resp->data[2 + 2*i + 1];
+            printf("%02zx %-14s %5u bytes (%u%%)\n", i, INS_NAMES[i], used,
+                   size ? 100 * used / size : 0);
+        }
+    }
+    else if (strcmp(cmd, "stats") == 0 && resp->len >= 4) {
+        // Ticks are SEPROXYHAL ticker events (100 ms)
+        static const char *ops[] = { "scalar_mul", "poseidon_permutation",
+                                     "b58_encode", "b58_decode" };
+        const uint8_t *p = resp->data;
+        size_t left = resp->len;
+
+        printf("uptime %.1f s\n", read_be32(p) / 10.0);
+        p += 4;
+        left -= 4;
+        printf("   %-14s %8s %10s %8s\n", "INS", "calls", "total s", "max s");
+        for (size_t i = 0; i < ARRAY_LEN(INS_NAMES) && left >= 12; i++) {
+            printf("%02zx %-14s %8u %10.1f %8.1f\n", i, INS_NAMES[i],
+                   read_be32(p), read_be32(p + 4) / 10.0, read_be32(p + 8) / 10.0);
+            p += 12;
+            left -= 12;
+        }
+        for (size_t i = 0; i < ARRAY_LEN(ops) && left >= 4; i++) {
+            printf("%-20s %u\n", ops[i], read_be32(p));
+            p += 4;
+            left -= 4;
+        }
+    }
+    else {
+        print_hex(stdout, resp->data, resp->len);
+        printf("\n");
+    }
+}
+
+// Splits a line into whitespace separated, optionally double quoted, arguments
+static int tokenize(char *line, char *argv[], int max)
+{
+    int argc = 0;
+    char *p = line;
+
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            p++;
+        }
+        if (*p == '\0' || *p == '#') {
+            break;
+        }
+        if (argc == max) {
+            return -1;
+        }
+        if (*p == '"') {
+            argv[argc++] = ++p;
+            while (*p && *p != '"') {
+                p++;
+            }
+            if (*p != '"') {
+                return -1;
+            }
+        }
+        else {
+            argv[argc++] = p;
+            while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+                p++;
+            }
+        }
+        if (*p) {
+            *p++ = '\0';
+        }
+    }
+
+    return argc;
+}
+
+// Batch mode
+
+typedef struct {
+    size_t   line;
+    uint64_t sent_ns;
+} inflight_t;
+
+typedef struct {
+    int             fd;
+    FILE           *in;
+    unsigned long   repeat;
+    sem_t           window;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    inflight_t     *queue;  // ring of in-flight APDUs, window entries
+    size_t          queue_size;
+    size_t          head;
+    size_t          tail;
+    bool            done;   // sender finished
+    atomic_bool     failed;
+} batch_t;
+
+static void *batch_sender(void *arg)
+{
+    batch_t *b = arg;
+    apdu_t *apdus = malloc(MAX_APDUS_PER_COMMAND * sizeof(*apdus));
+    char **lines = NULL;
+    size_t nlines = 0, cap = 0;
+    char *line = NULL;
+    size_t line_cap = 0;
+
+    // Lines are kept so that the batch can be repeated
+    while (apdus && getline(&line, &line_cap, b->in) != -1) {
+        if (nlines == cap) {
+            cap = cap ? 2*cap : 64;
+            char **grown = realloc(lines, cap * sizeof(*lines));
+            if (!grown) {
+                break;
+            }
+            lines = grown;
+        }
+        lines[nlines++] = strdup(line);
+    }
+    free(line);
+
+    for (unsigned long r = 0; apdus && r < b->repeat && !b->failed; r++) {
+        for (size_t i = 0; i < nlines && !b->failed; i++) {
+            char *copy = strdup(lines[i]);
+            char *argv[MAX_ARGS];
+            int argc = tokenize(copy, argv, MAX_ARGS);
+            int n = argc > 0 ? build_command(apdus, argc, argv) : argc;
+            free(copy);
+            if (n == 0) {
+                continue;
+            }
+            if (n < 0) {
+                fprintf(stderr, "line %zu: invalid command\n", i + 1);
+                b->failed = true;
+                break;
+            }
+
+            for (int j = 0; j < n; j++) {
+                sem_wait(&b->window);
+
+                pthread_mutex_lock(&b->lock);
+                b->queue[b->tail++ % b->queue_size] = (inflight_t){ i + 1, now_ns() };
+                pthread_cond_signal(&b->cond);
+                pthread_mutex_unlock(&b->lock);
+
+                if (!apdu_send(b->fd, &apdus[j])) {
+                    perror("send");
+                    b->failed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    pthread_mutex_lock(&b->lock);
+    b->done = true;
+    pthread_cond_signal(&b->cond);
+    pthread_mutex_unlock(&b->lock);
+
+    for (size_t i = 0; i < nlines; i++) {
+        free(lines[i]);
+    }
+    free(lines);
+    free(apdus);
+
+    return NULL;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static int run_batch(int fd, int argc, char *argv[])
+{
+    unsigned long window = 1, repeat = 1;
+    int opt;
+
+    optind = 1;
+    while ((opt = getopt(argc, argv, "w:n:")) != -1) {
+        switch (opt) {
+            case 'w':
+                window = strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                repeat = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                return 2;
+        }
+    }
+    if (window < 1 || argc - optind > 1) {
+        return 2;
+    }
+
+    batch_t b = { .fd = fd, .in = stdin, .repeat = repeat, .queue_size = window };
+    if (argc - optind == 1 && strcmp(argv[optind], "-") != 0) {
+        b.in = fopen(argv[optind], "r");
+        if (!b.in) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+    b.queue = calloc(window, sizeof(*b.queue));
+    sem_init(&b.window, 0, window);
+    pthread_mutex_init(&b.lock, NULL);
+    pthread_cond_init(&b.cond, NULL);
+
+    pthread_t sender;
+    if (!b.queue || pthread_create(&sender, NULL, batch_sender, &b) != 0) {
+        fprintf(stderr, "Failed to start sender\n");
+        return 1;
+    }
+
+    uint64_t *latencies = NULL;
+    size_t count = 0, cap = 0, errors = 0;
+    uint64_t start = now_ns();
+    for (;;) {
+        pthread_mutex_lock(&b.lock);
+        while (b.head == b.tail && !b.done) {
+            pthread_cond_wait(&b.cond, &b.lock);
+        }
+        if (b.head == b.tail) {
+            pthread_mutex_unlock(&b.lock);
+            break;
+        }
+        inflight_t req = b.queue[b.head % b.queue_size];
+        pthread_mutex_unlock(&b.lock);
+
+        response_t resp;
+        if (!apdu_recv(fd, &resp)) {
+            fprintf(stderr, "Connection closed\n");
+            b.failed = true;
+            sem_post(&b.window);
+            break;
+        }
+        uint64_t latency = now_ns() - req.sent_ns;
+
+        pthread_mutex_lock(&b.lock);
+        b.head++;
+        pthread_mutex_unlock(&b.lock);
+        sem_post(&b.window);
+
+        if (count == cap) {
+            cap = cap ? 2*cap : 1024;
+            uint64_t *grown = realloc(latencies, cap * sizeof(*latencies));
+            if (!grown) {
+                b.failed = true;
+                break;
+            }
+            latencies = grown;
+        }
+        latencies[count++] = latency;
+        if (resp.sw != 0x9000) {
+            errors++;
+        }
+
+        printf("%zu\t%04x\t%.1f\t", req.line, resp.sw, latency / 1e3);
+        print_hex(stdout, resp.data, resp.len);
+        printf("\n");
+    }
+    double elapsed = (now_ns() - start) / 1e9;
+
+    // Unblock the sender if the receiver stopped early
+    for (unsigned long i = 0; i < window; i++) {
+        sem_post(&b.window);
+    }
+    pthread_join(sender, NULL);
+
+    fflush(stdout);
+    if (count > 0) {
+        qsort(latencies, count, sizeof(*latencies), cmp_u64);
+        uint64_t total = 0;
+        for (size_t i = 0; i < count; i++) {
+            total += latencies[i];
+        }
+        fprintf(stderr, "%zu APDUs (%zu errors) in %.3f s, %.1f APDU/s\n",
+                count, errors, elapsed, count / elapsed);
+        fprintf(stderr, "latency us: min %.1f avg %.1f p50 %.1f p90 %.1f p99 %.1f max %.1f\n",
+                latencies[0] / 1e3, total / 1e3 / count,
+                latencies[count / 2] / 1e3, latencies[count * 90 / 100] / 1e3,
+                latencies[count * 99 / 100] / 1e3, latencies[count - 1] / 1e3);
+    }
+
+    free(latencies);
+    free(b.queue);
+    if (b.in != stdin) {
+        fclose(b.in);
+    }
+
+    return b.failed ? 1 : (errors ? 3 : 0);
+}
+
+// Best time in ns of runs INS_BENCHMARK APDUs, or 0 on error
+static uint64_t bench_time(int fd, uint8_t id, uint32_t iterations, unsigned runs,
+                           response_t *resp)
+{
+    apdu_t apdu;
+    uint8_t data[4];
+    uint64_t best = UINT64_MAX;
+
+    write_be(data, iterations, sizeof(data));
+    apdu_init(&apdu, INS_BENCHMARK, id, 0, data, sizeof(data));
+    for (unsigned r = 0; r < runs; r++) {
+        uint64_t start = now_ns();
+        if (!apdu_send(fd, &apdu) || !apdu_recv(fd, resp)) {
+            fprintf(stderr, "Connection closed\n");
+            return 0;
+        }
+        uint64_t elapsed = now_ns() - start;
+        if (resp->sw != 0x9000) {
+            return 0;
+        }
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+static int run_bench(int fd, int argc, char *argv[])
+{
+    unsigned long iterations = 10, runs = 3;
+    int opt;
+
+    optind = 1;
+    while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+        switch (opt) {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+            case 'r':
+                runs = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                return 2;
+        }
+    }
+    if (iterations < 1 || iterations > UINT32_MAX || runs < 1 || argc != optind) {
+        return 2;
+    }
+
+    // Cases are numbered from 0 until the app rejects the id
+    for (unsigned id = 0; id < 256; id++) {
+        response_t resp;
+        uint64_t base = bench_time(fd, id, 0, runs, &resp);
+        if (base == 0) {
+            if (id == 0) {
+                fprintf(stderr, "Benchmarks not available (status word %04x), "
+                                "build the app with BENCHMARKS=1\n", resp.sw);
+                return 3;
+            }
+            break;
+        }
+        uint64_t total = bench_time(fd, id, iterations, runs, &resp);
+        if (total == 0 || resp.len < 5) {
+            fprintf(stderr, "Benchmark %u failed (status word %04x)\n", id, resp.sw);
+            return 3;
+        }
+
+        double ns = total > base ? (double)(total - base) / iterations : 0;
+        printf("{\"platform\": \"speculos\", \"name\": \"%.*s\", \"iterations\": %lu, "
+               "\"runs\": %lu, \"ns_per_op\": %.1f, \"cycles_per_op\": null, "
+               "\"instructions_per_op\": null, \"checksum\": \"%02x%02x%02x%02x\"}\n",
+               (int)strnlen((const char *)resp.data + 4, resp.len - 4), resp.data + 4,
+               iterations, runs, ns, resp.data[0], resp.data[1], resp.data[2], resp.data[3]);
+        fflush(stdout);
+    }
+
+    return 0;
+}
+
+static int run_op_counts(int fd, int argc, char *argv[])
+{
+    (void)argv;
+    if (argc != 1) {
+        return 2;
+    }
+
+    // Cases are numbered from 0 until the app rejects the id
+    for (unsigned id = 0; id < 256; id++) {
+        apdu_t apdu;
+        response_t resp;
+
+        apdu_init(&apdu, INS_OP_COUNTS, id, 0, NULL, 0);
+        if (!apdu_send(fd, &apdu) || !apdu_recv(fd, &resp)) {
+            fprintf(stderr, "Connection closed\n");
+            return 1;
+        }
+        if (resp.sw != 0x9000) {
+            if (id == 0) {
+                fprintf(stderr, "Operation counts not available (status word %04x), "
+                                "build the app with OP_COUNTERS=1\n", resp.sw);
+                return 3;
+            }
+            break;
+        }
+        if (resp.len < BENCH_NAME_LEN + 4 * ARRAY_LEN(OP_NAMES)) {
+            fprintf(stderr, "Operation counts %u: short response\n", id);
+            return 3;
+        }
+
+        printf("{\"platform\": \"speculos\", \"name\": \"%.*s\", \"ops\": {",
+               (int)strnlen((const char *)resp.data, BENCH_NAME_LEN), resp.data);
+        const char *sep = "";
+        for (size_t op = 0; op < ARRAY_LEN(OP_NAMES); op++) {
+            uint32_t count = read_be32(resp.data + BENCH_NAME_LEN + 4 * op);
+            if (count) {
+                printf("%s\"%s\": %u", sep, OP_NAMES[op], count);
+                sep = ", ";
+            }
+        }
+        printf("}}\n");
+        fflush(stdout);
+    }
+
+    return 0;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "Usage: %s [-H host] [-p port] <command> [args...]\n"
+            "       %s [-H host] [-p port] batch [-w window] [-n repeat] [file]\n"
+            "       %s [-H host] [-p port] bench [-n iterations] [-r runs]\n"
+            "       %s [-H host] [-p port] op-counts\n"
+            "\n"
+            "Commands:\n"
+            "    get-conf\n"
+            "    get-addr <account>\n"
+            "    sign-tx <account> <from> <to> <amount> <fee> <nonce> <valid_until>\n"
+            "            <memo> <payment|delegation> <testnet|mainnet>\n"
+            "    sign-msg <account> <testnet|mainnet> <message>\n"
+            "    test-crypto\n"
+            "    stack-profile [reset]\n"
+            "    stats [reset]\n"
+            "    raw <hex>\n",
+            argv0, argv0, argv0, argv0);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *host = getenv("LEDGER_PROXY_ADDRESS");
+    const char *port = getenv("LEDGER_PROXY_PORT");
+    const char *argv0 = argv[0];
+    int opt;
+
+    if (!host) {
+        host = "127.0.0.1";
+    }
+    if (!port) {
+        port = "9999";
+    }
+
+    // Stop at the command so that batch can parse its own options
+    while ((opt = getopt(argc, argv, "+H:p:h")) != -1) {
+        switch (opt) {
+            case 'H':
+                host = optarg;
+                break;
+            case 'p':
+                port = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 2;
+    }
+    argc -= optind;
+    argv += optind;
+
+    apdu_t *apdus = malloc(MAX_APDUS_PER_COMMAND * sizeof(*apdus));
+    int n = 0;
+    if (!apdus) {
+        return 1;
+    }
+    bool session = strcmp(argv[0], "batch") == 0 || strcmp(argv[0], "bench") == 0
+                   || strcmp(argv[0], "op-counts") == 0;
+    if (!session) {
+        n = build_command(apdus, argc, argv);
+        if (n < 0) {
+            usage(argv0);
+            free(apdus);
+            return 2;
+        }
+    }
+
+    int fd = proxy_connect(host, port);
+    if (fd < 0) {
+        free(apdus);
+        return 1;
+    }
+
+    int rc = 0;
+    if (strcmp(argv[0], "batch") == 0) {
+        rc = run_batch(fd, argc, argv);
+        if (rc == 2) {
+            usage(argv0);
+        }
+    }
+    else if (strcmp(argv[0], "bench") == 0) {
+        rc = run_bench(fd, argc, argv);
+        if (rc == 2) {
+            usage(argv0);
+        }
+    }
+    else if (strcmp(argv[0], "op-counts") == 0) {
+        rc = run_op_counts(fd, argc, argv);
+        if (rc == 2) {
+            usage(argv0);
+        }
+    }
+    else {
+        response_t resp = { .sw = 0x9000 };
+        for (int i = 0; i < n && resp.sw == 0x9000; i++) {
+            if (!apdu_send(fd, &apdus[i]) || !apdu_recv(fd, &resp)) {
+                fprintf(stderr, "Connection closed\n");
+                rc = 1;
+                break;
+            }
+        }
+        if (rc == 0) {
+            print_response(argv[0], &resp);
+            rc = resp.sw == 0x9000 ? 0 : 3;
+        }
+    }
+
+    close(fd);
+    free(apdus);
+
+    return rc;
+}
@@ -0,0 +1,537 @@
+// Batch signing service
+//
+//     Signs batches of payments and delegations received over a Unix
+//     socket, using keys loaded from a key file, on a work-stealing
+//     thread pool (signd_pool.c).  Signatures are returned in submission
+//     order.
+//
+//     Usage: mina_signd -k keyfile -s socket [-j threads]
+//
+//     Key file: one "<account> <secret hex>" per line, '#' starts a comment.
+//
+//     Protocol (integers are big-endian):
+//
+//         Sign batch   'S' | count (4) | count * transaction (172)
+//                  ->  count (4) | count * (status (1) | rx (32) | s (32))
+//
+//         Statistics   'T'
+//                  ->  length (4) | JSON counters
+//
+//     The transaction layout is the INS_SIGN_TX layout (see doc/api.asc)
+//     and its account field selects the signing key.  The status is a
+//     minasigner_status_t; the from address must belong to the account.
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hex.h"
+#include "minasigner.h"
+#include "signd_pool.h"
+
+#define OP_SIGN  'S'
+#define OP_STATS 'T'
+
+#define TX_LEN      172
+#define RESULT_LEN  (1 + sizeof(minasigner_signature_t))
+#define MAX_BATCH   65536
+#define BATCH_GRAIN 8
+
+typedef struct {
+    uint32_t             account;
+    minasigner_keypair_t kp;
+    char                 address[MINASIGNER_ADDRESS_LEN];
+} signd_key_t;
+
+typedef struct {
+    atomic_uint_fast64_t connections;
+    atomic_uint_fast64_t batches;
+    atomic_uint_fast64_t transactions;
+    atomic_uint_fast64_t failures;
+    atomic_uint_fast64_t sign_ns;
+    atomic_uint_fast64_t sign_ns_max;
+    atomic_uint_fast64_t batch_ns;
+    atomic_uint_fast64_t batch_ns_max;
+} stats_t;
+
+typedef struct {
+    const uint8_t *txs;
+    uint8_t       *results;
+} batch_t;
+
+static signd_key_t *_keys;
+static size_t _keys_len;
+static signd_pool_t *_pool;
+static stats_t _stats;
+static uint64_t _start_ns;
+static volatile sig_atomic_t _stop;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void stats_max(atomic_uint_fast64_t *max, uint64_t value)
+{
+    uint_fast64_t cur = atomic_load(max);
+    while (value > cur && !atomic_compare_exchange_weak(max, &cur, value)) {
+    }
+}
+
+static uint32_t read_be(const uint8_t *in, const size_t len)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < len; i++) {
+        value = value << 8 | in[i];
+    }
+    return value;
+}
+
+static uint64_t read_be64(const uint8_t *in)
+{
+    return (uint64_t)read_be(in, 4) << 32 | read_be(in + 4, 4);
+}
+
+static void write_be(uint8_t *out, const uint32_t value)
+{
+    out[0] = value >> 24;
+    out[1] = value >> 16;
+    out[2] = value >> 8;
+    out[3] = value;
+}
+
+static int key_cmp(const void *a, const void *b)
+{
+    uint32_t x = ((const signd_key_t *)a)->account;
+    uint32_t y = ((const signd_key_t *)b)->account;
+    return x < y ? -1 : x > y;
+}
+
+static const signd_key_t *key_find(const uint32_t account)
+{
+    signd_key_t needle = { .account = account };
+    return bsearch(&needle, _keys, _keys_len, sizeof(*_keys), key_cmp);
+}
+
+// Decodes a transaction in the INS_SIGN_TX layout and looks up its key
+static minasigner_status_t parse_one(minasigner_transaction_t *tx, const signd_key_t **key,
+                                     const uint8_t *in)
+{
+    memset(tx, 0, sizeof(*tx));
+
+    *key = key_find(read_be(in, 4));
+    if (!*key) {
+        return MINASIGNER_ERR_KEY;
+    }
+
+    memcpy(tx->from, in + 4, MINASIGNER_ADDRESS_LEN - 1);
+    memcpy(tx->to, in + 59, MINASIGNER_ADDRESS_LEN - 1);
+    if (strcmp(tx->from, (*key)->address) != 0) {
+        return MINASIGNER_ERR_KEY;
+    }
+    tx->amount = read_be64(in + 114);
+    tx->fee = read_be64(in + 122);
+    tx->nonce = read_be(in + 130, 4);
+    tx->valid_until = read_be(in + 134, 4);
+    memcpy(tx->memo, in + 138, MINASIGNER_MEMO_LEN);
+    tx->tag = in[170];
+
+    return MINASIGNER_OK;
+}
+
+// Signs the range BATCH_GRAIN transactions at a time with
+// minasigner_sign_transactions(), which derives their nonces together;
+// each transaction is charged an equal share of its group's time
+static void sign_range(void *ctx, size_t begin, size_t end)
+{
+    batch_t *batch = ctx;
+
+    for (size_t i = begin; i < end; i += BATCH_GRAIN) {
+        minasigner_transaction_t txs[BATCH_GRAIN];
+        const minasigner_keypair_t *kps[BATCH_GRAIN];
+        uint8_t network_ids[BATCH_GRAIN];
+        minasigner_signature_t sigs[BATCH_GRAIN] = { };
+        minasigner_status_t status[BATCH_GRAIN];
+        size_t index[BATCH_GRAIN]; // position in the range of each signed transaction
+        size_t n = end - i < BATCH_GRAIN ? end - i : BATCH_GRAIN;
+        size_t signing = 0;
+
+        uint64_t start = now_ns();
+        for (size_t j = 0; j < n; j++) {
+            const uint8_t *in = batch->txs + (i + j)*TX_LEN;
+            const signd_key_t *key;
+
+            status[j] = parse_one(&txs[signing], &key, in);
+            if (status[j] == MINASIGNER_OK) {
+                kps[signing] = &key->kp;
+                network_ids[signing] = in[171];
+                index[signing++] = j;
+            }
+        }
+
+        minasigner_status_t signed_status[BATCH_GRAIN];
+        minasigner_signature_t signed_sigs[BATCH_GRAIN] = { };
+        minasigner_sign_transactions(signed_sigs, signed_status, kps, txs, network_ids, signing);
+        for (size_t k = 0; k < signing; k++) {
+            status[index[k]] = signed_status[k];
+            sigs[index[k]] = signed_sigs[k];
+        }
+        uint64_t elapsed = (now_ns() - start) / n;
+
+        for (size_t j = 0; j < n; j++) {
+            uint8_t *result = batch->results + (i + j)*RESULT_LEN;
+
+            atomic_fetch_add(&_stats.sign_ns, elapsed);
+            stats_max(&_stats.sign_ns_max, elapsed);
+            if (status[j] != MINASIGNER_OK) {
+                atomic_fetch_add(&_stats.failures, 1);
+            }
+
+            result[0] = (uint8_t)(int8_t)status[j];
+            memcpy(result + 1, &sigs[j], sizeof(sigs[j]));
+        }
+    }
+}
+
+static bool read_full(int fd, void *buf, size_t len)
+{
+    uint8_t *p = buf;
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool write_full(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool handle_sign(int fd)
+{
+    uint8_t header[4];
+    bool ok = false;
+
+    if (!read_full(fd, header, sizeof(header))) {
+        return false;
+    }
+    uint32_t count = read_be(header, 4);
+    if (count > MAX_BATCH) {
+        return false;
+    }
+
+    // Response is count | results
+    uint8_t *txs = malloc((size_t)count*TX_LEN + 1);
+    uint8_t *response = malloc(4 + (size_t)count*RESULT_LEN);
+    if (!txs || !response) {
+        goto out;
+    }
+    if (!read_full(fd, txs, (size_t)count*TX_LEN)) {
+        goto out;
+    }
+
+    uint64_t start = now_ns();
+    batch_t batch = { .txs = txs, .results = response + 4 };
+    signd_pool_run(_pool, sign_range, &batch, count, BATCH_GRAIN);
+    uint64_t elapsed = now_ns() - start;
+
+    atomic_fetch_add(&_stats.batches, 1);
+    atomic_fetch_add(&_stats.transactions, count);
+    atomic_fetch_add(&_stats.batch_ns, elapsed);
+    stats_max(&_stats.batch_ns_max, elapsed);
+
+    write_be(response, count);
+    ok = write_full(fd, response, 4 + (size_t)count*RESULT_LEN);
+
+out:
+    free(txs);
+    free(response);
+    return ok;
+}
+
+static bool handle_stats(int fd)
+{
+    char json[512];
+    uint8_t header[4];
+
+    uint64_t uptime = now_ns() - _start_ns;
+    uint64_t txs = atomic_load(&_stats.transactions);
+    uint64_t batches = atomic_load(&_stats.batches);
+    int len = snprintf(json, sizeof(json),
+        "{\"uptime_s\":%.3f,\"threads\":%zu,\"keys\":%zu,\"connections\":%" PRIu64 ","
+        "\"batches\":%" PRIu64 ",\"transactions\":%" PRIu64 ",\"failures\":%" PRIu64 ","
+        "\"tx_per_s\":%.1f,\"sign_us_avg\":%.1f,\"sign_us_max\":%.1f,"
+        "\"batch_ms_avg\":%.3f,\"batch_ms_max\":%.3f}",
+        uptime / 1e9, signd_pool_threads(_pool), _keys_len,
+        (uint64_t)atomic_load(&_stats.connections), batches, txs,
+        (uint64_t)atomic_load(&_stats.failures),
+        uptime ? txs / (uptime / 1e9) : 0.0,
+        txs ? atomic_load(&_stats.sign_ns) / 1e3 / txs : 0.0,
+        atomic_load(&_stats.sign_ns_max) / 1e3,
+        batches ? atomic_load(&_stats.batch_ns) / 1e6 / batches : 0.0,
+        atomic_load(&_stats.batch_ns_max) / 1e6);
+
+    write_be(header, len);
+    return write_full(fd, header, sizeof(header)) && write_full(fd, json, len);
+}
+
+static void *connection(void *arg)
+{
+    int fd = (int)(intptr_t)arg;
+    uint8_t op;
+
+    atomic_fetch_add(&_stats.connections, 1);
+    while (read_full(fd, &op, 1)) {
+        bool ok = false;
+        switch (op) {
+            case OP_SIGN:
+                ok = handle_sign(fd);
+                break;
+            case OP_STATS:
+                ok = handle_stats(fd);
+                break;
+        }
+        if (!ok) {
+            break;
+        }
+    }
+    close(fd);
+
+    return NULL;
+}
+
+static bool load_keys(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+    char hex[65];
+    uint8_t secret[MINASIGNER_SCALAR_BYTES];
+    size_t lineno = 0, cap = 0;
+    struct stat st;
+
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    if (fstat(fileno(f), &st) == 0 && (st.st_mode & 077)) {
+        fprintf(stderr, "Warning: %s is accessible by other users\n", path);
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        char *hash = strchr(line, '#');
+        unsigned long account;
+
+        lineno++;
+        if (hash) {
+            *hash = '\0';
+        }
+        if (sscanf(line, "%lu %64s", &account, hex) != 2) {
+            if (strspn(line, " \t\r\n") != strlen(line)) {
+                fprintf(stderr, "%s:%zu: expected <account> <secret hex>\n", path, lineno);
+                goto fail;
+            }
+            continue;
+        }
+
+        bool ok = strlen(hex) == 2*sizeof(secret) && account <= UINT32_MAX;
+        for (size_t i = 0; ok && i < sizeof(secret); i++) {
+            int hi = hex_nibble(hex[2*i]), lo = hex_nibble(hex[2*i + 1]);
+            ok = hi >= 0 && lo >= 0;
+            secret[i] = hi << 4 | lo;
+        }
+        if (_keys_len == cap) {
+            // Not realloc(), which would free the old keys without wiping them
+            size_t grown = cap ? 2*cap : 16;
+            signd_key_t *keys = calloc(grown, sizeof(*_keys));
+            if (!keys) {
+                goto fail;
+            }
+            if (_keys) {
+                memcpy(keys, _keys, cap*sizeof(*_keys));
+                explicit_bzero(_keys, cap*sizeof(*_keys));
+                free(_keys);
+            }
+            _keys = keys;
+            cap = grown;
+        }
+        signd_key_t *key = &_keys[_keys_len];
+        key->account = account;
+        if (!ok
+                || minasigner_keypair_from_secret(&key->kp, secret) != MINASIGNER_OK
+                || minasigner_address(key->address, &key->kp.pub) != MINASIGNER_OK) {
+            fprintf(stderr, "%s:%zu: invalid key\n", path, lineno);
+            goto fail;
+        }
+        _keys_len++;
+        explicit_bzero(secret, sizeof(secret));
+        explicit_bzero(hex, sizeof(hex));
+    }
+    explicit_bzero(line, sizeof(line));
+    fclose(f);
+    f = NULL;
+
+    qsort(_keys, _keys_len, sizeof(*_keys), key_cmp);
+    for (size_t i = 1; i < _keys_len; i++) {
+        if (_keys[i].account == _keys[i - 1].account) {
+            fprintf(stderr, "%s: duplicate account %" PRIu32 "\n", path, _keys[i].account);
+            goto fail;
+        }
+    }
+
+    return true;
+
+fail:
+    // Every exit after a parse clears the secret buffers and the keys
+    // loaded so far, including a partly loaded one
+    explicit_bzero(line, sizeof(line));
+    explicit_bzero(hex, sizeof(hex));
+    explicit_bzero(secret, sizeof(secret));
+    if (_keys) {
+        explicit_bzero(_keys, cap*sizeof(*_keys));
+        free(_keys);
+        _keys = NULL;
+    }
+    _keys_len = 0;
+    if (f) {
+        fclose(f);
+    }
+    return false;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    _stop = 1;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "Usage: %s -k keyfile -s socket [-j threads]\n", argv0);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *keyfile = NULL, *path = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "k:s:j:h")) != -1) {
+        switch (opt) {
+            case 'k':
+                keyfile = optarg;
+                break;
+            case 's':
+                path = optarg;
+                break;
+            case 'j':
+                threads = strtol(optarg, NULL, 10);
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (!keyfile || !path || optind != argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Socket path too long\n");
+        return 2;
+    }
+    strcpy(addr.sun_path, path);
+
+    if (!load_keys(keyfile)) {
+        return 1;
+    }
+
+    _pool = signd_pool_create(threads > 0 ? threads : 1);
+    if (!_pool) {
+        fprintf(stderr, "Failed to start worker threads\n");
+        return 1;
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        perror("socket");
+        return 1;
+    }
+    unlink(path);
+    mode_t mask = umask(077);
+    if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listener, 64) < 0) {
+        perror(path);
+        return 1;
+    }
+    umask(mask);
+
+    // accept() must be interrupted by signals
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    _start_ns = now_ns();
+    fprintf(stderr, "Signing for %zu accounts on %s with %zu threads\n",
+            _keys_len, path, signd_pool_threads(_pool));
+
+    while (!_stop) {
+        int fd = accept(listener, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            perror("accept");
+            break;
+        }
+
+        pthread_t tid;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        if (pthread_create(&tid, &attr, connection, (void *)(intptr_t)fd) != 0) {
+            close(fd);
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    close(listener);
+    unlink(path);
+    explicit_bzero(_keys, _keys_len*sizeof(*_keys));
+
+    return 0;
+}
@@ -0,0 +1,469 @@
+// libminasigner - host API over the device signer sources
+
+#include <string.h>
+
+#include "minasigner.h"
+
+#include "cx_blake2b_multi.h"
+
+#include "crypto.h"
+#include "parse_tx.h"
+#include "poseidon.h"
+#include "random_oracle_input.h"
+#include "utils.h"
+
+_Static_assert(sizeof(minasigner_public_key_t) == sizeof(Affine), "public key layout");
+_Static_assert(sizeof(minasigner_signature_t) == sizeof(Signature), "signature layout");
+_Static_assert(MINASIGNER_ADDRESS_LEN == MINA_ADDRESS_LEN, "address length");
+_Static_assert(MINASIGNER_MEMO_LEN == MEMO_BYTES - 2, "memo length");
+
+// Pallas base field modulus and group order (see crypto.c)
+static const uint8_t FIELD_MODULUS[MINASIGNER_FIELD_BYTES] = {
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x22, 0x46, 0x98, 0xfc, 0x09, 0x4c, 0xf9, 0x1b,
+    0x99, 0x2d, 0x30, 0xed, 0x00, 0x00, 0x00, 0x01
+};
+
+static const uint8_t GROUP_ORDER[MINASIGNER_SCALAR_BYTES] = {
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x22, 0x46, 0x98, 0xfc, 0x09, 0x94, 0xa8, 0xdd,
+    0x8c, 0x46, 0xeb, 0x21, 0x00, 0x00, 0x00, 0x01
+};
+
+static void write_be(uint8_t *out, const uint64_t value, const size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        out[len - 1 - i] = value >> (8 * i);
+    }
+}
+
+// Builds the random oracle input of a transaction through the device
+// parser (the INS_SIGN_TX layout), so that the same checks apply
+static minasigner_status_t tx_to_roinput(tx_t *tx, ROInput *input,
+                                         const minasigner_transaction_t *mtx,
+                                         const uint8_t network_id)
+{
+    uint8_t buffer[172] = { };
+
+    if (strnlen(mtx->from, sizeof(mtx->from)) != MINA_ADDRESS_LEN - 1
+            || strnlen(mtx->to, sizeof(mtx->to)) != MINA_ADDRESS_LEN - 1) {
+        return MINASIGNER_ERR_ADDRESS;
+    }
+    size_t memo_len = strnlen(mtx->memo, sizeof(mtx->memo));
+    if (memo_len > MINASIGNER_MEMO_LEN) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+
+    // 0-3: account (unused)
+    memcpy(buffer + 4, mtx->from, MINA_ADDRESS_LEN - 1);
+    memcpy(buffer + 59, mtx->to, MINA_ADDRESS_LEN - 1);
+    write_be(buffer + 114, mtx->amount, sizeof(uint64_t));
+    write_be(buffer + 122, mtx->fee, sizeof(uint64_t));
+    write_be(buffer + 130, mtx->nonce, sizeof(uint32_t));
+    write_be(buffer + 134, mtx->valid_until, sizeof(uint32_t));
+    memcpy(buffer + 138, mtx->memo, memo_len);
+    buffer[170] = mtx->tag;
+    buffer[171] = network_id;
+
+    // parse_tx() decodes both addresses, they are only decoded again to
+    // report why it failed
+    if (!parse_tx(buffer, sizeof(buffer), tx)) {
+        if (!validate_address(mtx->from) || !validate_address(mtx->to)) {
+            return MINASIGNER_ERR_ADDRESS;
+        }
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+
+    ROInput tmp = roinput_create(tx->input_fields, tx->input_bits);
+    *input = tmp;
+    transaction_to_roinput(input, &tx->tx);
+
+    return MINASIGNER_OK;
+}
+
+// Checks that kp is a valid keypair and that it is the key of the
+// transaction's source and fee payer, like the device checks the account
+// against the from address, and copies it to keypair
+static minasigner_status_t check_signer(Keypair *keypair, const minasigner_keypair_t *kp,
+                                        const tx_t *parsed)
+{
+    volatile minasigner_status_t status = MINASIGNER_OK;
+
+    memcpy(keypair->priv, kp->secret, sizeof(keypair->priv));
+    memcpy(&keypair->pub, &kp->pub, sizeof(keypair->pub));
+
+    BEGIN_TRY {
+        TRY {
+            Affine pub;
+            generate_pubkey(&pub, keypair->priv);
+            if (!affine_eq(&pub, &keypair->pub)) {
+                status = MINASIGNER_ERR_KEY;
+            }
+            else if (memcmp(pub.x, parsed->tx.source_pk.x, sizeof(pub.x)) != 0
+                    || field_is_odd(pub.y) != parsed->tx.source_pk.is_odd) {
+                status = MINASIGNER_ERR_KEY;
+            }
+        }
+        CATCH_OTHER(e) {
+            status = MINASIGNER_ERR_INTERNAL;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    return status;
+}
+
+// Checks that a secret is in [1, group order)
+static bool secret_is_valid(const uint8_t secret[MINASIGNER_SCALAR_BYTES])
+{
+    static const uint8_t zero[MINASIGNER_SCALAR_BYTES] = { };
+
+    return memcmp(secret, GROUP_ORDER, MINASIGNER_SCALAR_BYTES) < 0
+        && memcmp(secret, zero, MINASIGNER_SCALAR_BYTES) != 0;
+}
+
+int minasigner_api_version(void)
+{
+    return MINASIGNER_API_VERSION;
+}
+
+minasigner_status_t minasigner_keypair_from_secret(minasigner_keypair_t *kp,
+                                                   const uint8_t secret[MINASIGNER_SCALAR_BYTES])
+{
+    volatile minasigner_status_t status = MINASIGNER_OK;
+
+    if (!kp || !secret) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+    if (!secret_is_valid(secret)) {
+        return MINASIGNER_ERR_KEY;
+    }
+
+    BEGIN_TRY {
+        TRY {
+            Affine pub;
+            generate_pubkey(&pub, secret);
+            memmove(kp->secret, secret, sizeof(kp->secret));
+            memcpy(&kp->pub, &pub, sizeof(kp->pub));
+        }
+        CATCH_OTHER(e) {
+            status = MINASIGNER_ERR_INTERNAL;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    return status;
+}
+
+minasigner_status_t minasigner_set_mnemonic(const char *mnemonic, const char *passphrase)
+{
+    volatile minasigner_status_t status = MINASIGNER_OK;
+
+    if (!mnemonic) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+
+    BEGIN_TRY {
+        TRY {
+            host_set_mnemonic(mnemonic, passphrase);
+        }
+        CATCH_OTHER(e) {
+            status = MINASIGNER_ERR_ARGUMENT;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    return status;
+}
+
+minasigner_status_t minasigner_keypair_from_account(minasigner_keypair_t *kp, uint32_t account)
+{
+    volatile minasigner_status_t status = MINASIGNER_OK;
+
+    if (!kp) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+
+    BEGIN_TRY {
+        TRY {
+            Keypair keypair;
+            generate_keypair(&keypair, account);
+            memcpy(kp->secret, keypair.priv, sizeof(kp->secret));
+            memcpy(&kp->pub, &keypair.pub, sizeof(kp->pub));
+            explicit_bzero(&keypair, sizeof(keypair));
+        }
+        CATCH(INVALID_STATE) {
+            // No mnemonic
+            status = MINASIGNER_ERR_KEY;
+        }
+        CATCH_OTHER(e) {
+            status = MINASIGNER_ERR_INTERNAL;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    return status;
+}
+
+minasigner_status_t minasigner_address(char address[MINASIGNER_ADDRESS_LEN],
+                                       const minasigner_public_key_t *pub)
+{
+    volatile minasigner_status_t status = MINASIGNER_OK;
+
+    if (!address || !pub) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+
+    BEGIN_TRY {
+        TRY {
+            Affine p;
+            memcpy(&p, pub, sizeof(p));
+            if (memcmp(p.x, FIELD_MODULUS, sizeof(p.x)) >= 0
+                    || memcmp(p.y, FIELD_MODULUS, sizeof(p.y)) >= 0
+                    || !affine_is_on_curve(&p)) {
+                status = MINASIGNER_ERR_KEY;
+            }
+            else if (!generate_address(address, MINA_ADDRESS_LEN, &p)) {
+                status = MINASIGNER_ERR_INTERNAL;
+            }
+        }
+        CATCH_OTHER(e) {
+            status = MINASIGNER_ERR_INTERNAL;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    return status;
+}
+
+minasigner_status_t minasigner_address_validate(const char *address)
+{
+    if (!address) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+
+    return validate_address(address) ? MINASIGNER_OK : MINASIGNER_ERR_ADDRESS;
+}
+
+minasigner_status_t minasigner_sign_transaction(minasigner_signature_t *sig,
+                                                const minasigner_keypair_t *kp,
+                                                const minasigner_transaction_t *tx,
+                                                uint8_t network_id)
+{
+    minasigner_status_t status;
+    tx_t parsed;
+    ROInput input;
+    Keypair keypair;
+    Signature signature;
+
+    if (!sig || !kp || !tx) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+    if (!secret_is_valid(kp->secret)) {
+        return MINASIGNER_ERR_KEY;
+    }
+
+    status = tx_to_roinput(&parsed, &input, tx, network_id);
+    if (status != MINASIGNER_OK) {
+        return status;
+    }
+
+    status = check_signer(&keypair, kp, &parsed);
+    if (status == MINASIGNER_OK) {
+        // sign() catches its own exceptions
+        if (sign(&signature, &keypair, &input, parsed.network_id)) {
+            memcpy(sig, &signature, sizeof(*sig));
+        }
+        else {
+            status = MINASIGNER_ERR_INTERNAL;
+        }
+    }
+
+    explicit_bzero(&keypair, sizeof(keypair));
+
+    return status;
+}
+
+// Signs up to CX_BLAKE2B_LANES transactions, hashing their nonce
+// derivation messages together
+static void sign_group(minasigner_signature_t *sigs, minasigner_status_t *status,
+                       const minasigner_keypair_t *const kps[],
+                       const minasigner_transaction_t *txs, const uint8_t *network_ids,
+                       const size_t count)
+{
+    tx_t parsed[CX_BLAKE2B_LANES];
+    ROInput input[CX_BLAKE2B_LANES];
+    Keypair keypair[CX_BLAKE2B_LANES];
+    uint8_t msg[CX_BLAKE2B_LANES][DERIVE_MSG_LEN] = { }; // zero padding bits, like the scratch
+    uint8_t digest[CX_BLAKE2B_LANES][SCALAR_BYTES];
+    const unsigned char *in[CX_BLAKE2B_LANES];
+    unsigned char *out[CX_BLAKE2B_LANES];
+    unsigned int len[CX_BLAKE2B_LANES];
+    size_t index[CX_BLAKE2B_LANES]; // transaction of each lane
+    size_t lanes = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!kps[i]) {
+            status[i] = MINASIGNER_ERR_ARGUMENT;
+            continue;
+        }
+        if (!secret_is_valid(kps[i]->secret)) {
+            status[i] = MINASIGNER_ERR_KEY;
+            continue;
+        }
+        status[i] = tx_to_roinput(&parsed[lanes], &input[lanes], &txs[i], network_ids[i]);
+        if (status[i] != MINASIGNER_OK) {
+            continue;
+        }
+        status[i] = check_signer(&keypair[lanes], kps[i], &parsed[lanes]);
+        if (status[i] != MINASIGNER_OK) {
+            continue;
+        }
+
+        int derive_len = roinput_derive_message(msg[lanes], DERIVE_MSG_LEN, &keypair[lanes],
+                                                &input[lanes], parsed[lanes].network_id);
+        if (derive_len < 0) {
+            status[i] = MINASIGNER_ERR_INTERNAL;
+            continue;
+        }
+        in[lanes] = msg[lanes];
+        out[lanes] = digest[lanes];
+        len[lanes] = derive_len;
+        index[lanes++] = i;
+    }
+
+    cx_blake2b_multi(out, SCALAR_BYTES, in, len, lanes);
+
+    for (size_t l = 0; l < lanes; l++) {
+        SignCtx ctx;
+
+        // sign_step() catches its own exceptions
+        sign_init_derived(&ctx, &keypair[l], &input[l], parsed[l].network_id, digest[l]);
+        while (ctx.stage != SIGN_STAGE_DONE) {
+            if (!sign_step(&ctx)) {
+                status[index[l]] = MINASIGNER_ERR_INTERNAL;
+                break;
+            }
+        }
+        if (ctx.stage == SIGN_STAGE_DONE) {
+            memcpy(&sigs[index[l]], &ctx.sig, sizeof(sigs[index[l]]));
+        }
+        sign_clear(&ctx);
+    }
+
+    explicit_bzero(keypair, sizeof(keypair));
+    explicit_bzero(msg, sizeof(msg));
+    explicit_bzero(digest, sizeof(digest));
+}
+
+minasigner_status_t minasigner_sign_transactions(minasigner_signature_t *sigs,
+                                                 minasigner_status_t *status,
+                                                 const minasigner_keypair_t *const kps[],
+                                                 const minasigner_transaction_t *txs,
+                                                 const uint8_t *network_ids,
+                                                 size_t count)
+{
+    if (count > 0 && (!sigs || !status || !kps || !txs || !network_ids)) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+
+    for (size_t i = 0; i < count; i += CX_BLAKE2B_LANES) {
+        size_t n = count - i < CX_BLAKE2B_LANES ? count - i : CX_BLAKE2B_LANES;
+        sign_group(sigs + i, status + i, kps + i, txs + i, network_ids + i, n);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (status[i] != MINASIGNER_OK) {
+            return status[i];
+        }
+    }
+
+    return MINASIGNER_OK;
+}
+
+minasigner_status_t minasigner_verify_transaction(const minasigner_signature_t *sig,
+                                                  const minasigner_public_key_t *pub,
+                                                  const minasigner_transaction_t *tx,
+                                                  uint8_t network_id)
+{
+    volatile minasigner_status_t status;
+    tx_t parsed;
+    ROInput input;
+
+    if (!sig || !pub || !tx) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+
+    status = tx_to_roinput(&parsed, &input, tx, network_id);
+    if (status != MINASIGNER_OK) {
+        return status;
+    }
+
+    BEGIN_TRY {
+        TRY {
+            Signature signature;
+            Affine p;
+            memcpy(&signature, sig, sizeof(signature));
+            memcpy(&p, pub, sizeof(p));
+            if (!verify(&signature, &p, &input, parsed.network_id)) {
+                status = MINASIGNER_ERR_SIGNATURE;
+            }
+        }
+        CATCH_OTHER(e) {
+            status = MINASIGNER_ERR_INTERNAL;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    return status;
+}
+
+minasigner_status_t minasigner_poseidon(uint8_t out[MINASIGNER_FIELD_BYTES],
+                                        const uint8_t (*in)[MINASIGNER_FIELD_BYTES],
+                                        size_t len, uint8_t network_id)
+{
+    volatile minasigner_status_t status = MINASIGNER_OK;
+
+    if (!out || (!in && len > 0)) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+    if (network_id != MINASIGNER_TESTNET && network_id != MINASIGNER_MAINNET) {
+        return MINASIGNER_ERR_ARGUMENT;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (memcmp(in[i], FIELD_MODULUS, MINASIGNER_FIELD_BYTES) >= 0) {
+            return MINASIGNER_ERR_ARGUMENT;
+        }
+    }
+
+    BEGIN_TRY {
+        TRY {
+            State s;
+            poseidon_init(s, network_id);
+            poseidon_update(s, in, len);
+            poseidon_digest(out, s);
+        }
+        CATCH_OTHER(e) {
+            status = MINASIGNER_ERR_INTERNAL;
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    return status;
+}
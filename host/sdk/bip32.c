@@ -0,0 +1,345 @@
+// Host stand-in for the device seed and BIP32 key derivation
+//
+//     The seed is the BIP39 seed of a mnemonic, as given to Speculos with
+//     -s.  It is set with host_set_mnemonic() (or host_set_seed()) or, on
+//     first use, read from the MINA_MNEMONIC environment variable.
+//     os_perso_derive_node_bip32() then derives BIP32 secp256k1 keys from
+//     it exactly as the device does.  Set the seed before deriving keys
+//     from several threads.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "os.h"
+
+#define SEED_MAX_LEN        64
+#define PBKDF2_ITERATIONS   2048
+#define SECP256K1_BYTES     32
+
+static const uint8_t SECP256K1_P[SECP256K1_BYTES] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xfc, 0x2f
+};
+
+static const uint8_t SECP256K1_N[SECP256K1_BYTES] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+    0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b,
+    0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41
+};
+
+static const uint8_t SECP256K1_GX[SECP256K1_BYTES] = {
+    0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb, 0xac,
+    0x55, 0xa0, 0x62, 0x95, 0xce, 0x87, 0x0b, 0x07,
+    0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28, 0xd9,
+    0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17, 0x98
+};
+
+static const uint8_t SECP256K1_GY[SECP256K1_BYTES] = {
+    0x48, 0x3a, 0xda, 0x77, 0x26, 0xa3, 0xc4, 0x65,
+    0x5d, 0xa4, 0xfb, 0xfc, 0x0e, 0x11, 0x08, 0xa8,
+    0xfd, 0x17, 0xb4, 0x48, 0xa6, 0x85, 0x54, 0x19,
+    0x9c, 0x47, 0xd0, 0x8f, 0xfb, 0x10, 0xd4, 0xb8
+};
+
+static uint8_t _seed[SEED_MAX_LEN];
+static size_t _seed_len = 0;
+static pthread_mutex_t _seed_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t _seed_once = PTHREAD_ONCE_INIT;
+
+// secp256k1 in jacobian coordinates, Z = 0 is the point at infinity
+typedef struct {
+    uint8_t X[SECP256K1_BYTES];
+    uint8_t Y[SECP256K1_BYTES];
+    uint8_t Z[SECP256K1_BYTES];
+} point_t;
+
+static void fp_add(uint8_t *r, const uint8_t *a, const uint8_t *b)
+{
+    cx_math_addm(r, a, b, SECP256K1_P, SECP256K1_BYTES);
+}
+
+static void fp_sub(uint8_t *r, const uint8_t *a, const uint8_t *b)
+{
+    cx_math_subm(r, a, b, SECP256K1_P, SECP256K1_BYTES);
+}
+
+static void fp_mul(uint8_t *r, const uint8_t *a, const uint8_t *b)
+{
+    cx_math_multm(r, a, b, SECP256K1_P, SECP256K1_BYTES);
+}
+
+static bool is_zero(const uint8_t *a)
+{
+    static const uint8_t zero[SECP256K1_BYTES] = { };
+    return memcmp(a, zero, SECP256K1_BYTES) == 0;
+}
+
+// dbl-2009-l (a = 0)
+static void point_dbl(point_t *r, const point_t *p)
+{
+    uint8_t a[SECP256K1_BYTES], b[SECP256K1_BYTES], c[SECP256K1_BYTES];
+    uint8_t d[SECP256K1_BYTES], e[SECP256K1_BYTES], f[SECP256K1_BYTES];
+    uint8_t t[SECP256K1_BYTES];
+
+    if (is_zero(p->Z)) {
+        *r = *p;
+        return;
+    }
+
+    fp_mul(a, p->X, p->X);     // A = X1^2
+    fp_mul(b, p->Y, p->Y);     // B = Y1^2
+    fp_mul(c, b, b);           // C = B^2
+    fp_add(t, p->X, b);
+    fp_mul(t, t, t);
+    fp_sub(t, t, a);
+    fp_sub(t, t, c);
+    fp_add(d, t, t);           // D = 2*((X1+B)^2-A-C)
+    fp_add(e, a, a);
+    fp_add(e, e, a);           // E = 3*A
+    fp_mul(f, e, e);           // F = E^2
+
+    fp_mul(t, p->Y, p->Z);
+    fp_add(r->Z, t, t);        // Z3 = 2*Y1*Z1
+    fp_add(t, d, d);
+    fp_sub(r->X, f, t);        // X3 = F-2*D
+    fp_sub(t, d, r->X);
+    fp_mul(t, e, t);
+    fp_add(c, c, c);
+    fp_add(c, c, c);
+    fp_add(c, c, c);
+    fp_sub(r->Y, t, c);        // Y3 = E*(D-X3)-8*C
+}
+
+// add-2007-bl
+static void point_add(point_t *r, const point_t *p, const point_t *q)
+{
+    uint8_t z1z1[SECP256K1_BYTES], z2z2[SECP256K1_BYTES];
+    uint8_t u1[SECP256K1_BYTES], u2[SECP256K1_BYTES];
+    uint8_t s1[SECP256K1_BYTES], s2[SECP256K1_BYTES];
+    uint8_t h[SECP256K1_BYTES], i[SECP256K1_BYTES], j[SECP256K1_BYTES];
+    uint8_t rr[SECP256K1_BYTES], v[SECP256K1_BYTES], t[SECP256K1_BYTES];
+
+    if (is_zero(p->Z)) {
+        *r = *q;
+        return;
+    }
+    if (is_zero(q->Z)) {
+        *r = *p;
+        return;
+    }
+
+    fp_mul(z1z1, p->Z, p->Z);
+    fp_mul(z2z2, q->Z, q->Z);
+    fp_mul(u1, p->X, z2z2);
+    fp_mul(u2, q->X, z1z1);
+    fp_mul(t, q->Z, z2z2);
+    fp_mul(s1, p->Y, t);
+    fp_mul(t, p->Z, z1z1);
+    fp_mul(s2, q->Y, t);
+
+    fp_sub(h, u2, u1);
+    fp_sub(rr, s2, s1);
+    if (is_zero(h)) {
+        if (is_zero(rr)) {
+            point_dbl(r, p);
+        }
+        else {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+
+    fp_add(i, h, h);
+    fp_mul(i, i, i);           // I = (2*H)^2
+    fp_mul(j, h, i);           // J = H*I
+    fp_add(rr, rr, rr);        // r = 2*(S2-S1)
+    fp_mul(v, u1, i);          // V = U1*I
+
+    uint8_t z[SECP256K1_BYTES];
+    fp_add(t, p->Z, q->Z);
+    fp_mul(t, t, t);
+    fp_sub(t, t, z1z1);
+    fp_sub(t, t, z2z2);
+    fp_mul(z, t, h);           // Z3 = ((Z1+Z2)^2-Z1Z1-Z2Z2)*H
+
+    fp_mul(t, rr, rr);
+    fp_sub(t, t, j);
+    fp_sub(t, t, v);
+    fp_sub(r->X, t, v);        // X3 = r^2-J-2*V
+
+    fp_sub(t, v, r->X);
+    fp_mul(t, rr, t);
+    fp_mul(s1, s1, j);
+    fp_add(s1, s1, s1);
+    fp_sub(r->Y, t, s1);       // Y3 = r*(V-X3)-2*S1*J
+    memcpy(r->Z, z, sizeof(z));
+}
+
+// Computes the compressed public key k*G
+static void public_key(uint8_t out[1 + SECP256K1_BYTES], const uint8_t k[SECP256K1_BYTES])
+{
+    point_t g, q, t;
+    uint8_t zi[SECP256K1_BYTES], zi2[SECP256K1_BYTES], y[SECP256K1_BYTES];
+
+    memcpy(g.X, SECP256K1_GX, SECP256K1_BYTES);
+    memcpy(g.Y, SECP256K1_GY, SECP256K1_BYTES);
+    memset(g.Z, 0, SECP256K1_BYTES);
+    g.Z[SECP256K1_BYTES - 1] = 1;
+    memset(&q, 0, sizeof(q));
+
+    for (size_t i = 0; i < 8*SECP256K1_BYTES; i++) {
+        point_dbl(&t, &q);
+        if ((k[i / 8] >> (7 - i % 8)) & 1) {
+            point_add(&q, &t, &g);
+        }
+        else {
+            q = t;
+        }
+    }
+
+    // To affine, k is in [1, n) so q is not the point at infinity
+    cx_math_invprimem(zi, q.Z, SECP256K1_P, SECP256K1_BYTES);
+    fp_mul(zi2, zi, zi);
+    fp_mul(out + 1, q.X, zi2);
+    fp_mul(zi2, zi2, zi);
+    fp_mul(y, q.Y, zi2);
+    out[0] = 0x02 | (y[SECP256K1_BYTES - 1] & 1);
+
+    explicit_bzero(&q, sizeof(q));
+    explicit_bzero(&t, sizeof(t));
+}
+
+void host_set_seed(const uint8_t *seed, size_t len)
+{
+    if (len > SEED_MAX_LEN) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    pthread_mutex_lock(&_seed_lock);
+    memcpy(_seed, seed, len);
+    _seed_len = len;
+    pthread_mutex_unlock(&_seed_lock);
+}
+
+// BIP39 seed: PBKDF2-HMAC-SHA512(mnemonic, "mnemonic" || passphrase, 2048)
+//
+//     The mnemonic and passphrase are used as given, so they should
+//     already be in NFKD form (plain ASCII mnemonics are).
+void host_set_mnemonic(const char *mnemonic, const char *passphrase)
+{
+    uint8_t salt[256 + 4];
+    uint8_t u[CX_SHA512_SIZE], seed[CX_SHA512_SIZE];
+    size_t salt_len;
+
+    if (!passphrase) {
+        passphrase = "";
+    }
+    salt_len = strlen("mnemonic") + strlen(passphrase);
+    if (salt_len > sizeof(salt) - 4) {
+        THROW(INVALID_PARAMETER);
+    }
+    memcpy(salt, "mnemonic", strlen("mnemonic"));
+    memcpy(salt + strlen("mnemonic"), passphrase, strlen(passphrase));
+
+    // Single output block, INT(1)
+    salt[salt_len++] = 0;
+    salt[salt_len++] = 0;
+    salt[salt_len++] = 0;
+    salt[salt_len++] = 1;
+
+    cx_hmac_sha512((const uint8_t *)mnemonic, strlen(mnemonic), salt, salt_len, u, sizeof(u));
+    memcpy(seed, u, sizeof(seed));
+    for (size_t i = 1; i < PBKDF2_ITERATIONS; i++) {
+        cx_hmac_sha512((const uint8_t *)mnemonic, strlen(mnemonic), u, sizeof(u), u, sizeof(u));
+        for (size_t j = 0; j < sizeof(seed); j++) {
+            seed[j] ^= u[j];
+        }
+    }
+
+    host_set_seed(seed, sizeof(seed));
+
+    explicit_bzero(u, sizeof(u));
+    explicit_bzero(seed, sizeof(seed));
+}
+
+static void seed_from_environment(void)
+{
+    const char *mnemonic = getenv("MINA_MNEMONIC");
+
+    pthread_mutex_lock(&_seed_lock);
+    bool set = _seed_len > 0;
+    pthread_mutex_unlock(&_seed_lock);
+
+    if (!set && mnemonic) {
+        host_set_mnemonic(mnemonic, getenv("MINA_PASSPHRASE"));
+    }
+}
+
+void os_perso_derive_node_bip32(cx_curve_t curve, const uint32_t *path,
+                                unsigned int pathLength, unsigned char *privateKey,
+                                unsigned char *chain)
+{
+    uint8_t key[SECP256K1_BYTES], code[SECP256K1_BYTES];
+    uint8_t data[1 + SECP256K1_BYTES + 4];
+    uint8_t i[CX_SHA512_SIZE];
+
+    if (curve != CX_CURVE_256K1) {
+        THROW(NOT_SUPPORTED);
+    }
+
+    pthread_once(&_seed_once, seed_from_environment);
+
+    // Master node
+    pthread_mutex_lock(&_seed_lock);
+    size_t seed_len = _seed_len;
+    if (seed_len > 0) {
+        cx_hmac_sha512((const uint8_t *)"Bitcoin seed", 12, _seed, _seed_len, i, sizeof(i));
+    }
+    pthread_mutex_unlock(&_seed_lock);
+    if (seed_len == 0) {
+        // No seed, see host_set_mnemonic()
+        THROW(INVALID_STATE);
+    }
+    memcpy(key, i, SECP256K1_BYTES);
+    memcpy(code, i + SECP256K1_BYTES, SECP256K1_BYTES);
+
+    // Child nodes
+    for (unsigned int n = 0; n < pathLength; n++) {
+        if (path[n] & 0x80000000) {
+            data[0] = 0x00;
+            memcpy(data + 1, key, SECP256K1_BYTES);
+        }
+        else {
+            public_key(data, key);
+        }
+        data[33] = path[n] >> 24;
+        data[34] = path[n] >> 16;
+        data[35] = path[n] >> 8;
+        data[36] = path[n];
+
+        cx_hmac_sha512(code, sizeof(code), data, sizeof(data), i, sizeof(i));
+        if (memcmp(i, SECP256K1_N, SECP256K1_BYTES) >= 0) {
+            // Invalid child, probability below 2^-127
+            THROW(INVALID_PARAMETER);
+        }
+        cx_math_addm(key, i, key, SECP256K1_N, SECP256K1_BYTES);
+        if (is_zero(key)) {
+            THROW(INVALID_PARAMETER);
+        }
+        memcpy(code, i + SECP256K1_BYTES, SECP256K1_BYTES);
+    }
+
+    memcpy(privateKey, key, SECP256K1_BYTES);
+    if (chain) {
+        memcpy(chain, code, SECP256K1_BYTES);
+    }
+
+    explicit_bzero(key, sizeof(key));
+    explicit_bzero(code, sizeof(code));
+    explicit_bzero(data, sizeof(data));
+    explicit_bzero(i, sizeof(i));
+}
@@ -0,0 +1,807 @@
+// Host SHA-256, SHA-512 (FIPS 180-4) and BLAKE2b (RFC 7693) behind the cx_hash API
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "cx.h"
+#include "cx_blake2b_multi.h"
+#include "cx_sha256_multi.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    #include <cpuid.h>
+    #include <immintrin.h>
+    #define HAVE_SHA_NI
+#endif
+
+// SHA-256
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_compress_generic(uint32_t acc[8], const uint8_t block[64])
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h;
+
+    for (size_t i = 0; i < 16; i++) {
+        w[i] = (uint32_t)block[4*i] << 24 | (uint32_t)block[4*i + 1] << 16 |
+               (uint32_t)block[4*i + 2] << 8 | block[4*i + 3];
+    }
+    for (size_t i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = acc[0]; b = acc[1]; c = acc[2]; d = acc[3];
+    e = acc[4]; f = acc[5]; g = acc[6]; h = acc[7];
+    for (size_t i = 0; i < 64; i++) {
+        uint32_t s1 = ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+        uint32_t s0 = ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    acc[0] += a; acc[1] += b; acc[2] += c; acc[3] += d;
+    acc[4] += e; acc[5] += f; acc[6] += g; acc[7] += h;
+}
+
+#ifdef HAVE_SHA_NI
+// The SHA extensions keep the state as ABEF and CDGH and do two rounds
+// per sha256rnds2; each iteration does four rounds and schedules the
+// message words for the iteration four ahead
+__attribute__((target("sha,sse4.1")))
+static void sha256_compress_shani(uint32_t acc[8], const uint8_t block[64])
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i msg[4], state0, state1, abef, cdgh, tmp;
+
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&acc[0]), 0xb1);    // CDAB
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&acc[4]), 0x1b); // EFGH
+    state0 = _mm_alignr_epi8(tmp, state1, 8);                                    // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);                                 // CDGH
+    abef = state0;
+    cdgh = state1;
+
+    for (size_t i = 0; i < 4; i++) {
+        msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(block + 16*i)), bswap);
+    }
+    for (size_t i = 0; i < 16; i++) {
+        __m128i k = _mm_add_epi32(msg[i & 3], _mm_loadu_si128((const __m128i *)&SHA256_K[4*i]));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(k, 0x0e));
+        if (i < 12) {
+            tmp = _mm_add_epi32(_mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]),
+                                _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+            msg[i & 3] = _mm_sha256msg2_epu32(tmp, msg[(i + 3) & 3]);
+        }
+    }
+
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+    tmp = _mm_shuffle_epi32(state0, 0x1b);                                       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xb1);                                    // DCHG
+    _mm_storeu_si128((__m128i *)&acc[0], _mm_blend_epi16(tmp, state1, 0xf0));   // DCBA
+    _mm_storeu_si128((__m128i *)&acc[4], _mm_alignr_epi8(state1, tmp, 8));      // HGFE
+}
+#endif
+
+static void (*_sha256_compress)(uint32_t acc[8], const uint8_t block[64]) = sha256_compress_generic;
+
+#ifdef HAVE_SHA_NI
+static bool _sha_ni_supported;
+
+__attribute__((constructor))
+static void sha256_select(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    __builtin_cpu_init();
+    _sha_ni_supported = __builtin_cpu_supports("sse4.1")
+        && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_SHA);
+    cx_sha256_set_sha_ni(1);
+}
+#endif
+
+int cx_sha256_set_sha_ni(int enable)
+{
+#ifdef HAVE_SHA_NI
+    if (enable && _sha_ni_supported) {
+        _sha256_compress = sha256_compress_shani;
+        return 1;
+    }
+#endif
+    _sha256_compress = sha256_compress_generic;
+    return 0;
+}
+
+static void sha256_compress(uint32_t acc[8], const uint8_t block[64])
+{
+    _sha256_compress(acc, block);
+}
+
+static const uint32_t SHA256_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+int cx_sha256_init(cx_sha256_t *hash)
+{
+    memset(hash, 0, sizeof(*hash));
+    hash->header.algo = CX_SHA256;
+    memcpy(hash->acc, SHA256_IV, sizeof(SHA256_IV));
+
+    return CX_SHA256;
+}
+
+static void sha256_update(cx_sha256_t *hash, const uint8_t *in, size_t len)
+{
+    hash->length += len;
+    if (hash->blen) {
+        size_t n = 64 - hash->blen < len ? 64 - hash->blen : len;
+        memcpy(hash->block + hash->blen, in, n);
+        hash->blen += n;
+        in += n;
+        len -= n;
+        if (hash->blen < 64) {
+            return;
+        }
+        sha256_compress(hash->acc, hash->block);
+        hash->blen = 0;
+    }
+    for (; len >= 64; in += 64, len -= 64) {
+        sha256_compress(hash->acc, in);
+    }
+    memcpy(hash->block, in, len);
+    hash->blen = len;
+}
+
+static void sha256_final(cx_sha256_t *hash, uint8_t *out)
+{
+    uint64_t bits = hash->length * 8;
+
+    hash->block[hash->blen++] = 0x80;
+    if (hash->blen > 56) {
+        memset(hash->block + hash->blen, 0, 64 - hash->blen);
+        sha256_compress(hash->acc, hash->block);
+        hash->blen = 0;
+    }
+    memset(hash->block + hash->blen, 0, 56 - hash->blen);
+    for (size_t i = 0; i < 8; i++) {
+        hash->block[63 - i] = bits >> (8 * i);
+    }
+    sha256_compress(hash->acc, hash->block);
+
+    for (size_t i = 0; i < 8; i++) {
+        out[4*i] = hash->acc[i] >> 24;
+        out[4*i + 1] = hash->acc[i] >> 16;
+        out[4*i + 2] = hash->acc[i] >> 8;
+        out[4*i + 3] = hash->acc[i];
+    }
+}
+
+int cx_hash_sha256(const unsigned char *in, unsigned int len,
+                   unsigned char *out, unsigned int out_len)
+{
+    cx_sha256_t hash;
+
+    if (out_len < CX_SHA256_SIZE) {
+        return 0;
+    }
+    cx_sha256_init(&hash);
+    sha256_update(&hash, in, len);
+    sha256_final(&hash, out);
+
+    return CX_SHA256_SIZE;
+}
+
+// Multi-message double SHA-256
+//
+//     Single block messages only (at most 55 bytes), which covers base58
+//     check payloads: both hashes are then one compression each.  With
+//     the SHA extensions the messages are hashed one after the other,
+//     otherwise lane l of every vector holds message l and the scalar
+//     rounds run on vectors (eight lanes are one AVX2 register).
+
+typedef uint32_t sha256_vec_t __attribute__((vector_size(4 * CX_SHA256_LANES)));
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    #define SHA256_MULTI_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+    #define SHA256_MULTI_CLONES
+#endif
+
+// w[0..15] is the padded block, w is clobbered by the message schedule
+static inline void sha256_compress_vec(sha256_vec_t acc[8], sha256_vec_t w[64])
+{
+    sha256_vec_t a, b, c, d, e, f, g, h;
+
+    for (size_t i = 16; i < 64; i++) {
+        sha256_vec_t s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        sha256_vec_t s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = acc[0]; b = acc[1]; c = acc[2]; d = acc[3];
+    e = acc[4]; f = acc[5]; g = acc[6]; h = acc[7];
+    for (size_t i = 0; i < 64; i++) {
+        sha256_vec_t s1 = ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25);
+        sha256_vec_t ch = (e & f) ^ (~e & g);
+        sha256_vec_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+        sha256_vec_t s0 = ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22);
+        sha256_vec_t maj = (a & b) ^ (a & c) ^ (b & c);
+        sha256_vec_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    acc[0] += a; acc[1] += b; acc[2] += c; acc[3] += d;
+    acc[4] += e; acc[5] += f; acc[6] += g; acc[7] += h;
+}
+
+// One message at a time with the selected compression function
+static void sha256d_block(uint8_t *out, const uint8_t *in, size_t len)
+{
+    uint32_t acc[8];
+    uint8_t block[64] = { };
+
+    memcpy(block, in, len);
+    block[len] = 0x80;
+    block[62] = (len * 8) >> 8;
+    block[63] = len * 8;
+    memcpy(acc, SHA256_IV, sizeof(acc));
+    sha256_compress(acc, block);
+
+    memset(block, 0, sizeof(block));
+    for (size_t i = 0; i < 8; i++) {
+        block[4*i] = acc[i] >> 24;
+        block[4*i + 1] = acc[i] >> 16;
+        block[4*i + 2] = acc[i] >> 8;
+        block[4*i + 3] = acc[i];
+    }
+    block[CX_SHA256_SIZE] = 0x80;
+    block[62] = (8 * CX_SHA256_SIZE) >> 8;
+    memcpy(acc, SHA256_IV, sizeof(acc));
+    sha256_compress(acc, block);
+
+    for (size_t i = 0; i < 8; i++) {
+        out[4*i] = acc[i] >> 24;
+        out[4*i + 1] = acc[i] >> 16;
+        out[4*i + 2] = acc[i] >> 8;
+        out[4*i + 3] = acc[i];
+    }
+    explicit_bzero(block, sizeof(block));
+}
+
+SHA256_MULTI_CLONES
+static void sha256d_multi(uint8_t *const out[], const uint8_t *const in[], size_t len,
+                          size_t count)
+{
+    sha256_vec_t acc[8], w[64];
+    uint8_t block[64];
+
+    // First hash: the padded messages
+    for (size_t l = 0; l < CX_SHA256_LANES; l++) {
+        memset(block, 0, sizeof(block));
+        if (l < count) {
+            memcpy(block, in[l], len);
+        }
+        block[len] = 0x80;
+        block[62] = (len * 8) >> 8;
+        block[63] = len * 8;
+        for (size_t i = 0; i < 16; i++) {
+            w[i][l] = (uint32_t)block[4*i] << 24 | (uint32_t)block[4*i + 1] << 16 |
+                      (uint32_t)block[4*i + 2] << 8 | block[4*i + 3];
+        }
+    }
+    for (size_t i = 0; i < 8; i++) {
+        acc[i] = (sha256_vec_t){ 0 } + SHA256_IV[i];
+    }
+    sha256_compress_vec(acc, w);
+
+    // Second hash: the first digests, padded
+    for (size_t i = 0; i < 8; i++) {
+        w[i] = acc[i];
+        acc[i] = (sha256_vec_t){ 0 } + SHA256_IV[i];
+    }
+    w[8] = (sha256_vec_t){ 0 } + 0x80000000;
+    for (size_t i = 9; i < 15; i++) {
+        w[i] = (sha256_vec_t){ 0 };
+    }
+    w[15] = (sha256_vec_t){ 0 } + 8 * CX_SHA256_SIZE;
+    sha256_compress_vec(acc, w);
+
+    for (size_t l = 0; l < count; l++) {
+        for (size_t i = 0; i < 8; i++) {
+            out[l][4*i] = acc[i][l] >> 24;
+            out[l][4*i + 1] = acc[i][l] >> 16;
+            out[l][4*i + 2] = acc[i][l] >> 8;
+            out[l][4*i + 3] = acc[i][l];
+        }
+    }
+
+    explicit_bzero(block, sizeof(block));
+    explicit_bzero(w, sizeof(w));
+}
+
+int cx_sha256d_multi(unsigned char *const out[], const unsigned char *const in[],
+                     unsigned int len, unsigned int count)
+{
+    if (len > CX_SHA256D_MULTI_MAX_LEN || count > CX_SHA256_LANES) {
+        return 0;
+    }
+
+    if (_sha256_compress != sha256_compress_generic) {
+        for (size_t l = 0; l < count; l++) {
+            sha256d_block(out[l], in[l], len);
+        }
+    }
+    else if (count > 0) {
+        sha256d_multi(out, in, len, count);
+    }
+
+    return CX_SHA256_SIZE;
+}
+
+// SHA-512
+
+static const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static void sha512_compress(uint64_t acc[8], const uint8_t block[128])
+{
+    uint64_t w[80];
+    uint64_t a, b, c, d, e, f, g, h;
+
+    for (size_t i = 0; i < 16; i++) {
+        w[i] = 0;
+        for (size_t j = 0; j < 8; j++) {
+            w[i] = w[i] << 8 | block[8*i + j];
+        }
+    }
+    for (size_t i = 16; i < 80; i++) {
+        uint64_t s0 = ROTR64(w[i - 15], 1) ^ ROTR64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        uint64_t s1 = ROTR64(w[i - 2], 19) ^ ROTR64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = acc[0]; b = acc[1]; c = acc[2]; d = acc[3];
+    e = acc[4]; f = acc[5]; g = acc[6]; h = acc[7];
+    for (size_t i = 0; i < 80; i++) {
+        uint64_t s1 = ROTR64(e, 14) ^ ROTR64(e, 18) ^ ROTR64(e, 41);
+        uint64_t ch = (e & f) ^ (~e & g);
+        uint64_t t1 = h + s1 + ch + SHA512_K[i] + w[i];
+        uint64_t s0 = ROTR64(a, 28) ^ ROTR64(a, 34) ^ ROTR64(a, 39);
+        uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint64_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    acc[0] += a; acc[1] += b; acc[2] += c; acc[3] += d;
+    acc[4] += e; acc[5] += f; acc[6] += g; acc[7] += h;
+}
+
+int cx_sha512_init(cx_sha512_t *hash)
+{
+    static const uint64_t IV[8] = {
+        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+    };
+
+    memset(hash, 0, sizeof(*hash));
+    hash->header.algo = CX_SHA512;
+    memcpy(hash->acc, IV, sizeof(IV));
+
+    return CX_SHA512;
+}
+
+static void sha512_update(cx_sha512_t *hash, const uint8_t *in, size_t len)
+{
+    hash->length += len;
+    if (hash->blen) {
+        size_t n = 128 - hash->blen < len ? 128 - hash->blen : len;
+        memcpy(hash->block + hash->blen, in, n);
+        hash->blen += n;
+        in += n;
+        len -= n;
+        if (hash->blen < 128) {
+            return;
+        }
+        sha512_compress(hash->acc, hash->block);
+        hash->blen = 0;
+    }
+    for (; len >= 128; in += 128, len -= 128) {
+        sha512_compress(hash->acc, in);
+    }
+    memcpy(hash->block, in, len);
+    hash->blen = len;
+}
+
+static void sha512_final(cx_sha512_t *hash, uint8_t *out)
+{
+    uint64_t bits = hash->length * 8;
+
+    hash->block[hash->blen++] = 0x80;
+    if (hash->blen > 112) {
+        memset(hash->block + hash->blen, 0, 128 - hash->blen);
+        sha512_compress(hash->acc, hash->block);
+        hash->blen = 0;
+    }
+    // Message lengths are below 2^64 bits
+    memset(hash->block + hash->blen, 0, 120 - hash->blen);
+    for (size_t i = 0; i < 8; i++) {
+        hash->block[127 - i] = bits >> (8 * i);
+    }
+    sha512_compress(hash->acc, hash->block);
+
+    for (size_t i = 0; i < 64; i++) {
+        out[i] = hash->acc[i / 8] >> (56 - 8 * (i % 8));
+    }
+}
+
+int cx_hash_sha512(const unsigned char *in, unsigned int len,
+                   unsigned char *out, unsigned int out_len)
+{
+    cx_sha512_t hash;
+
+    if (out_len < CX_SHA512_SIZE) {
+        return 0;
+    }
+    cx_sha512_init(&hash);
+    sha512_update(&hash, in, len);
+    sha512_final(&hash, out);
+
+    return CX_SHA512_SIZE;
+}
+
+int cx_hmac_sha512(const unsigned char *key, unsigned int key_len,
+                   const unsigned char *in, unsigned int len,
+                   unsigned char *mac, unsigned int mac_len)
+{
+    uint8_t k[128] = { };
+    uint8_t pad[128];
+    uint8_t inner[CX_SHA512_SIZE];
+    cx_sha512_t hash;
+
+    if (mac_len < CX_SHA512_SIZE) {
+        return 0;
+    }
+    if (key_len > sizeof(k)) {
+        cx_hash_sha512(key, key_len, k, CX_SHA512_SIZE);
+    }
+    else {
+        memcpy(k, key, key_len);
+    }
+
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] = k[i] ^ 0x36;
+    }
+    cx_sha512_init(&hash);
+    sha512_update(&hash, pad, sizeof(pad));
+    sha512_update(&hash, in, len);
+    sha512_final(&hash, inner);
+
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] = k[i] ^ 0x5c;
+    }
+    cx_sha512_init(&hash);
+    sha512_update(&hash, pad, sizeof(pad));
+    sha512_update(&hash, inner, sizeof(inner));
+    sha512_final(&hash, mac);
+
+    explicit_bzero(k, sizeof(k));
+    explicit_bzero(pad, sizeof(pad));
+    explicit_bzero(inner, sizeof(inner));
+
+    return CX_SHA512_SIZE;
+}
+
+// BLAKE2b
+
+static const uint64_t BLAKE2B_IV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+static const uint8_t BLAKE2B_SIGMA[12][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }
+};
+
+
+#define BLAKE2B_G(a, b, c, d, x, y)         \
+    do {                                    \
+        v[a] = v[a] + v[b] + (x);           \
+        v[d] = ROTR64(v[d] ^ v[a], 32);     \
+        v[c] = v[c] + v[d];                 \
+        v[b] = ROTR64(v[b] ^ v[c], 24);     \
+        v[a] = v[a] + v[b] + (y);           \
+        v[d] = ROTR64(v[d] ^ v[a], 16);     \
+        v[c] = v[c] + v[d];                 \
+        v[b] = ROTR64(v[b] ^ v[c], 63);     \
+    } while (0)
+
+static void blake2b_compress(cx_blake2b_t *hash, bool last)
+{
+    uint64_t v[16];
+    uint64_t m[16];
+
+    for (size_t i = 0; i < 16; i++) {
+        m[i] = 0;
+        for (size_t j = 0; j < 8; j++) {
+            m[i] |= (uint64_t)hash->ctx.buf[8*i + j] << (8 * j);
+        }
+    }
+    for (size_t i = 0; i < 8; i++) {
+        v[i] = hash->ctx.h[i];
+        v[i + 8] = BLAKE2B_IV[i];
+    }
+    v[12] ^= hash->ctx.t[0];
+    v[13] ^= hash->ctx.t[1];
+    if (last) {
+        v[14] = ~v[14];
+    }
+
+    for (size_t r = 0; r < 12; r++) {
+        const uint8_t *s = BLAKE2B_SIGMA[r];
+        BLAKE2B_G(0, 4,  8, 12, m[s[0]],  m[s[1]]);
+        BLAKE2B_G(1, 5,  9, 13, m[s[2]],  m[s[3]]);
+        BLAKE2B_G(2, 6, 10, 14, m[s[4]],  m[s[5]]);
+        BLAKE2B_G(3, 7, 11, 15, m[s[6]],  m[s[7]]);
+        BLAKE2B_G(0, 5, 10, 15, m[s[8]],  m[s[9]]);
+        BLAKE2B_G(1, 6, 11, 12, m[s[10]], m[s[11]]);
+        BLAKE2B_G(2, 7,  8, 13, m[s[12]], m[s[13]]);
+        BLAKE2B_G(3, 4,  9, 14, m[s[14]], m[s[15]]);
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+        hash->ctx.h[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+static void blake2b_count(cx_blake2b_t *hash, size_t len)
+{
+    hash->ctx.t[0] += len;
+    if (hash->ctx.t[0] < len) {
+        hash->ctx.t[1]++;
+    }
+}
+
+int cx_blake2b_init(cx_blake2b_t *hash, unsigned int out_len)
+{
+    // Output length is given in bits
+    size_t outlen = out_len / 8;
+    if (outlen == 0 || outlen > 64) {
+        return 0;
+    }
+
+    memset(hash, 0, sizeof(*hash));
+    hash->header.algo = CX_BLAKE2B;
+    hash->ctx.outlen = outlen;
+    for (size_t i = 0; i < 8; i++) {
+        hash->ctx.h[i] = BLAKE2B_IV[i];
+    }
+    hash->ctx.h[0] ^= 0x01010000 ^ outlen;
+
+    return CX_BLAKE2B;
+}
+
+static void blake2b_update(cx_blake2b_t *hash, const uint8_t *in, size_t len)
+{
+    while (len > 0) {
+        // The final block is only compressed by blake2b_final
+        if (hash->ctx.buflen == sizeof(hash->ctx.buf)) {
+            blake2b_count(hash, sizeof(hash->ctx.buf));
+            blake2b_compress(hash, false);
+            hash->ctx.buflen = 0;
+        }
+        size_t n = sizeof(hash->ctx.buf) - hash->ctx.buflen;
+        n = n < len ? n : len;
+        memcpy(hash->ctx.buf + hash->ctx.buflen, in, n);
+        hash->ctx.buflen += n;
+        in += n;
+        len -= n;
+    }
+}
+
+static void blake2b_final(cx_blake2b_t *hash, uint8_t *out)
+{
+    blake2b_count(hash, hash->ctx.buflen);
+    memset(hash->ctx.buf + hash->ctx.buflen, 0, sizeof(hash->ctx.buf) - hash->ctx.buflen);
+    blake2b_compress(hash, true);
+
+    for (size_t i = 0; i < hash->ctx.outlen; i++) {
+        out[i] = hash->ctx.h[i / 8] >> (8 * (i % 8));
+    }
+}
+
+// Multi-message BLAKE2b
+//
+//     Lane l of every vector holds the state of message l, so the rounds
+//     are the scalar ones (BLAKE2B_G) on vectors.  Messages may differ in
+//     length: a lane whose message has ended keeps its state through the
+//     remaining blocks.  GCC vector extensions split the 8 lanes over
+//     whatever registers the clone targets.
+
+typedef uint64_t blake2b_vec_t __attribute__((vector_size(8 * CX_BLAKE2B_LANES)));
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    #define BLAKE2B_MULTI_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+    #define BLAKE2B_MULTI_CLONES
+#endif
+
+static uint64_t load64_le(const uint8_t *in, size_t len)
+{
+    uint64_t w = 0;
+    for (size_t j = 0; j < len && j < 8; j++) {
+        w |= (uint64_t)in[j] << (8 * j);
+    }
+    return w;
+}
+
+BLAKE2B_MULTI_CLONES
+static void blake2b_multi(uint8_t *const out[], size_t out_len,
+                          const uint8_t *const in[], const unsigned int len[],
+                          size_t count)
+{
+    blake2b_vec_t h[8], v[16], m[16], t, f, active;
+    size_t blocks = 1;
+
+    for (size_t i = 0; i < 8; i++) {
+        h[i] = (blake2b_vec_t){ 0 } + BLAKE2B_IV[i];
+    }
+    h[0] ^= 0x01010000 ^ out_len;
+
+    for (size_t l = 0; l < count; l++) {
+        size_t n = len[l] ? (len[l] + 127) / 128 : 1;
+        blocks = n > blocks ? n : blocks;
+    }
+
+    for (size_t b = 0; b < blocks; b++) {
+        const size_t offset = 128 * b;
+        for (size_t l = 0; l < CX_BLAKE2B_LANES; l++) {
+            size_t n = l < count && len[l] > offset ? len[l] - offset : 0;
+            n = n < 128 ? n : 128;
+            for (size_t i = 0; i < 16; i++) {
+                m[i][l] = 8*i < n ? load64_le(in[l] + offset + 8*i, n - 8*i) : 0;
+            }
+            bool last = l < count && (len[l] <= offset + 128);
+            active[l] = l < count && (b == 0 || len[l] > offset) ? ~0ULL : 0;
+            t[l] = offset + n;
+            f[l] = last ? ~0ULL : 0;
+        }
+
+        for (size_t i = 0; i < 8; i++) {
+            v[i] = h[i];
+            v[i + 8] = (blake2b_vec_t){ 0 } + BLAKE2B_IV[i];
+        }
+        v[12] ^= t;
+        v[14] ^= f;
+
+        for (size_t r = 0; r < 12; r++) {
+            const uint8_t *s = BLAKE2B_SIGMA[r];
+            BLAKE2B_G(0, 4,  8, 12, m[s[0]],  m[s[1]]);
+            BLAKE2B_G(1, 5,  9, 13, m[s[2]],  m[s[3]]);
+            BLAKE2B_G(2, 6, 10, 14, m[s[4]],  m[s[5]]);
+            BLAKE2B_G(3, 7, 11, 15, m[s[6]],  m[s[7]]);
+            BLAKE2B_G(0, 5, 10, 15, m[s[8]],  m[s[9]]);
+            BLAKE2B_G(1, 6, 11, 12, m[s[10]], m[s[11]]);
+            BLAKE2B_G(2, 7,  8, 13, m[s[12]], m[s[13]]);
+            BLAKE2B_G(3, 4,  9, 14, m[s[14]], m[s[15]]);
+        }
+
+        for (size_t i = 0; i < 8; i++) {
+            h[i] ^= (v[i] ^ v[i + 8]) & active;
+        }
+    }
+
+    for (size_t l = 0; l < count; l++) {
+        for (size_t i = 0; i < out_len; i++) {
+            out[l][i] = h[i / 8][l] >> (8 * (i % 8));
+        }
+    }
+
+    explicit_bzero(m, sizeof(m));
+    explicit_bzero(v, sizeof(v));
+    explicit_bzero(h, sizeof(h));
+}
+
+int cx_blake2b_multi(unsigned char *const out[], unsigned int out_len,
+                     const unsigned char *const in[], const unsigned int len[],
+                     unsigned int count)
+{
+    if (out_len == 0 || out_len > 64 || count > CX_BLAKE2B_LANES) {
+        return 0;
+    }
+
+    blake2b_multi(out, out_len, in, len, count);
+    return out_len;
+}
+
+int cx_hash(cx_hash_t *hash, int mode, const unsigned char *in, unsigned int len,
+            unsigned char *out, unsigned int out_len)
+{
+    switch (hash->algo) {
+        case CX_SHA256:
+            sha256_update((cx_sha256_t *)hash, in, len);
+            if (mode & CX_LAST) {
+                if (out_len < CX_SHA256_SIZE) {
+                    return 0;
+                }
+                sha256_final((cx_sha256_t *)hash, out);
+                return CX_SHA256_SIZE;
+            }
+            return 0;
+
+        case CX_SHA512:
+            sha512_update((cx_sha512_t *)hash, in, len);
+            if (mode & CX_LAST) {
+                if (out_len < CX_SHA512_SIZE) {
+                    return 0;
+                }
+                sha512_final((cx_sha512_t *)hash, out);
+                return CX_SHA512_SIZE;
+            }
+            return 0;
+
+        case CX_BLAKE2B:
+            blake2b_update((cx_blake2b_t *)hash, in, len);
+            if (mode & CX_LAST) {
+                size_t outlen = ((cx_blake2b_t *)hash)->ctx.outlen;
+                if (out_len < outlen) {
+                    return 0;
+                }
+                blake2b_final((cx_blake2b_t *)hash, out);
+                return outlen;
+            }
+            return 0;
+
+        default:
+            return 0;
+    }
+}
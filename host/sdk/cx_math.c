@@ -0,0 +1,294 @@
+// Host big-endian modular arithmetic
+//
+//     Operands are converted to four 64-bit little-endian limbs and
+//     multiplied in the Montgomery domain.  The per-modulus constants
+//     (m' = -m^-1 mod 2^64 and R^2 mod m) are cached per thread, since the
+//     signer only ever uses the Pallas base field and group order.
+//     cx_mont.h exposes the Montgomery domain itself.
+
+#include <string.h>
+
+#include "cx_mont.h"
+#include "os.h"
+
+#define LIMBS 4
+#define CACHE_SIZE 4
+
+typedef unsigned __int128 uint128_t;
+
+typedef struct cx_mont_ctx_s {
+    uint64_t m[LIMBS];
+    uint64_t m_inv;      // -m^-1 mod 2^64
+    uint64_t r2[LIMBS];  // R^2 mod m, R = 2^256
+} mont_ctx_t;
+
+static __thread mont_ctx_t _cache[CACHE_SIZE];
+static __thread size_t _cache_len = 0;
+static __thread size_t _cache_next = 0;
+
+static void from_bytes(uint64_t r[LIMBS], const unsigned char *a, unsigned int len)
+{
+    if (len > LIMBS*8) {
+        THROW(INVALID_PARAMETER);
+    }
+    memset(r, 0, LIMBS*sizeof(uint64_t));
+    for (unsigned int i = 0; i < len; i++) {
+        r[i / 8] |= (uint64_t)a[len - 1 - i] << (8 * (i % 8));
+    }
+}
+
+static void to_bytes(unsigned char *r, const uint64_t a[LIMBS], unsigned int len)
+{
+    for (unsigned int i = 0; i < len; i++) {
+        r[len - 1 - i] = a[i / 8] >> (8 * (i % 8));
+    }
+}
+
+static bool geq(const uint64_t a[LIMBS], const uint64_t b[LIMBS])
+{
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] > b[i];
+        }
+    }
+    return true;
+}
+
+static uint64_t add(uint64_t r[LIMBS], const uint64_t a[LIMBS], const uint64_t b[LIMBS])
+{
+    uint128_t carry = 0;
+    for (size_t i = 0; i < LIMBS; i++) {
+        carry += (uint128_t)a[i] + b[i];
+        r[i] = (uint64_t)carry;
+        carry >>= 64;
+    }
+    return (uint64_t)carry;
+}
+
+static uint64_t sub(uint64_t r[LIMBS], const uint64_t a[LIMBS], const uint64_t b[LIMBS])
+{
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < LIMBS; i++) {
+        uint128_t d = (uint128_t)a[i] - b[i] - borrow;
+        r[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    return borrow;
+}
+
+static void reduce(uint64_t a[LIMBS], const uint64_t m[LIMBS])
+{
+    while (geq(a, m)) {
+        sub(a, a, m);
+    }
+}
+
+static void mod_add(uint64_t r[LIMBS], const uint64_t a[LIMBS], const uint64_t b[LIMBS],
+                    const uint64_t m[LIMBS])
+{
+    uint64_t carry = add(r, a, b);
+    if (carry || geq(r, m)) {
+        sub(r, r, m);
+    }
+}
+
+// Montgomery product a*b*R^-1 mod m (CIOS)
+static void mont_mul(uint64_t r[LIMBS], const uint64_t a[LIMBS], const uint64_t b[LIMBS],
+                     const mont_ctx_t *ctx)
+{
+    uint64_t t[LIMBS + 2] = { 0 };
+
+    for (size_t i = 0; i < LIMBS; i++) {
+        uint128_t c = 0;
+        for (size_t j = 0; j < LIMBS; j++) {
+            c += (uint128_t)a[j] * b[i] + t[j];
+            t[j] = (uint64_t)c;
+            c >>= 64;
+        }
+        c += t[LIMBS];
+        t[LIMBS] = (uint64_t)c;
+        t[LIMBS + 1] = (uint64_t)(c >> 64);
+
+        uint64_t q = t[0] * ctx->m_inv;
+        c = (uint128_t)q * ctx->m[0] + t[0];
+        c >>= 64;
+        for (size_t j = 1; j < LIMBS; j++) {
+            c += (uint128_t)q * ctx->m[j] + t[j];
+            t[j - 1] = (uint64_t)c;
+            c >>= 64;
+        }
+        c += t[LIMBS];
+        t[LIMBS - 1] = (uint64_t)c;
+        t[LIMBS] = t[LIMBS + 1] + (uint64_t)(c >> 64);
+    }
+
+    if (t[LIMBS] || geq(t, ctx->m)) {
+        sub(r, t, ctx->m);
+    }
+    else {
+        memcpy(r, t, LIMBS*sizeof(uint64_t));
+    }
+}
+
+static const mont_ctx_t *mont_ctx(const unsigned char *m, unsigned int len)
+{
+    uint64_t modulus[LIMBS];
+    from_bytes(modulus, m, len);
+
+    for (size_t i = 0; i < _cache_len; i++) {
+        if (memcmp(_cache[i].m, modulus, sizeof(modulus)) == 0) {
+            return &_cache[i];
+        }
+    }
+
+    if ((modulus[0] & 1) == 0) {
+        // Montgomery form needs an odd modulus
+        THROW(INVALID_PARAMETER);
+    }
+
+    mont_ctx_t *ctx = &_cache[_cache_next];
+    _cache_next = (_cache_next + 1) % CACHE_SIZE;
+    if (_cache_len < CACHE_SIZE) {
+        _cache_len++;
+    }
+    memcpy(ctx->m, modulus, sizeof(modulus));
+
+    // Newton iteration for m^-1 mod 2^64
+    uint64_t inv = 1;
+    for (size_t i = 0; i < 6; i++) {
+        inv *= 2 - modulus[0] * inv;
+    }
+    ctx->m_inv = -inv;
+
+    // R^2 mod m by doubling 1 a total of 512 times
+    uint64_t r2[LIMBS] = { 1, 0, 0, 0 };
+    reduce(r2, modulus);
+    for (size_t i = 0; i < 2*LIMBS*64; i++) {
+        mod_add(r2, r2, r2, modulus);
+    }
+    memcpy(ctx->r2, r2, sizeof(r2));
+
+    return ctx;
+}
+
+void cx_math_addm(unsigned char *r, const unsigned char *a, const unsigned char *b,
+                  const unsigned char *m, unsigned int len)
+{
+    uint64_t x[LIMBS], y[LIMBS], n[LIMBS];
+
+    from_bytes(x, a, len);
+    from_bytes(y, b, len);
+    from_bytes(n, m, len);
+    reduce(x, n);
+    reduce(y, n);
+    mod_add(x, x, y, n);
+    to_bytes(r, x, len);
+}
+
+void cx_math_subm(unsigned char *r, const unsigned char *a, const unsigned char *b,
+                  const unsigned char *m, unsigned int len)
+{
+    uint64_t x[LIMBS], y[LIMBS], n[LIMBS];
+
+    from_bytes(x, a, len);
+    from_bytes(y, b, len);
+    from_bytes(n, m, len);
+    reduce(x, n);
+    reduce(y, n);
+    if (sub(x, x, y)) {
+        add(x, x, n);
+    }
+    to_bytes(r, x, len);
+}
+
+void cx_math_multm(unsigned char *r, const unsigned char *a, const unsigned char *b,
+                   const unsigned char *m, unsigned int len)
+{
+    const mont_ctx_t *ctx = mont_ctx(m, len);
+    uint64_t x[LIMBS], y[LIMBS];
+
+    from_bytes(x, a, len);
+    from_bytes(y, b, len);
+    mont_mul(x, x, y, ctx);       // a*b*R^-1
+    mont_mul(x, x, ctx->r2, ctx); // a*b
+    to_bytes(r, x, len);
+}
+
+void cx_math_powm(unsigned char *r, const unsigned char *a, const unsigned char *e,
+                  unsigned int len_e, const unsigned char *m, unsigned int len)
+{
+    const mont_ctx_t *ctx = mont_ctx(m, len);
+    static const uint64_t ONE[LIMBS] = { 1, 0, 0, 0 };
+    uint64_t base[LIMBS], acc[LIMBS];
+
+    from_bytes(base, a, len);
+    mont_mul(base, base, ctx->r2, ctx); // a*R
+    mont_mul(acc, ONE, ctx->r2, ctx);   // R
+
+    // Leading zero bits of the exponent are skipped, as exponents are
+    // often small (e.g. the Poseidon S-box x^5)
+    bool started = false;
+    for (unsigned int i = 0; i < len_e; i++) {
+        for (int bit = 7; bit >= 0; bit--) {
+            if (started) {
+                mont_mul(acc, acc, acc, ctx);
+            }
+            if ((e[i] >> bit) & 1) {
+                mont_mul(acc, acc, base, ctx);
+                started = true;
+            }
+        }
+    }
+
+    mont_mul(acc, acc, ONE, ctx);
+    to_bytes(r, acc, len);
+}
+
+void cx_math_invprimem(unsigned char *r, const unsigned char *a,
+                       const unsigned char *m, unsigned int len)
+{
+    // Fermat: a^(m - 2) mod m
+    uint64_t e[LIMBS];
+    static const uint64_t TWO[LIMBS] = { 2, 0, 0, 0 };
+    unsigned char exponent[LIMBS*8];
+
+    from_bytes(e, m, len);
+    sub(e, e, TWO);
+    to_bytes(exponent, e, sizeof(exponent));
+    cx_math_powm(r, a, exponent, sizeof(exponent), m, len);
+}
+
+const cx_mont_ctx_t *cx_mont_ctx(const unsigned char *m, unsigned int len)
+{
+    return mont_ctx(m, len);
+}
+
+void cx_mont_from_bytes(cx_mont_t r, const unsigned char *a, unsigned int len,
+                        const cx_mont_ctx_t *ctx)
+{
+    from_bytes(r, a, len);
+    reduce(r, ctx->m);
+    mont_mul(r, r, ctx->r2, ctx); // a*R
+}
+
+void cx_mont_to_bytes(unsigned char *r, unsigned int len, const cx_mont_t a,
+                      const cx_mont_ctx_t *ctx)
+{
+    static const uint64_t ONE[LIMBS] = { 1, 0, 0, 0 };
+    uint64_t x[LIMBS];
+
+    mont_mul(x, a, ONE, ctx);     // a*R*R^-1
+    to_bytes(r, x, len);
+}
+
+void cx_mont_add(cx_mont_t r, const cx_mont_t a, const cx_mont_t b,
+                 const cx_mont_ctx_t *ctx)
+{
+    mod_add(r, a, b, ctx->m);
+}
+
+void cx_mont_mul(cx_mont_t r, const cx_mont_t a, const cx_mont_t b,
+                 const cx_mont_ctx_t *ctx)
+{
+    mont_mul(r, a, b, ctx);
+}
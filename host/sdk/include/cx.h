@@ -0,0 +1,82 @@
+// Host stand-in for the BOLOS cx cryptography API
+//
+//     Native SHA-256, SHA-512, BLAKE2b and big-endian modular arithmetic
+//     with the same calling conventions as the SDK.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define CX_LAST (1 << 0)
+
+#define CX_SHA256_SIZE 32
+#define CX_SHA512_SIZE 64
+
+typedef enum {
+    CX_CURVE_NONE = 0,
+    CX_CURVE_256K1 = 0x21
+} cx_curve_t;
+
+typedef enum {
+    CX_NONE = 0,
+    CX_SHA256 = 3,
+    CX_SHA512 = 5,
+    CX_BLAKE2B = 9
+} cx_md_t;
+
+typedef struct cx_hash_header_s {
+    cx_md_t  algo;
+    uint32_t counter;
+} cx_hash_t;
+
+typedef struct cx_sha256_s {
+    cx_hash_t header;
+    uint8_t   block[64];
+    size_t    blen;
+    uint64_t  length;
+    uint32_t  acc[8];
+} cx_sha256_t;
+
+typedef struct cx_sha512_s {
+    cx_hash_t header;
+    uint8_t   block[128];
+    size_t    blen;
+    uint64_t  length;
+    uint64_t  acc[8];
+} cx_sha512_t;
+
+typedef struct cx_blake2b_s {
+    cx_hash_t header;
+    struct {
+        uint64_t h[8];
+        uint64_t t[2];
+        uint8_t  buf[128];
+        size_t   buflen;
+        size_t   outlen;
+    } ctx;
+} cx_blake2b_t;
+
+int cx_sha256_init(cx_sha256_t *hash);
+int cx_sha512_init(cx_sha512_t *hash);
+int cx_blake2b_init(cx_blake2b_t *hash, unsigned int out_len);
+int cx_hash(cx_hash_t *hash, int mode, const unsigned char *in, unsigned int len,
+            unsigned char *out, unsigned int out_len);
+int cx_hash_sha256(const unsigned char *in, unsigned int len,
+                   unsigned char *out, unsigned int out_len);
+int cx_hash_sha512(const unsigned char *in, unsigned int len,
+                   unsigned char *out, unsigned int out_len);
+int cx_hmac_sha512(const unsigned char *key, unsigned int key_len,
+                   const unsigned char *in, unsigned int len,
+                   unsigned char *mac, unsigned int mac_len);
+
+void cx_math_addm(unsigned char *r, const unsigned char *a, const unsigned char *b,
+                  const unsigned char *m, unsigned int len);
+void cx_math_subm(unsigned char *r, const unsigned char *a, const unsigned char *b,
+                  const unsigned char *m, unsigned int len);
+void cx_math_multm(unsigned char *r, const unsigned char *a, const unsigned char *b,
+                   const unsigned char *m, unsigned int len);
+void cx_math_powm(unsigned char *r, const unsigned char *a, const unsigned char *e,
+                  unsigned int len_e, const unsigned char *m, unsigned int len);
+void cx_math_invprimem(unsigned char *r, const unsigned char *a,
+                       const unsigned char *m, unsigned int len);
@@ -0,0 +1,16 @@
+// Host-only multi-message BLAKE2b
+//
+//     Hashes up to CX_BLAKE2B_LANES independent messages at once, one per
+//     64-bit SIMD lane, for batch nonce derivation.  The widest of
+//     AVX-512, AVX2 and SSE2 that the CPU supports is picked at load time.
+//     Not part of the BOLOS SDK.
+
+#pragma once
+
+#define CX_BLAKE2B_LANES 8
+
+// out[i] = BLAKE2b(in[i]) of out_len bytes (1 to 64) for i < count;
+// returns 0 if out_len or count is out of range, else out_len
+int cx_blake2b_multi(unsigned char *const out[], unsigned int out_len,
+                     const unsigned char *const in[], const unsigned int len[],
+                     unsigned int count);
@@ -0,0 +1,33 @@
+// Host-only Montgomery arithmetic
+//
+//     Direct access to the Montgomery domain behind the host cx_math, for
+//     code that keeps its operands in native form between operations
+//     (see utils/gen_poseidon_constants.py).  Not part of the BOLOS SDK.
+//
+//     Elements are four little-endian 64-bit limbs holding a*R mod m,
+//     R = 2^256.  A context stays valid until three other moduli have
+//     been used on the same thread.
+
+#pragma once
+
+#include <stdint.h>
+
+#define CX_MONT_LIMBS 4
+
+typedef uint64_t cx_mont_t[CX_MONT_LIMBS];
+
+typedef struct cx_mont_ctx_s cx_mont_ctx_t;
+
+const cx_mont_ctx_t *cx_mont_ctx(const unsigned char *m, unsigned int len);
+
+// Big-endian a -> a*R mod m, and back
+void cx_mont_from_bytes(cx_mont_t r, const unsigned char *a, unsigned int len,
+                        const cx_mont_ctx_t *ctx);
+void cx_mont_to_bytes(unsigned char *r, unsigned int len, const cx_mont_t a,
+                      const cx_mont_ctx_t *ctx);
+
+// r = a + b and r = a*b in the Montgomery domain
+void cx_mont_add(cx_mont_t r, const cx_mont_t a, const cx_mont_t b,
+                 const cx_mont_ctx_t *ctx);
+void cx_mont_mul(cx_mont_t r, const cx_mont_t a, const cx_mont_t b,
+                 const cx_mont_ctx_t *ctx);
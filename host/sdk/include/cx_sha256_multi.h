@@ -0,0 +1,22 @@
+// Host-only multi-message double SHA-256
+//
+//     Computes SHA-256(SHA-256(m)) of up to CX_SHA256_LANES equal length
+//     short messages at once, for bulk base58 check checksums.  Uses the
+//     SHA extensions when the CPU has them and eight AVX2 lanes (or the
+//     scalar baseline) otherwise.  Not part of the BOLOS SDK.
+
+#pragma once
+
+#define CX_SHA256_LANES          8
+#define CX_SHA256D_MULTI_MAX_LEN 55 // single block messages
+
+// out[i] = SHA-256(SHA-256(in[i])) (CX_SHA256_SIZE bytes) for i < count,
+// every in[i] being len bytes; returns 0 if len or count is out of range,
+// else CX_SHA256_SIZE
+int cx_sha256d_multi(unsigned char *const out[], const unsigned char *const in[],
+                     unsigned int len, unsigned int count);
+
+// Uses the SHA extensions for all SHA-256 hashing if enable is set and
+// the CPU has them (the default), else the portable code; returns whether
+// they are used.  For tests and benchmarks, not thread safe
+int cx_sha256_set_sha_ni(int enable);
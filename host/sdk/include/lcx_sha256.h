@@ -0,0 +1,5 @@
+// Host stand-in for the BOLOS SDK lcx_sha256.h
+
+#pragma once
+
+#include "cx.h"
@@ -0,0 +1,109 @@
+// Host stand-in for the BOLOS SDK os.h
+//
+//     Provides just enough of the SDK for the signer sources in src/ to
+//     build natively: exceptions (setjmp based, with a thread-local
+//     context chain so that worker threads are independent), the cx
+//     cryptography API and a few helper macros.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "cx.h"
+
+#ifndef UNUSED
+    #define UNUSED(x) (void)x
+#endif
+
+#define PIC(x) (x)
+
+// State that the device keeps in static RAM is per thread on the host
+#define THREAD_LOCAL __thread
+
+// Exceptions
+typedef unsigned short exception_t;
+
+#define EXCEPTION          1
+#define INVALID_PARAMETER  2
+#define EXCEPTION_OVERFLOW 3
+#define EXCEPTION_SECURITY 4
+#define INVALID_CRC        5
+#define INVALID_CHECKSUM   6
+#define INVALID_COUNTER    7
+#define NOT_SUPPORTED      8
+#define INVALID_STATE      9
+#define TIMEOUT            10
+#define EXCEPTION_PIC      11
+#define EXCEPTION_APPEXIT  12
+#define EXCEPTION_IO_OVERFLOW 13
+#define EXCEPTION_IO_HEADER   14
+#define EXCEPTION_IO_STATE    15
+#define EXCEPTION_IO_RESET    16
+#define EXCEPTION_CXPORT      17
+#define EXCEPTION_SYSTEM      18
+#define NOT_ENOUGH_SPACE      19
+
+typedef struct try_context_s {
+    jmp_buf                jmp_buf;
+    struct try_context_s  *previous;
+    exception_t            ex;
+} try_context_t;
+
+try_context_t *try_context_get(void);
+try_context_t *try_context_set(try_context_t *context);
+void os_longjmp(unsigned int exception) __attribute__((noreturn));
+
+#define BEGIN_TRY { \
+    try_context_t __try;
+
+#define TRY \
+    __try.previous = try_context_set(&__try); \
+    __try.ex = setjmp(__try.jmp_buf); \
+    if (__try.ex == 0) {
+
+#define CATCH(x) \
+        goto __FINALLY; \
+    } \
+    else if (__try.ex == (x)) { \
+        __try.ex = 0; \
+        try_context_set(__try.previous);
+
+#define CATCH_OTHER(e) \
+        goto __FINALLY; \
+    } \
+    else { \
+        exception_t e = __try.ex; \
+        UNUSED(e); \
+        __try.ex = 0; \
+        try_context_set(__try.previous);
+
+#define CATCH_ALL CATCH_OTHER(__e)
+
+#define FINALLY \
+        goto __FINALLY; \
+    } \
+    __FINALLY: \
+    if (try_context_get() == &__try) { \
+        try_context_set(__try.previous); \
+    }
+
+#define END_TRY \
+    if (__try.ex != 0) { \
+        THROW(__try.ex); \
+    } \
+}
+
+#define THROW(x) os_longjmp(x)
+
+// Key derivation (see bip32.c)
+void os_perso_derive_node_bip32(cx_curve_t curve, const uint32_t *path,
+                                unsigned int pathLength, unsigned char *privateKey,
+                                unsigned char *chain);
+
+// Host only: the seed os_perso_derive_node_bip32() derives from
+void host_set_seed(const uint8_t *seed, size_t len);
+void host_set_mnemonic(const char *mnemonic, const char *passphrase);
@@ -0,0 +1,11 @@
+// Host stand-in for the BOLOS SDK os_io_seproxyhal.h (no I/O on the host)
+
+#pragma once
+
+#include "os.h"
+
+// APDU buffer, so that command handlers that format their response in
+// place can run on the host
+#define IO_APDU_BUFFER_SIZE 260
+
+extern unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
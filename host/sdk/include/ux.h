@@ -0,0 +1,7 @@
+// Host stand-in for the BOLOS SDK ux.h (no user interface on the host)
+
+#pragma once
+
+typedef struct ux_state_s {
+    unsigned char unused;
+} ux_state_t;
@@ -0,0 +1,32 @@
+// Host stand-in for the BOLOS exception context and APDU buffer
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "os.h"
+#include "os_io_seproxyhal.h"
+
+unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static __thread try_context_t *_try_context = NULL;
+
+try_context_t *try_context_get(void)
+{
+    return _try_context;
+}
+
+try_context_t *try_context_set(try_context_t *context)
+{
+    try_context_t *previous = _try_context;
+    _try_context = context;
+    return previous;
+}
+
+void os_longjmp(unsigned int exception)
+{
+    if (_try_context == NULL) {
+        fprintf(stderr, "Uncaught exception 0x%04x\n", exception);
+        abort();
+    }
+    longjmp(_try_context->jmp_buf, exception);
+}
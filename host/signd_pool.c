@@ -0,0 +1,268 @@
+// Work-stealing thread pool for the batch signing service
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "signd_pool.h"
+
+#define DEQUE_SIZE 1024 // ranges per worker, must be a power of two
+
+typedef struct {
+    signd_task_fn   fn;
+    void           *ctx;
+    size_t          remaining; // protected by lock
+    pthread_mutex_t lock;
+    pthread_cond_t  done;
+} job_t;
+
+typedef struct {
+    job_t *job;
+    size_t begin;
+    size_t end;
+} task_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t          head; // steal end
+    size_t          tail; // owner end
+    task_t          tasks[DEQUE_SIZE];
+} deque_t;
+
+struct signd_pool_t {
+    size_t          threads;
+    pthread_t      *tids;
+    deque_t        *deques;
+    atomic_size_t   next;    // round-robin submission
+    pthread_mutex_t lock;
+    pthread_cond_t  work;
+    size_t          pending; // queued ranges, protected by lock
+    bool            stop;
+};
+
+static bool deque_push(deque_t *d, const task_t *t)
+{
+    bool ok = false;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->tail - d->head < DEQUE_SIZE) {
+        d->tasks[d->tail++ & (DEQUE_SIZE - 1)] = *t;
+        ok = true;
+    }
+    pthread_mutex_unlock(&d->lock);
+
+    return ok;
+}
+
+static bool deque_pop(deque_t *d, task_t *t)
+{
+    bool ok = false;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->tail != d->head) {
+        *t = d->tasks[--d->tail & (DEQUE_SIZE - 1)];
+        ok = true;
+    }
+    pthread_mutex_unlock(&d->lock);
+
+    return ok;
+}
+
+static bool deque_steal(deque_t *d, task_t *t)
+{
+    bool ok = false;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->tail != d->head) {
+        *t = d->tasks[d->head++ & (DEQUE_SIZE - 1)];
+        ok = true;
+    }
+    pthread_mutex_unlock(&d->lock);
+
+    return ok;
+}
+
+static void task_run(const task_t *t)
+{
+    job_t *job = t->job;
+
+    job->fn(job->ctx, t->begin, t->end);
+
+    pthread_mutex_lock(&job->lock);
+    if (--job->remaining == 0) {
+        pthread_cond_signal(&job->done);
+    }
+    pthread_mutex_unlock(&job->lock);
+}
+
+static bool pool_take(signd_pool_t *pool, size_t self, task_t *t)
+{
+    if (deque_pop(&pool->deques[self], t)) {
+        return true;
+    }
+    for (size_t i = 1; i < pool->threads; i++) {
+        if (deque_steal(&pool->deques[(self + i) % pool->threads], t)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+typedef struct {
+    signd_pool_t *pool;
+    size_t        self;
+} worker_arg_t;
+
+static void *worker(void *arg)
+{
+    signd_pool_t *pool = ((worker_arg_t *)arg)->pool;
+    size_t self = ((worker_arg_t *)arg)->self;
+    task_t t;
+
+    free(arg);
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->pending == 0 && !pool->stop) {
+            pthread_cond_wait(&pool->work, &pool->lock);
+        }
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        // Drain own deque, then steal
+        while (pool_take(pool, self, &t)) {
+            pthread_mutex_lock(&pool->lock);
+            pool->pending--;
+            pthread_mutex_unlock(&pool->lock);
+            task_run(&t);
+        }
+    }
+}
+
+signd_pool_t *signd_pool_create(size_t threads)
+{
+    signd_pool_t *pool = calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->threads = threads ? threads : 1;
+    pool->tids = calloc(pool->threads, sizeof(*pool->tids));
+    pool->deques = calloc(pool->threads, sizeof(*pool->deques));
+    if (!pool->tids || !pool->deques) {
+        free(pool->tids);
+        free(pool->deques);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    for (size_t i = 0; i < pool->threads; i++) {
+        pthread_mutex_init(&pool->deques[i].lock, NULL);
+    }
+
+    for (size_t i = 0; i < pool->threads; i++) {
+        worker_arg_t *arg = malloc(sizeof(*arg));
+        if (!arg) {
+            pool->threads = i;
+            break;
+        }
+        arg->pool = pool;
+        arg->self = i;
+        if (pthread_create(&pool->tids[i], NULL, worker, arg) != 0) {
+            free(arg);
+            pool->threads = i;
+            break;
+        }
+    }
+    if (pool->threads == 0) {
+        signd_pool_destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void signd_pool_destroy(signd_pool_t *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->threads; i++) {
+        pthread_join(pool->tids[i], NULL);
+    }
+
+    free(pool->tids);
+    free(pool->deques);
+    free(pool);
+}
+
+size_t signd_pool_threads(const signd_pool_t *pool)
+{
+    return pool->threads;
+}
+
+void signd_pool_run(signd_pool_t *pool, signd_task_fn fn, void *ctx,
+                    size_t count, size_t grain)
+{
+    job_t job = { .fn = fn, .ctx = ctx };
+
+    if (count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.done, NULL);
+    job.remaining = (count + grain - 1) / grain;
+
+    for (size_t begin = 0; begin < count; begin += grain) {
+        task_t t = {
+            .job = &job,
+            .begin = begin,
+            .end = begin + grain < count ? begin + grain : count
+        };
+
+        // Count the range before it becomes visible so that a worker
+        // never takes a range that is not yet pending
+        pthread_mutex_lock(&pool->lock);
+        pool->pending++;
+        pthread_mutex_unlock(&pool->lock);
+
+        size_t d = atomic_fetch_add(&pool->next, 1) % pool->threads;
+        if (deque_push(&pool->deques[d], &t)) {
+            pthread_mutex_lock(&pool->lock);
+            pthread_cond_signal(&pool->work);
+            pthread_mutex_unlock(&pool->lock);
+        }
+        else {
+            // Deque full, run on the submitting thread
+            pthread_mutex_lock(&pool->lock);
+            pool->pending--;
+            pthread_mutex_unlock(&pool->lock);
+            task_run(&t);
+        }
+    }
+
+    pthread_mutex_lock(&job.lock);
+    while (job.remaining != 0) {
+        pthread_cond_wait(&job.done, &job.lock);
+    }
+    pthread_mutex_unlock(&job.lock);
+
+    pthread_mutex_destroy(&job.lock);
+    pthread_cond_destroy(&job.done);
+}
@@ -0,0 +1,23 @@
+// Work-stealing thread pool for the batch signing service
+//
+//     Each worker owns a deque of index ranges.  Submitted work is spread
+//     over the deques; workers pop from the back of their own deque and,
+//     when it is empty, steal from the front of the others.  Several
+//     threads may submit concurrently.
+
+#pragma once
+
+#include <stddef.h>
+
+typedef void (*signd_task_fn)(void *ctx, size_t begin, size_t end);
+
+typedef struct signd_pool_t signd_pool_t;
+
+signd_pool_t *signd_pool_create(size_t threads);
+void signd_pool_destroy(signd_pool_t *pool);
+size_t signd_pool_threads(const signd_pool_t *pool);
+
+// Runs fn over [0, count) in ranges of at most grain indices and
+// returns once every range has completed
+void signd_pool_run(signd_pool_t *pool, signd_task_fn fn, void *ctx,
+                    size_t count, size_t grain);
@@ -0,0 +1,395 @@
+#include <string.h>
+
+#include "benchmark.h"
+#include "crypto.h"
+#include "curve_checks.h"
+#include "poseidon.h"
+#include "random_oracle_input.h"
+#include "transaction.h"
+#include "utils.h"
+
+#ifdef HAVE_BENCHMARKS
+    #include "globals.h"
+#endif
+
+#define ADDRESS_PAYLOAD_LEN 40
+
+// Case names, fixed size so that the table holds no pointers
+static const char BENCH_NAMES[BENCH_COUNT][BENCH_NAME_LEN] = {
+    "nop",
+    "field_mul",
+    "field_inv",
+    "field_pow",
+    "group_dbl",
+    "group_add",
+    "group_scalar_mul",
+    "poseidon_permutation",
+    "message_derive",
+    "message_hash",
+    "sign",
+    "b58_encode",
+    "b58_decode",
+    "generate_keypair",
+    "curve_checks",
+    "projective_dbl",
+    "projective_add",
+    "projective_scalar_mul",
+    "generate_pubkey",
+    "pubkey_complete",
+    "verify_jacobian",
+    "verify_complete",
+    "affine_scalar_mul",
+};
+
+// Account 0 of the test mnemonic
+static const Keypair BENCH_KEYPAIR = {
+    {
+        {
+            0x1c, 0x4a, 0x1a, 0x3e, 0x8b, 0xa7, 0x19, 0xae,
+            0xc0, 0xeb, 0xd0, 0xb0, 0x9c, 0x7a, 0x8c, 0xd0,
+            0x25, 0x8b, 0x4e, 0xb1, 0x93, 0xde, 0x53, 0x15,
+            0x42, 0x88, 0xa6, 0x3c, 0x29, 0xc2, 0x6f, 0x87
+        },
+        {
+            0x23, 0x75, 0x31, 0x2d, 0x68, 0xe2, 0x0f, 0x6e,
+            0x64, 0x10, 0x5b, 0x5c, 0xfe, 0x63, 0x36, 0xba,
+            0x6a, 0xae, 0x1f, 0x33, 0x33, 0xe9, 0x03, 0x94,
+            0x11, 0x76, 0x9f, 0xcb, 0xb1, 0x1b, 0x13, 0xe9
+        }
+    },
+    {
+        0x16, 0x42, 0x44, 0x17, 0x6f, 0xdd, 0xb5, 0xd7,
+        0x69, 0xb7, 0xde, 0x20, 0x27, 0x46, 0x9d, 0x02,
+        0x7a, 0xd4, 0x28, 0xfa, 0xdc, 0xc0, 0xc0, 0x23,
+        0x96, 0xe6, 0x28, 0x01, 0x42, 0xef, 0xb7, 0x18
+    }
+};
+
+static const char BENCH_ADDRESS[MINA_ADDRESS_LEN] =
+    "B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uzV";
+
+const char *bench_name(const uint8_t id)
+{
+    if (id >= BENCH_COUNT) {
+        return NULL;
+    }
+    return BENCH_NAMES[id];
+}
+
+static uint32_t checksum(const uint8_t *bytes, const size_t len)
+{
+    return (uint32_t)bytes[len - 4] << 24 | (uint32_t)bytes[len - 3] << 16
+         | (uint32_t)bytes[len - 2] << 8 | bytes[len - 1];
+}
+
+static uint32_t bench_field(const uint8_t id, const uint32_t iterations)
+{
+    const Keypair *kp = &BENCH_KEYPAIR;
+    Field a, t;
+
+    field_copy(a, kp->pub.x);
+    for (uint32_t i = 0; i < iterations; i++) {
+        switch (id) {
+            case BENCH_FIELD_MUL:
+                field_mul(t, a, kp->pub.y);
+                break;
+            case BENCH_FIELD_INV:
+                field_inv(t, a);
+                break;
+            default:
+                field_pow(t, a, kp->priv);
+                break;
+        }
+        field_copy(a, t);
+    }
+
+    return checksum(a, sizeof(a));
+}
+
+static uint32_t bench_group(const uint8_t id, const uint32_t iterations)
+{
+    const Keypair *kp = &BENCH_KEYPAIR;
+    Group p, q, t;
+
+    affine_to_group(&q, &kp->pub);
+    group_dbl(&p, &q);
+    for (uint32_t i = 0; i < iterations; i++) {
+        switch (id) {
+            case BENCH_GROUP_DBL:
+                group_dbl(&t, &p);
+                break;
+            case BENCH_GROUP_ADD:
+                group_add(&t, &p, &q);
+                break;
+            default:
+                group_scalar_mul(&t, kp->priv, &p);
+                break;
+        }
+        group_copy(&p, &t);
+    }
+
+    return checksum(p.X, sizeof(p.X));
+}
+
+static uint32_t bench_projective(const uint8_t id, const uint32_t iterations)
+{
+    const Keypair *kp = &BENCH_KEYPAIR;
+    Projective p, q, t;
+
+    affine_to_projective(&q, &kp->pub);
+    projective_dbl(&p, &q);
+    for (uint32_t i = 0; i < iterations; i++) {
+        switch (id) {
+            case BENCH_PROJECTIVE_DBL:
+                projective_dbl(&t, &p);
+                break;
+            case BENCH_PROJECTIVE_ADD:
+                projective_add(&t, &p, &q);
+                break;
+            default:
+                projective_scalar_mul(&t, kp->priv, &p);
+                break;
+        }
+        memcpy(&p, &t, sizeof(p));
+    }
+
+    return checksum(p.X, sizeof(p.X));
+}
+
+static uint32_t bench_poseidon(const uint32_t iterations)
+{
+    State s;
+
+    poseidon_init(s, TESTNET_ID);
+    for (uint32_t i = 0; i < iterations; i++) {
+        poseidon_permutation(s);
+    }
+
+    return checksum(s[0], sizeof(s[0]));
+}
+
+// Inputs shaped like a payment: three fields and the transaction bitstrings
+static uint32_t bench_message(const uint8_t id, const uint32_t iterations)
+{
+    const Keypair *kp = &BENCH_KEYPAIR;
+    Field fields[3];
+    uint8_t bits[TX_BITSTRINGS_BYTES];
+    ROInput input = roinput_create(fields, bits);
+    uint8_t bitstrings[TX_BITSTRINGS_BYTES - 1];
+    uint32_t sum = 0;
+
+    roinput_add_field(&input, kp->pub.x);
+    roinput_add_field(&input, kp->pub.y);
+    roinput_add_field(&input, kp->pub.x);
+    for (size_t i = 0; i < sizeof(bitstrings); i++) {
+        bitstrings[i] = i * 37;
+    }
+    roinput_add_bytes(&input, bitstrings, sizeof(bitstrings));
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        Scalar out;
+        Signature sig;
+        switch (id) {
+            case BENCH_MESSAGE_DERIVE:
+                if (!message_derive(out, kp, &input, TESTNET_ID)) {
+                    THROW(INVALID_PARAMETER);
+                }
+                break;
+            case BENCH_MESSAGE_HASH:
+                if (!message_hash(out, &kp->pub, kp->pub.x, &input, TESTNET_ID)) {
+                    THROW(INVALID_PARAMETER);
+                }
+                break;
+            default:
+                if (!sign(&sig, kp, &input, TESTNET_ID)) {
+                    THROW(INVALID_PARAMETER);
+                }
+                memcpy(out, sig.s, sizeof(out));
+                break;
+        }
+        sum += checksum(out, sizeof(out));
+    }
+
+    return sum;
+}
+
+static uint32_t bench_b58(const uint8_t id, const uint32_t iterations)
+{
+    uint8_t payload[ADDRESS_PAYLOAD_LEN];
+    char address[MINA_ADDRESS_LEN];
+    size_t len = sizeof(payload);
+    uint32_t sum = 0;
+
+    if (!b58_decode(payload, &len, BENCH_ADDRESS, MINA_ADDRESS_LEN - 1)) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (id == BENCH_B58_ENCODE) {
+            if (b58_encode(payload, sizeof(payload), (unsigned char *)address,
+                           sizeof(address)) < 0) {
+                THROW(INVALID_PARAMETER);
+            }
+            sum += address[MINA_ADDRESS_LEN - 2];
+        }
+        else {
+            len = sizeof(payload);
+            if (!b58_decode(payload, &len, BENCH_ADDRESS, MINA_ADDRESS_LEN - 1)) {
+                THROW(INVALID_PARAMETER);
+            }
+            sum += payload[len - 1];
+        }
+    }
+
+    return sum;
+}
+
+static uint32_t bench_keys(const uint8_t id, const uint32_t iterations)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (id == BENCH_GENERATE_KEYPAIR) {
+            Keypair kp;
+            generate_keypair(&kp, 0);
+            explicit_bzero(kp.priv, sizeof(kp.priv));
+            sum += checksum(kp.pub.x, sizeof(kp.pub.x));
+        }
+        else {
+            if (!curve_checks()) {
+                THROW(INVALID_PARAMETER);
+            }
+            sum++;
+        }
+    }
+
+    return sum;
+}
+
+// Default vs complete formulas on whole operations
+static uint32_t bench_compare(const uint8_t id, const uint32_t iterations)
+{
+    const Keypair *kp = &BENCH_KEYPAIR;
+    Field fields[1];
+    uint8_t bits[1];
+    ROInput input = roinput_create(fields, bits);
+    Signature sig;
+    Affine pub;
+    uint32_t sum = 0;
+
+    roinput_add_field(&input, kp->pub.x);
+    memcpy(&pub, &kp->pub, sizeof(pub));
+    if (id == BENCH_VERIFY_JACOBIAN || id == BENCH_VERIFY_COMPLETE) {
+        if (!sign(&sig, kp, &input, TESTNET_ID)) {
+            THROW(INVALID_PARAMETER);
+        }
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        switch (id) {
+            case BENCH_GENERATE_PUBKEY:
+                generate_pubkey(&pub, kp->priv);
+                sum += checksum(pub.x, sizeof(pub.x));
+                break;
+            case BENCH_PUBKEY_COMPLETE:
+                generate_pubkey_complete(&pub, kp->priv);
+                sum += checksum(pub.x, sizeof(pub.x));
+                break;
+            case BENCH_AFFINE_SCALAR_MUL:
+                affine_scalar_mul(&pub, kp->priv, &pub);
+                sum += checksum(pub.x, sizeof(pub.x));
+                break;
+            case BENCH_VERIFY_JACOBIAN:
+                if (!verify(&sig, &kp->pub, &input, TESTNET_ID)) {
+                    THROW(INVALID_PARAMETER);
+                }
+                sum++;
+                break;
+            default:
+                if (!verify_complete(&sig, &kp->pub, &input, TESTNET_ID)) {
+                    THROW(INVALID_PARAMETER);
+                }
+                sum++;
+                break;
+        }
+    }
+
+    return sum;
+}
+
+uint32_t bench_run(const uint8_t id, const uint32_t iterations)
+{
+    switch (id) {
+        case BENCH_NOP:
+            return iterations;
+
+        case BENCH_FIELD_MUL:
+        case BENCH_FIELD_INV:
+        case BENCH_FIELD_POW:
+            return bench_field(id, iterations);
+
+        case BENCH_GROUP_DBL:
+        case BENCH_GROUP_ADD:
+        case BENCH_GROUP_SCALAR_MUL:
+            return bench_group(id, iterations);
+
+        case BENCH_POSEIDON_PERMUTATION:
+            return bench_poseidon(iterations);
+
+        case BENCH_MESSAGE_DERIVE:
+        case BENCH_MESSAGE_HASH:
+        case BENCH_SIGN:
+            return bench_message(id, iterations);
+
+        case BENCH_B58_ENCODE:
+        case BENCH_B58_DECODE:
+            return bench_b58(id, iterations);
+
+        case BENCH_GENERATE_KEYPAIR:
+        case BENCH_CURVE_CHECKS:
+            return bench_keys(id, iterations);
+
+        case BENCH_PROJECTIVE_DBL:
+        case BENCH_PROJECTIVE_ADD:
+        case BENCH_PROJECTIVE_SCALAR_MUL:
+            return bench_projective(id, iterations);
+
+        case BENCH_GENERATE_PUBKEY:
+        case BENCH_PUBKEY_COMPLETE:
+        case BENCH_VERIFY_JACOBIAN:
+        case BENCH_VERIFY_COMPLETE:
+        case BENCH_AFFINE_SCALAR_MUL:
+            return bench_compare(id, iterations);
+
+        default:
+            THROW(INVALID_PARAMETER);
+    }
+    return 0;
+}
+
+#ifdef HAVE_BENCHMARKS
+
+// p1 = case id, data = iterations (uint32 BE)
+// Response: checksum (uint32 BE) | case name (null-terminated)
+uint8_t handle_benchmark(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                         uint8_t dataLength)
+{
+    UNUSED(p2);
+
+    if (p1 >= BENCH_COUNT || dataLength != sizeof(uint32_t)) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    uint32_t sum = bench_run(p1, read_uint32_be(dataBuffer));
+
+    uint8_t tx = 0;
+    G_io_apdu_buffer[tx++] = sum >> 24;
+    G_io_apdu_buffer[tx++] = sum >> 16;
+    G_io_apdu_buffer[tx++] = sum >> 8;
+    G_io_apdu_buffer[tx++] = sum;
+    memmove(G_io_apdu_buffer + tx, BENCH_NAMES[p1], BENCH_NAME_LEN);
+    tx += BENCH_NAME_LEN;
+    return tx;
+}
+
+#endif
@@ -0,0 +1,51 @@
+// Crypto micro-benchmarks
+//
+//     Benchmark cases shared by the host benchmark (tests/crypto_bench.c)
+//     and the device INS_BENCHMARK handler (HAVE_BENCHMARKS).  Each case
+//     repeats one operation on fixed inputs, feeding every result back
+//     into the next iteration so that the work cannot be elided, and
+//     returns a checksum of the final result.
+
+#pragma once
+
+#include <stdint.h>
+
+typedef enum {
+    BENCH_NOP = 0,             // APDU and loop overhead baseline
+    BENCH_FIELD_MUL,
+    BENCH_FIELD_INV,
+    BENCH_FIELD_POW,
+    BENCH_GROUP_DBL,
+    BENCH_GROUP_ADD,
+    BENCH_GROUP_SCALAR_MUL,
+    BENCH_POSEIDON_PERMUTATION,
+    BENCH_MESSAGE_DERIVE,
+    BENCH_MESSAGE_HASH,
+    BENCH_SIGN,
+    BENCH_B58_ENCODE,
+    BENCH_B58_DECODE,
+    BENCH_GENERATE_KEYPAIR,    // account 0, needs the seed
+    BENCH_CURVE_CHECKS,
+    BENCH_PROJECTIVE_DBL,      // complete formulas
+    BENCH_PROJECTIVE_ADD,
+    BENCH_PROJECTIVE_SCALAR_MUL,
+    BENCH_GENERATE_PUBKEY,     // generate_pubkey of a fixed key (co-Z ladder)
+    BENCH_PUBKEY_COMPLETE,
+    BENCH_VERIFY_JACOBIAN,     // verify of a fixed signature
+    BENCH_VERIFY_COMPLETE,
+    BENCH_AFFINE_SCALAR_MUL,   // co-Z ladder, vs group_scalar_mul
+    BENCH_COUNT
+} bench_id_t;
+
+#define BENCH_NAME_LEN 24 // includes null-byte
+
+// Returns the case name or NULL if id is out of range
+const char *bench_name(const uint8_t id);
+
+// Runs case id for iterations and returns the result checksum
+uint32_t bench_run(const uint8_t id, const uint32_t iterations);
+
+#ifdef HAVE_BENCHMARKS
+uint8_t handle_benchmark(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                         uint8_t dataLength);
+#endif
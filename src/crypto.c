@@ -22,6 +22,8 @@
 #include "utils.h"
 #include "globals.h"
 #include "random_oracle_input.h"
+#include "stats.h"
+#include "op_counters.h"
 
 // Base field Fp
 static const Field FIELD_MODULUS = {
@@ -47,6 +49,14 @@ static const Field GROUP_COEFF_B = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05
 };
 
+// 3*b for the complete formulas
+static const Field GROUP_COEFF_B3 = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f
+};
+
 static const Field FIELD_ZERO = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -134,6 +144,91 @@ static const Affine AFFINE_ONE = {
     }
 };
 
+// Scratch arena
+//
+//     The temporaries of the point arithmetic and of the signing stages
+//     live in one statically allocated arena instead of on the stack, so
+//     that the peak stack of sign_step() and generate_keypair() is no
+//     longer the sum of every nested frame.
+//
+//     point and ladder are used by the leaf point routines and by the
+//     double-and-add loop, which never nest, from any stage.  The stage
+//     workspaces share a union: a stage owns it from scratch_begin() until
+//     scratch_end(), which zeroizes the whole arena.  Nonce derivation does
+//     no point arithmetic, so its workspace overlays the point temporaries
+//     too and the arena is as large as the largest curve stage (hash).  Every owner calls
+//     scratch_end() in a FINALLY so that an exception cannot leave the
+//     arena owned or holding key material.  The complete formulas
+//     (projective_*) are not on the signing path and own no stage, so
+//     they keep their temporaries on the stack and wipe them on return.
+//     The host library signs on several threads, so there the arena is
+//     per thread.
+#ifndef THREAD_LOCAL
+    #define THREAD_LOCAL
+#endif
+
+#define SCRATCH_POINT_FIELDS 9 // group_add
+#define HASH_MSG_FIELDS      9
+
+typedef enum {
+    SCRATCH_NONE = 0,
+    SCRATCH_KEYPAIR,    // affine wrappers (generate_pubkey, co-Z ladder)
+    SCRATCH_DERIVE,     // message_derive
+    SCRATCH_SCALAR_MUL, // sign_step r = k*g, pubkey_step
+    SCRATCH_HASH        // message_hash, s = k + e*sk
+} scratch_stage_t;
+
+_Static_assert(sizeof(((SignCtx *)0)->sponge) == sizeof(State), "sign sponge layout");
+
+typedef struct scratch_t {
+    uint8_t stage;
+    union {
+        struct {
+            Field point[SCRATCH_POINT_FIELDS];
+            Group ladder;
+            union {
+                struct {
+                    Group p, q, r;
+                } keypair;
+                struct {
+                    Field  X[2];
+                    Field  Y[2];
+                    Scalar k;
+                } coz;
+                struct {
+                    Group g;
+                } scalar_mul;
+                struct {
+                    Field  msg[HASH_MSG_FIELDS];
+                    State  pos;
+                    Affine r;
+                    Scalar tmp;
+                } hash;
+            } u;
+        } curve;
+        // message_derive does no point arithmetic
+        struct {
+            uint8_t      msg[DERIVE_MSG_LEN];
+            cx_blake2b_t blake;
+        } derive;
+    } w;
+} Scratch;
+
+static THREAD_LOCAL Scratch _scratch;
+
+static void scratch_begin(const scratch_stage_t stage)
+{
+    if (_scratch.stage != SCRATCH_NONE) {
+        THROW(INVALID_STATE);
+    }
+    _scratch.stage = stage;
+}
+
+static void scratch_end(void)
+{
+    explicit_bzero(&_scratch, sizeof(_scratch));
+}
+
 void field_copy(Field b, const Field a)
 {
     memmove(b, a, FIELD_BYTES);
@@ -141,31 +236,37 @@ void field_copy(Field b, const Field a)
 
 void field_add(Field c, const Field a, const Field b)
 {
+    OP_COUNT(OP_FIELD_ADD);
     cx_math_addm(c, a, b, FIELD_MODULUS, FIELD_BYTES);
 }
 
 void field_sub(Field c, const Field a, const Field b)
 {
+    OP_COUNT(OP_FIELD_SUB);
     cx_math_subm(c, a, b, FIELD_MODULUS, FIELD_BYTES);
 }
 
 void field_mul(Field c, const Field a, const Field b)
 {
+    OP_COUNT(OP_FIELD_MUL);
     cx_math_multm(c, a, b, FIELD_MODULUS, FIELD_BYTES);
 }
 
 void field_sq(Field b, const Field a)
 {
+    OP_COUNT(OP_FIELD_SQ);
     cx_math_multm(b, a, a, FIELD_MODULUS, FIELD_BYTES);
 }
 
 void field_inv(Field c, const Field a)
 {
+    OP_COUNT(OP_FIELD_INV);
     cx_math_invprimem(c, a, FIELD_MODULUS, FIELD_BYTES);
 }
 
 void field_negate(Field c, const Field a)
 {
+    OP_COUNT(OP_FIELD_NEGATE);
     // Ledger API expects inputs to be in range [0, FIELD_MODULUS)
     cx_math_subm(c, FIELD_ZERO, a, FIELD_MODULUS, FIELD_BYTES);
 }
@@ -173,6 +274,7 @@ void field_negate(Field c, const Field a)
 // c = a^e mod m
 void field_pow(Field c, const Field a, const Field e)
 {
+    OP_COUNT(OP_FIELD_POW);
     cx_math_powm(c, a, e, FIELD_BYTES, FIELD_MODULUS, FIELD_BYTES);
 }
 
@@ -219,26 +321,31 @@ void scalar_copy(Scalar b, const Scalar a)
 
 void scalar_add(Scalar c, const Scalar a, const Scalar b)
 {
+    OP_COUNT(OP_SCALAR_ADD);
     cx_math_addm(c, a, b, GROUP_ORDER, SCALAR_BYTES);
 }
 
 void scalar_sub(Scalar c, const Scalar a, const Scalar b)
 {
+    OP_COUNT(OP_SCALAR_SUB);
     cx_math_subm(c, a, b, GROUP_ORDER, SCALAR_BYTES);
 }
 
 void scalar_mul(Scalar c, const Scalar a, const Scalar b)
 {
+    OP_COUNT(OP_SCALAR_MUL);
     cx_math_multm(c, a, b, GROUP_ORDER, SCALAR_BYTES);
 }
 
 void scalar_sq(Scalar b, const Scalar a)
 {
+    OP_COUNT(OP_SCALAR_SQ);
     cx_math_multm(b, a, a, GROUP_ORDER, SCALAR_BYTES);
 }
 
 void scalar_negate(Field b, const Field a)
 {
+    OP_COUNT(OP_SCALAR_NEGATE);
     // Ledger API expects inputs to be in range [0, GROUP_ORDER)
     cx_math_subm(b, SCALAR_ZERO, a, GROUP_ORDER, SCALAR_BYTES);
 }
@@ -246,6 +353,7 @@ void scalar_negate(Field b, const Field a)
 // c = a^e mod m
 void scalar_pow(Scalar c, const Scalar a, const Scalar e)
 {
+    OP_COUNT(OP_SCALAR_POW);
     cx_math_powm(c, a, e, SCALAR_BYTES, GROUP_ORDER, SCALAR_BYTES);
 }
 
@@ -274,30 +382,35 @@ bool group_is_zero(const Group *p)
 // cost 3M + 3S + 24 + 1*a + 4add + 2*2 + 1*3 + 1*4 + 1*8
 void group_dbl(Group *r, const Group *p)
 {
+    OP_COUNT(OP_GROUP_DBL);
+
     if (group_is_zero(p)) {
         group_copy(r, p);
         return;
     }
 
-    Field t0, t1, S;
+    Field *t = _scratch.w.curve.point;
+
+    // Temporaries share the five scratch fields once they are dead
+    uint8_t *t0 = t[0], *t1 = t[1], *S = t[2];
     field_sq(t0, p->Y);              // t0 = Y1^2
     field_mul(t1, p->X, t0);         // t1 = X1*t0
     field_mul(S, FIELD_FOUR, t1);    // S = 4*t1
 
-    Field t2, t3;
+    uint8_t *t2 = t[1], *t3 = t[3];
     field_sq(t2, p->X);              // t2 = X1^2
                                      // t3 = Z1^4
                                      // t4 = a*t3 [a = 0]
     field_mul(t3, FIELD_THREE, t2);  // t3 = 3*t2
 
-    Field t4, t5;
+    uint8_t *t4 = t[1], *t5 = t[4];
                                      // M = t3+t4
     field_sq(t4, t3);                // t4 = M^2
     field_mul(t5, FIELD_TWO, S);     // t5 = 2*S
     field_sub(r->X, t4, t5);         // T = t4-t5
                                      // X3 = T
 
-    Field t6, t7, t8, t9, t10;
+    uint8_t *t6 = t[1], *t7 = t[2], *t8 = t[0], *t9 = t[4], *t10 = t[1];
     field_sub(t6, S, r->X);          // t6 = S-T
     field_sq(t7, t0);                // t7 = Y1^4
     field_mul(t8, FIELD_EIGHT, t7);  // t8 = 8*t7
@@ -311,6 +424,8 @@ void group_dbl(Group *r, const Group *p)
 // cost 10M + 5S + 33 + 6add
 void group_add(Group *r, const Group *p, const Group *q)
 {
+    OP_COUNT(OP_GROUP_ADD);
+
     if (group_is_zero(p)) {
         group_copy(r, q);
         return;
@@ -325,14 +440,16 @@ void group_add(Group *r, const Group *p, const Group *q)
         return group_dbl(r, p);
     }
 
-    Field t0, U1, t1, U2, t2;
+    Field *t = _scratch.w.curve.point;
+
+    uint8_t *t0 = t[0], *U1 = t[1], *t1 = t[2], *U2 = t[3], *t2 = t[4];
     field_sq(t0, q->Z);        // t0 = Z2^2
     field_mul(U1, p->X, t0);   // U1 = X1*t0
     field_sq(t1, p->Z);        // t1 = Z1^2
     field_mul(U2, q->X, t1);   // U2 = X2*t1
     field_mul(t2, t0, q->Z);   // t2 = Z2^3
 
-    Field S1, S2, P, R;
+    uint8_t *S1 = t[5], *S2 = t[6], *P = t[7], *R = t[8];
     field_mul(S1, p->Y, t2);   // S1 = Y1*t2
     field_mul(t0, t1, p->Z);   // t0 = Z1^3
     field_mul(S2, q->Y, t0);   // S2 = Y2*t0
@@ -359,14 +476,39 @@ void group_add(Group *r, const Group *p, const Group *q)
 
 void group_negate(Group *q, const Group *p)
 {
+    OP_COUNT(OP_GROUP_NEGATE);
+
     field_copy(q->X, p->X);
     field_negate(q->Y, p->Y);
     field_copy(q->Z, p->Z);
 }
 
+// Double-and-add over bits [start, end) of k, accumulating into q
+static void group_scalar_mul_bits(Group *q, const Scalar k, const Group *p,
+                                  const size_t start, const size_t end)
+{
+    Group *t0 = &_scratch.w.curve.ladder;
+    for (size_t i = start; i < end; i++) {
+        uint8_t di = (k[i / 8] >> (7 - (i % 8))) & 0x01;
+
+        // q = 2q
+        group_dbl(t0, q);
+        group_copy(q, t0);
+
+        if (di) {
+            // q = q + p
+            group_add(t0, q, p);
+            group_copy(q, t0);
+        }
+    }
+}
+
 // Double-and-add scalar multiplication
 void group_scalar_mul(Group *q, const Scalar k, const Group *p)
 {
+    OP_COUNT(OP_GROUP_SCALAR_MUL);
+    STATS_OP(STATS_SCALAR_MUL);
+
     group_copy(q, &GROUP_ZERO);
     if (group_is_zero(p)) {
         return;
@@ -375,29 +517,18 @@ void group_scalar_mul(Group *q, const Scalar k, const Group *p)
         return;
     }
 
-    Group t0;
-    for (size_t i = 0; i < SCALAR_BITS; i++) {
-        uint8_t di = (k[i / 8] >> (7 - (i % 8))) & 0x01;
-
-        // q = 2q
-        group_dbl(&t0, q);
-        group_copy(q, &t0);
-
-        if (di) {
-            // q = q + p
-            group_add(&t0, q, p);
-            group_copy(q, &t0);
-        }
-    }
+    group_scalar_mul_bits(q, k, p, 0, SCALAR_BITS);
 }
 
 bool group_is_on_curve(const Group *p)
 {
+    OP_COUNT(OP_GROUP_IS_ON_CURVE);
+
     if (group_is_zero(p)) {
         return true;
     }
 
-    Field lhs, rhs;
+    uint8_t *lhs = _scratch.w.curve.point[0], *rhs = _scratch.w.curve.point[1];
     if (field_eq(p->Z, FIELD_ONE)) {
         // we can check y^2 == x^3 + ax + b
         field_sq(lhs, p->Y);                // y^2
@@ -408,7 +539,7 @@ bool group_is_on_curve(const Group *p)
     else {
         // we check (y/z^3)^2 == (x/z^2)^3 + b
         // => y^2 == x^3 + bz^6
-        Field x3, z6;
+        uint8_t *x3 = _scratch.w.curve.point[2], *z6 = _scratch.w.curve.point[3];
         field_sq(x3, p->X);                 // x^2
         field_mul(x3, x3, p->X);            // x^3
         field_sq(lhs, p->Y);                // y^2
@@ -445,13 +576,15 @@ void affine_to_group(Group *q, const Affine *p)
 
 void affine_from_group(Affine *q, const Group *p)
 {
+    OP_COUNT(OP_AFFINE_FROM_GROUP);
+
     if (field_eq(p->Z, FIELD_ZERO)) {
         field_copy(q->x, FIELD_ZERO);
         field_copy(q->y, FIELD_ZERO);
         return;
     }
 
-    Field zi, tmp;
+    uint8_t *zi = _scratch.w.curve.point[0], *tmp = _scratch.w.curve.point[1];
     field_inv(zi, p->Z);         // 1/Z
     field_mul(q->y, zi, zi);     // 1/Z^2
     field_mul(tmp, q->y, zi);    // 1/Z^3
@@ -459,12 +592,336 @@ void affine_from_group(Affine *q, const Group *p)
     field_mul(q->y, p->Y, tmp);  // Y/Z^3
 }
 
+// Complete formulas in homogeneous projective coordinates
+//
+//     Renes, Costello, Batina: Complete addition formulas for prime order
+//     elliptic curves (https://eprint.iacr.org/2015/1060), algorithms 7
+//     and 9 for a = 0.  They hold for every input, including the identity
+//     (0 : 1 : 0) and p = q, so there are no special cases.  The outputs
+//     may alias the inputs.
+
+// cost 12M + 2*b3 + 19add
+void projective_add(Projective *r, const Projective *p, const Projective *q)
+{
+    OP_COUNT(OP_PROJECTIVE_ADD);
+
+    Field t[8];
+    uint8_t *t0 = t[0], *t1 = t[1], *t2 = t[2], *t3 = t[3], *t4 = t[4];
+    uint8_t *X3 = t[5], *Y3 = t[6], *Z3 = t[7];
+
+    field_mul(t0, p->X, q->X);         // t0 = X1*X2
+    field_mul(t1, p->Y, q->Y);         // t1 = Y1*Y2
+    field_mul(t2, p->Z, q->Z);         // t2 = Z1*Z2
+    field_add(t3, p->X, p->Y);         // t3 = X1+Y1
+    field_add(t4, q->X, q->Y);         // t4 = X2+Y2
+    field_mul(t3, t3, t4);             // t3 = t3*t4
+    field_add(t4, t0, t1);             // t4 = t0+t1
+    field_sub(t3, t3, t4);             // t3 = t3-t4
+    field_add(t4, p->Y, p->Z);         // t4 = Y1+Z1
+    field_add(X3, q->Y, q->Z);         // X3 = Y2+Z2
+    field_mul(t4, t4, X3);             // t4 = t4*X3
+    field_add(X3, t1, t2);             // X3 = t1+t2
+    field_sub(t4, t4, X3);             // t4 = t4-X3
+    field_add(X3, p->X, p->Z);         // X3 = X1+Z1
+    field_add(Y3, q->X, q->Z);         // Y3 = X2+Z2
+    field_mul(X3, X3, Y3);             // X3 = X3*Y3
+    field_add(Y3, t0, t2);             // Y3 = t0+t2
+    field_sub(Y3, X3, Y3);             // Y3 = X3-Y3
+    field_add(X3, t0, t0);             // X3 = t0+t0
+    field_add(t0, X3, t0);             // t0 = X3+t0
+    field_mul(t2, GROUP_COEFF_B3, t2); // t2 = b3*t2
+    field_add(Z3, t1, t2);             // Z3 = t1+t2
+    field_sub(t1, t1, t2);             // t1 = t1-t2
+    field_mul(Y3, GROUP_COEFF_B3, Y3); // Y3 = b3*Y3
+    field_mul(X3, t4, Y3);             // X3 = t4*Y3
+    field_mul(t2, t3, t1);             // t2 = t3*t1
+    field_sub(X3, t2, X3);             // X3 = t2-X3
+    field_mul(Y3, Y3, t0);             // Y3 = Y3*t0
+    field_mul(t1, t1, Z3);             // t1 = t1*Z3
+    field_add(Y3, t1, Y3);             // Y3 = t1+Y3
+    field_mul(t0, t0, t3);             // t0 = t0*t3
+    field_mul(Z3, Z3, t4);             // Z3 = Z3*t4
+    field_add(Z3, Z3, t0);             // Z3 = Z3+t0
+
+    field_copy(r->X, X3);
+    field_copy(r->Y, Y3);
+    field_copy(r->Z, Z3);
+    explicit_bzero(t, sizeof(t));
+}
+
+// cost 6M + 2S + 1*b3 + 9add
+void projective_dbl(Projective *r, const Projective *p)
+{
+    OP_COUNT(OP_PROJECTIVE_DBL);
+
+    Field t[6];
+    uint8_t *t0 = t[0], *t1 = t[1], *t2 = t[2];
+    uint8_t *X3 = t[3], *Y3 = t[4], *Z3 = t[5];
+
+    field_sq(t0, p->Y);                // t0 = Y*Y
+    field_add(Z3, t0, t0);             // Z3 = t0+t0
+    field_add(Z3, Z3, Z3);             // Z3 = Z3+Z3
+    field_add(Z3, Z3, Z3);             // Z3 = Z3+Z3
+    field_mul(t1, p->Y, p->Z);         // t1 = Y*Z
+    field_sq(t2, p->Z);                // t2 = Z*Z
+    field_mul(t2, GROUP_COEFF_B3, t2); // t2 = b3*t2
+    field_mul(X3, t2, Z3);             // X3 = t2*Z3
+    field_add(Y3, t0, t2);             // Y3 = t0+t2
+    field_mul(Z3, t1, Z3);             // Z3 = t1*Z3
+    field_add(t1, t2, t2);             // t1 = t2+t2
+    field_add(t2, t1, t2);             // t2 = t1+t2
+    field_sub(t0, t0, t2);             // t0 = t0-t2
+    field_mul(Y3, t0, Y3);             // Y3 = t0*Y3
+    field_add(Y3, X3, Y3);             // Y3 = X3+Y3
+    field_mul(t1, p->X, p->Y);         // t1 = X*Y
+    field_mul(X3, t0, t1);             // X3 = t0*t1
+    field_add(X3, X3, X3);             // X3 = X3+X3
+
+    field_copy(r->X, X3);
+    field_copy(r->Y, Y3);
+    field_copy(r->Z, Z3);
+    explicit_bzero(t, sizeof(t));
+}
+
+// Double-and-add scalar multiplication with the complete formulas
+void projective_scalar_mul(Projective *q, const Scalar k, const Projective *p)
+{
+    OP_COUNT(OP_PROJECTIVE_SCALAR_MUL);
+
+    field_copy(q->X, FIELD_ZERO);
+    field_copy(q->Y, FIELD_ONE);
+    field_copy(q->Z, FIELD_ZERO);
+
+    for (size_t i = 0; i < SCALAR_BITS; i++) {
+        uint8_t di = (k[i / 8] >> (7 - (i % 8))) & 0x01;
+
+        // q = 2q
+        projective_dbl(q, q);
+
+        if (di) {
+            // q = q + p
+            projective_add(q, q, p);
+        }
+    }
+}
+
+void affine_to_projective(Projective *q, const Affine *p)
+{
+    if (affine_is_zero(p)) {
+        field_copy(q->X, FIELD_ZERO);
+        field_copy(q->Y, FIELD_ONE);
+        field_copy(q->Z, FIELD_ZERO);
+        return;
+    }
+
+    field_copy(q->X, p->x);
+    field_copy(q->Y, p->y);
+    field_copy(q->Z, FIELD_ONE);
+}
+
+void affine_from_projective(Affine *q, const Projective *p)
+{
+    if (field_eq(p->Z, FIELD_ZERO)) {
+        field_copy(q->x, FIELD_ZERO);
+        field_copy(q->y, FIELD_ZERO);
+        return;
+    }
+
+    Field zi;
+    field_inv(zi, p->Z);         // 1/Z
+    field_mul(q->x, p->X, zi);   // X/Z
+    field_mul(q->y, p->Y, zi);   // Y/Z
+    explicit_bzero(zi, sizeof(zi));
+}
+
+// Co-Z Montgomery ladder
+//
+//     Rivain: Fast and regular algorithms for scalar multiplication over
+//     elliptic curves (https://eprint.iacr.org/2011/338), algorithm 9.
+//     The two ladder points share their Jacobian Z, which is never
+//     computed, so a point is just (X, Y) and every bit costs one
+//     conjugate addition and one addition, whatever its value.  Z is
+//     recovered once at the end from the input point.
+//
+//     Both routines work in place: q = p + q and p becomes p - q
+//     (coz_addc) or p with the new Z (coz_add).
+
+// cost 4M + 2S + 7add
+static void coz_add(uint8_t *X1, uint8_t *Y1, uint8_t *X2, uint8_t *Y2)
+{
+    OP_COUNT(OP_COZ_ADD);
+
+    Field *t = _scratch.w.curve.point;
+    uint8_t *t0 = t[0], *B = t[1], *C = t[2], *t3 = t[3];
+
+    field_sub(t0, X2, X1);   // t0 = X2-X1
+    field_sq(t0, t0);        // A = t0^2
+    field_mul(B, X1, t0);    // B = X1*A
+    field_mul(C, X2, t0);    // C = X2*A
+    field_sub(t3, Y2, Y1);   // t3 = Y2-Y1
+    field_sq(X2, t3);        // D = t3^2
+    field_sub(X2, X2, B);
+    field_sub(X2, X2, C);    // X3 = D-B-C
+    field_sub(C, C, B);      // C = C-B
+    field_mul(Y1, Y1, C);    // Y1' = Y1*(C-B)
+    field_sub(t0, B, X2);    // t0 = B-X3
+    field_mul(t3, t3, t0);   // t3 = t3*t0
+    field_sub(Y2, t3, Y1);   // Y3 = t3-Y1'
+    field_copy(X1, B);       // X1' = B
+}
+
+// cost 5M + 3S + 10add
+static void coz_addc(uint8_t *X1, uint8_t *Y1, uint8_t *X2, uint8_t *Y2)
+{
+    OP_COUNT(OP_COZ_ADDC);
+
+    Field *t = _scratch.w.curve.point;
+    uint8_t *t0 = t[0], *B = t[1], *C = t[2], *t3 = t[3], *t4 = t[4];
+
+    field_sub(t0, X2, X1);   // t0 = X2-X1
+    field_sq(t0, t0);        // A = t0^2
+    field_mul(B, X1, t0);    // B = X1*A
+    field_mul(C, X2, t0);    // C = X2*A
+    field_sub(t3, Y2, Y1);   // t3 = Y2-Y1
+    field_add(t4, Y2, Y1);   // t4 = Y2+Y1
+    field_sub(t0, C, B);     // t0 = C-B
+    field_mul(Y1, Y1, t0);   // E = Y1*(C-B)
+    field_add(C, B, C);      // C = B+C
+    field_sq(X2, t3);
+    field_sub(X2, X2, C);    // X3 = t3^2-(B+C)
+    field_sub(t0, B, X2);    // t0 = B-X3
+    field_mul(t0, t3, t0);   // t0 = t3*t0
+    field_sub(Y2, t0, Y1);   // Y3 = t0-E
+    field_sq(X1, t4);
+    field_sub(X1, X1, C);    // X3' = t4^2-(B+C)
+    field_sub(t0, X1, B);    // t0 = X3'-B
+    field_mul(t0, t4, t0);   // t0 = t4*t0
+    field_sub(Y1, t0, Y1);   // Y3' = t0-E
+}
+
+// (X1, Y1) = 2p and (X0, Y0) = p with a common Z, from affine p
+//     cost 2M + 3S + 3*c + 4add
+static void coz_dbl_init(uint8_t *X0, uint8_t *Y0, uint8_t *X1, uint8_t *Y1,
+                         const Affine *p)
+{
+    Field *t = _scratch.w.curve.point;
+    uint8_t *t0 = t[0], *M = t[1], *t2 = t[2];
+
+    field_sq(t0, p->x);              // t0 = x^2
+    field_mul(M, FIELD_THREE, t0);   // M = 3*t0
+    field_sq(t2, p->y);              // t2 = y^2
+    field_mul(t0, p->x, t2);         // t0 = x*t2
+    field_mul(X0, FIELD_FOUR, t0);   // S = 4*t0 [X0 = x*(2y)^2]
+    field_sq(t0, t2);                // t0 = y^4
+    field_mul(Y0, FIELD_EIGHT, t0);  // Y0 = 8*t0 [y*(2y)^3]
+    field_sq(X1, M);                 // X1 = M^2
+    field_sub(X1, X1, X0);
+    field_sub(X1, X1, X0);           // X1 = M^2-2*S
+    field_sub(t0, X0, X1);           // t0 = S-X1
+    field_mul(t0, M, t0);            // t0 = M*t0
+    field_sub(Y1, t0, Y0);           // Y1 = t0-Y0
+}
+
+// Returns the bit of k at position i (0 = least significant)
+static uint8_t scalar_bit(const Scalar k, const size_t i)
+{
+    return (k[SCALAR_BYTES - 1 - i / 8] >> (i % 8)) & 0x01;
+}
+
+// r = k + n*GROUP_ORDER for n = 1 or 2, whichever has the top bit set, so
+// that the ladder always runs over SCALAR_BITS bits.  Requires k < 2^255.
+static void scalar_regular(Scalar r, const Scalar k)
+{
+    Field *t = _scratch.w.curve.point;
+    uint8_t *r1 = t[0], *r2 = t[1];
+    uint16_t c1 = 0, c2 = 0;
+
+    for (size_t i = SCALAR_BYTES; i-- > 0;) {
+        c1 += k[i] + GROUP_ORDER[i];
+        r1[i] = c1;
+        c1 >>= 8;
+        c2 += r1[i] + GROUP_ORDER[i];
+        r2[i] = c2;
+        c2 >>= 8;
+    }
+
+    uint8_t mask = -(r1[0] >> 7);
+    for (size_t i = 0; i < SCALAR_BYTES; i++) {
+        r[i] = (r1[i] & mask) | (r2[i] & ~mask);
+    }
+}
+
+// Co-Z Montgomery ladder; returns false in the exceptional cases where
+// the two ladder points meet (k = -1, a few scalars whose prefix is
+// (n - 1)/2 mod n, or x(p) = 0), which the caller handles with the
+// double-and-add loop
+static bool coz_scalar_mul(Affine *q, const Scalar k, const Affine *p)
+{
+    Field *X = _scratch.w.curve.u.coz.X, *Y = _scratch.w.curve.u.coz.Y;
+    uint8_t *kr = _scratch.w.curve.u.coz.k;
+    bool exceptional = field_eq(p->x, FIELD_ZERO);
+    uint8_t b;
+
+    scalar_regular(kr, k);
+    coz_dbl_init(X[0], Y[0], X[1], Y[1], p);
+    for (size_t i = SCALAR_BITS - 2; i > 0; i--) {
+        b = scalar_bit(kr, i);
+        exceptional |= field_eq(X[0], X[1]);
+        coz_addc(X[b], Y[b], X[1 - b], Y[1 - b]);
+        exceptional |= field_eq(X[0], X[1]);
+        coz_add(X[1 - b], Y[1 - b], X[b], Y[b]);
+    }
+    b = scalar_bit(kr, 0);
+    exceptional |= field_eq(X[0], X[1]);
+    coz_addc(X[b], Y[b], X[1 - b], Y[1 - b]);
+    exceptional |= field_eq(X[0], X[1]);
+    if (exceptional) {
+        return false;
+    }
+
+    // R_b = +-p, so 1/Z = y(p)*X_b/(x(p)*Y_b*(X1-X0)) after the last
+    // addition, which multiplies Z by X_b-X_{1-b}
+    Field *t = _scratch.w.curve.point;
+    uint8_t *l = t[5], *t6 = t[6];
+    field_sub(l, X[1], X[0]);        // l = X1-X0
+    field_mul(l, l, Y[b]);           // l = Y_b*l
+    field_mul(l, l, p->x);           // l = x(p)*l
+    field_inv(l, l);                 // l = 1/l
+    field_mul(l, l, p->y);           // l = y(p)*l
+    field_mul(l, l, X[b]);           // l = X_b*l
+
+    coz_add(X[1 - b], Y[1 - b], X[b], Y[b]);
+
+    field_sq(t6, l);                 // t6 = l^2
+    field_mul(q->x, X[0], t6);       // x = X0*l^2
+    field_mul(t6, t6, l);            // t6 = l^3
+    field_mul(q->y, Y[0], t6);       // y = Y0*l^3
+    return true;
+}
+
 void affine_scalar_mul(Affine *q, const Scalar k, const Affine *p)
 {
-    Group pp, pq;
-    affine_to_group(&pp, p);
-    group_scalar_mul(&pq, k, &pp);
-    affine_from_group(q, &pq);
+    if (affine_is_zero(p) || scalar_is_zero(k)) {
+        field_copy(q->x, FIELD_ZERO);
+        field_copy(q->y, FIELD_ZERO);
+        return;
+    }
+
+    scratch_begin(SCRATCH_KEYPAIR);
+    BEGIN_TRY {
+        TRY {
+            if (k[0] & 0x80 || !coz_scalar_mul(q, k, p)) {
+                Group *pp = &_scratch.w.curve.u.keypair.p, *pq = &_scratch.w.curve.u.keypair.q;
+                affine_to_group(pp, p);
+                group_scalar_mul(pq, k, pp);
+                affine_from_group(q, pq);
+            }
+        }
+        FINALLY {
+            scratch_end();
+        }
+        END_TRY;
+    }
 }
 
 bool affine_eq(const Affine *p, const Affine *q)
@@ -474,26 +931,58 @@ bool affine_eq(const Affine *p, const Affine *q)
 
 void affine_add(Affine *r, const Affine *p, const Affine *q)
 {
-    Group gr, gp, gq;
-    affine_to_group(&gp, p);
-    affine_to_group(&gq, q);
-    group_add(&gr, &gp, &gq);
-    affine_from_group(r, &gr);
+    scratch_begin(SCRATCH_KEYPAIR);
+    BEGIN_TRY {
+        TRY {
+            Group *gr = &_scratch.w.curve.u.keypair.r;
+            Group *gp = &_scratch.w.curve.u.keypair.p, *gq = &_scratch.w.curve.u.keypair.q;
+            affine_to_group(gp, p);
+            affine_to_group(gq, q);
+            group_add(gr, gp, gq);
+            affine_from_group(r, gr);
+        }
+        FINALLY {
+            scratch_end();
+        }
+        END_TRY;
+    }
 }
 
 void affine_negate(Affine *q, const Affine *p)
 {
-    Group gq, gp;
-    affine_to_group(&gp, p);
-    group_negate(&gq, &gp);
-    affine_from_group(q, &gq);
+    scratch_begin(SCRATCH_KEYPAIR);
+    BEGIN_TRY {
+        TRY {
+            Group *gq = &_scratch.w.curve.u.keypair.q, *gp = &_scratch.w.curve.u.keypair.p;
+            affine_to_group(gp, p);
+            group_negate(gq, gp);
+            affine_from_group(q, gq);
+        }
+        FINALLY {
+            scratch_end();
+        }
+        END_TRY;
+    }
 }
 
 bool affine_is_on_curve(const Affine *p)
 {
-    Group gp;
-    affine_to_group(&gp, p);
-    return group_is_on_curve(&gp);
+    bool on_curve = false;
+
+    scratch_begin(SCRATCH_KEYPAIR);
+    BEGIN_TRY {
+        TRY {
+            Group *gp = &_scratch.w.curve.u.keypair.p;
+            affine_to_group(gp, p);
+            on_curve = group_is_on_curve(gp);
+        }
+        FINALLY {
+            scratch_end();
+        }
+        END_TRY;
+    }
+
+    return on_curve;
 }
 
 void generate_pubkey(Affine *pub_key, const Scalar priv_key)
@@ -501,7 +990,63 @@ void generate_pubkey(Affine *pub_key, const Scalar priv_key)
     affine_scalar_mul(pub_key, priv_key, &AFFINE_ONE);
 }
 
-void generate_keypair(Keypair *keypair, const uint32_t account)
+// generate_pubkey() with the complete formulas
+void generate_pubkey_complete(Affine *pub_key, const Scalar priv_key)
+{
+    Projective g, q;
+    affine_to_projective(&g, &AFFINE_ONE);
+    projective_scalar_mul(&q, priv_key, &g);
+    affine_from_projective(pub_key, &q);
+    explicit_bzero(&q, sizeof(q));
+}
+
+// q += k*g over the next SIGN_COMMIT_STEP_BITS bits of k from *bit, for a
+// caller that owns the SCRATCH_SCALAR_MUL stage.  Returns true once all
+// bits are processed.
+static bool scalar_mul_g_step(Group *q, const Scalar k, size_t *bit)
+{
+    Group *g = &_scratch.w.curve.u.scalar_mul.g;
+    affine_to_group(g, &AFFINE_ONE);
+    group_scalar_mul_bits(q, k, g, *bit, *bit + SIGN_COMMIT_STEP_BITS);
+    *bit += SIGN_COMMIT_STEP_BITS;
+    if (*bit < SCALAR_BITS) {
+        return false;
+    }
+
+    STATS_OP(STATS_SCALAR_MUL);
+    return true;
+}
+
+void pubkey_init(PubkeyCtx *ctx, const Scalar priv_key)
+{
+    explicit_bzero(ctx, sizeof(*ctx));
+    ctx->priv = priv_key;
+    group_copy(&ctx->q, &GROUP_ZERO);
+}
+
+// Returns true once pub_key is set
+bool pubkey_step(PubkeyCtx *ctx, Affine *pub_key)
+{
+    bool done = false;
+
+    scratch_begin(SCRATCH_SCALAR_MUL);
+    BEGIN_TRY {
+        TRY {
+            if (scalar_mul_g_step(&ctx->q, ctx->priv, &ctx->bit)) {
+                affine_from_group(pub_key, &ctx->q);
+                done = true;
+            }
+        }
+        FINALLY {
+            scratch_end();
+        }
+        END_TRY;
+    }
+
+    return done;
+}
+
+void generate_private_key(Scalar priv_key, const uint32_t account)
 {
     const uint32_t bip32_path[BIP32_PATH_LEN] = {
         44      | BIP32_HARDENED_OFFSET,
@@ -511,9 +1056,14 @@ void generate_keypair(Keypair *keypair, const uint32_t account)
         0
     };
 
+    os_perso_derive_node_bip32(CX_CURVE_256K1, bip32_path, BIP32_PATH_LEN, priv_key, NULL);
+    scalar_from_bytes(priv_key);
+}
+
+void generate_keypair(Keypair *keypair, const uint32_t account)
+{
     // Generate private key
-    os_perso_derive_node_bip32(CX_CURVE_256K1, bip32_path, BIP32_PATH_LEN, keypair->priv, NULL);
-    scalar_from_bytes(keypair->priv);
+    generate_private_key(keypair->priv, account);
 
     // Generate public key
     generate_pubkey(&keypair->pub, keypair->priv);
@@ -521,38 +1071,30 @@ void generate_keypair(Keypair *keypair, const uint32_t account)
     return;
 }
 
-bool generate_address(char *address, const size_t len, const Affine *pub_key)
+// Sets the version bytes and payload of the address of a compressed
+// public key, but not the checksum
+void raw_address_from_key(RawAddress *raw, const Compressed *pub_key)
 {
-    if (len != MINA_ADDRESS_LEN) {
-        address[0] = '\0';
-        return false;
-    }
-
-    struct bytes {
-        uint8_t version;
-        uint8_t payload[35];
-        uint8_t checksum[4];
-    } raw;
-
-    raw.version    = 0xcb; // version for base58 check
-    raw.payload[0] = 0x01; // non_zero_curve_point version
-    raw.payload[1] = 0x01; // compressed_poly version
+    raw->version    = 0xcb; // version for base58 check
+    raw->payload[0] = 0x01; // non_zero_curve_point version
+    raw->payload[1] = 0x01; // compressed_poly version
     // reversed x-coordinate
     for (size_t i = 0; i < sizeof(pub_key->x); i++) {
-        raw.payload[i + 2] = pub_key->x[sizeof(pub_key->x) - i - 1];
+        raw->payload[i + 2] = pub_key->x[sizeof(pub_key->x) - i - 1];
     }
     // y-coordinate parity
-    raw.payload[34] = field_is_odd(pub_key->y);
-
-    uint8_t hash1[CX_SHA256_SIZE];
-    cx_hash_sha256((const unsigned char *)&raw, 36, hash1, sizeof(hash1));
+    raw->payload[34] = pub_key->is_odd;
+}
 
-    uint8_t hash2[CX_SHA256_SIZE];
-    cx_hash_sha256(hash1, sizeof(hash1), hash2, sizeof(hash2));
-    memcpy(raw.checksum, hash2, 4);
+// Base58 encodes address bytes whose checksum is set
+bool raw_address_encode(char *address, const size_t len, const RawAddress *raw)
+{
+    if (len != MINA_ADDRESS_LEN) {
+        address[0] = '\0';
+        return false;
+    }
 
-    // Encode as address
-    int result = b58_encode((unsigned char *)&raw, sizeof(raw), (unsigned char *)address, len);
+    int result = b58_encode((const unsigned char *)raw, sizeof(*raw), (unsigned char *)address, len);
     address[MINA_ADDRESS_LEN - 1] = '\0';
     if (result < 0) {
         address[0] = '\0';
@@ -566,119 +1108,385 @@ bool generate_address(char *address, const size_t len, const Affine *pub_key)
     return true;
 }
 
-bool validate_address(const char *address)
+// Base58 decodes an address and validates its version and parity bytes,
+// but not its checksum
+bool raw_address_decode(RawAddress *raw, const char *address)
 {
-    uint8_t bytes[40];
-    size_t bytes_len = sizeof(bytes);
+    size_t bytes_len = sizeof(*raw);
 
     if (strnlen(address, MINA_ADDRESS_LEN) != MINA_ADDRESS_LEN - 1) {
         return false;
     }
 
-    b58_decode(bytes, &bytes_len, address, MINA_ADDRESS_LEN - 1);
+    if (!b58_decode((uint8_t *)raw, &bytes_len, address, MINA_ADDRESS_LEN - 1)) {
+        return false;
+    }
+    if (bytes_len != sizeof(*raw)) {
+        return false;
+    }
 
-    struct bytes {
-        uint8_t version;
-        uint8_t payload[35];
-        uint8_t checksum[4];
-    } *raw = (struct bytes *)bytes;
+    if (raw->version != 0xcb || raw->payload[0] != 0x01 || raw->payload[1] != 0x01) {
+        return false;
+    }
+    if (raw->payload[34] > 1) {
+        return false;
+    }
+
+    return true;
+}
+
+// Encodes a compressed public key as a base58 check address, the inverse
+// of decode_address()
+bool encode_address(char *address, const size_t len, const Compressed *pub_key)
+{
+    RawAddress raw;
+
+    raw_address_from_key(&raw, pub_key);
 
     uint8_t hash1[CX_SHA256_SIZE];
-    cx_hash_sha256((const unsigned char *)raw, 36, hash1, sizeof(hash1));
+    cx_hash_sha256((const unsigned char *)&raw, RAW_ADDRESS_CHECKED_LEN, hash1, sizeof(hash1));
 
     uint8_t hash2[CX_SHA256_SIZE];
     cx_hash_sha256(hash1, sizeof(hash1), hash2, sizeof(hash2));
-    return memcmp(raw->checksum, hash2, 4) == 0;
+    memcpy(raw.checksum, hash2, sizeof(raw.checksum));
+
+    // Encode as address
+    return raw_address_encode(address, len, &raw);
 }
 
-bool message_derive(Scalar out, const Keypair *kp, const ROInput *input, const uint8_t network_id)
+bool generate_address(char *address, const size_t len, const Affine *pub_key)
 {
-    uint8_t derive_msg[268] = { };
-    int derive_len = roinput_derive_message(derive_msg, sizeof(derive_msg), kp, input, network_id);
-    if (derive_len < 0) {
+    Compressed compressed;
+
+    field_copy(compressed.x, pub_key->x);
+    compressed.is_odd = field_is_odd(pub_key->y);
+
+    return encode_address(address, len, &compressed);
+}
+
+// Decodes an address into its compressed public key, validating the
+// version bytes, the parity byte and the base58 check checksum
+bool decode_address(Compressed *pub_key, const char *address)
+{
+    RawAddress raw;
+
+    if (!raw_address_decode(&raw, address)) {
         return false;
     }
 
-    // blake2b hash
-    cx_blake2b_t ctx;
-    cx_blake2b_init(&ctx, 256);
-    cx_hash(&ctx.header, 0, derive_msg, derive_len, NULL, 0);
-    cx_hash(&ctx.header, CX_LAST, NULL, 0, out, ctx.ctx.outlen);
+    uint8_t hash1[CX_SHA256_SIZE];
+    cx_hash_sha256((const unsigned char *)&raw, RAW_ADDRESS_CHECKED_LEN, hash1, sizeof(hash1));
 
+    uint8_t hash2[CX_SHA256_SIZE];
+    cx_hash_sha256(hash1, sizeof(hash1), hash2, sizeof(hash2));
+    if (memcmp(raw.checksum, hash2, sizeof(raw.checksum)) != 0) {
+        return false;
+    }
+
+    // reversed x-coordinate
+    for (size_t i = 0; i < sizeof(pub_key->x); i++) {
+        pub_key->x[i] = raw.payload[sizeof(pub_key->x) - i + 1];
+    }
+    // y-coordinate parity
+    pub_key->is_odd = raw.payload[34];
+
+    return true;
+}
+
+bool validate_address(const char *address)
+{
+    Compressed pub_key;
+
+    return decode_address(&pub_key, address);
+}
+
+void scalar_from_digest(Scalar a)
+{
     // Swap from little-endian to big-endian in place
     for (size_t i = SCALAR_BYTES; i > SCALAR_BYTES/2; i--) {
         uint8_t tmp;
-        tmp = out[i - 1];
-        out[i - 1] = out[SCALAR_BYTES - i];
-        out[SCALAR_BYTES - i] = tmp;
+        tmp = a[i - 1];
+        a[i - 1] = a[SCALAR_BYTES - i];
+        a[SCALAR_BYTES - i] = tmp;
     }
 
     // Convert to scalar
-    scalar_from_bytes(out);
-
-    return true;
+    scalar_from_bytes(a);
 }
 
-bool message_hash(Scalar out, const Affine *pub, const Field rx, const ROInput *input, const uint8_t network_id)
+bool message_derive(Scalar out, const Keypair *kp, const ROInput *input, const uint8_t network_id)
 {
-    Field hash_msg[9];
-    int hash_msg_len = roinput_hash_message(hash_msg, sizeof(hash_msg), pub, rx, input);
-    if (hash_msg_len < 0) {
-        return false;
-    }
+    bool derived = false;
 
-    // Initial sponge state
-    State pos;
-    poseidon_init(pos, network_id);
-    poseidon_update(pos, hash_msg, hash_msg_len);
-    poseidon_digest(out, pos);
+    scratch_begin(SCRATCH_DERIVE);
+    BEGIN_TRY {
+        TRY {
+            // The derive message holds the private key
+            uint8_t *derive_msg = _scratch.w.derive.msg;
+            // The point temporaries it overlays are used outside stages and
+            // roinput_to_bytes() keeps the padding bits of the last byte
+            memset(derive_msg, 0, DERIVE_MSG_LEN);
+            int derive_len = roinput_derive_message(derive_msg, DERIVE_MSG_LEN, kp, input, network_id);
+            if (derive_len >= 0) {
+                // blake2b hash
+                cx_blake2b_t *ctx = &_scratch.w.derive.blake;
+                cx_blake2b_init(ctx, 256);
+                cx_hash(&ctx->header, 0, derive_msg, derive_len, NULL, 0);
+                cx_hash(&ctx->header, CX_LAST, NULL, 0, out, ctx->ctx.outlen);
+
+                scalar_from_digest(out);
+                derived = true;
+            }
+        }
+        FINALLY {
+            scratch_end();
+        }
+        END_TRY;
+    }
 
-    return true;
+    return derived;
 }
 
-bool sign(Signature *sig, const Keypair *kp, const ROInput *input, const uint8_t network_id)
+bool message_hash(Scalar out, const Affine *pub, const Field rx, const ROInput *input, const uint8_t network_id)
 {
-    Scalar k;
-    Affine r;
-    Scalar tmp;
-    bool error = false;
+    bool hashed = false;
 
+    scratch_begin(SCRATCH_HASH);
     BEGIN_TRY {
         TRY {
-            // k = message_derive(input.fields + kp.pub + input.bits + kp.priv)
-            if (!message_derive(k, kp, input, network_id)) {
-                THROW(INVALID_PARAMETER);
+            Field *hash_msg = _scratch.w.curve.u.hash.msg;
+            int hash_msg_len = roinput_hash_message(hash_msg, HASH_MSG_FIELDS, pub, rx, input);
+            if (hash_msg_len >= 0) {
+                // Initial sponge state
+                Field *pos = _scratch.w.curve.u.hash.pos;
+                poseidon_init(pos, network_id);
+                poseidon_update(pos, hash_msg, hash_msg_len);
+                poseidon_digest(out, pos);
+                hashed = true;
             }
+        }
+        FINALLY {
+            scratch_end();
+        }
+        END_TRY;
+    }
 
-            // r = k*g
-            affine_scalar_mul(&r, k, &AFFINE_ONE);
-            field_copy(sig->rx, r.x);
+    return hashed;
+}
 
-            if (field_is_odd(r.y)) {
-                // k = -k
-                scalar_copy(tmp, k);
-                scalar_negate(k, tmp);
-            }
+void sign_init(SignCtx *ctx, const Keypair *kp, const ROInput *input, const uint8_t network_id)
+{
+    explicit_bzero(ctx, sizeof(*ctx));
+    ctx->kp = kp;
+    ctx->input = input;
+    ctx->network_id = network_id;
+    ctx->stage = SIGN_STAGE_DERIVE;
+    group_copy(&ctx->r, &GROUP_ZERO);
+}
 
-            // e = message_hash(input + kp.pub + r.x)
-            if (!message_hash(sig->s, &kp->pub, r.x, input, network_id)) {
-                THROW(INVALID_PARAMETER);
-            }
+void sign_clear(SignCtx *ctx)
+{
+    explicit_bzero(ctx, sizeof(*ctx));
+}
 
-            // s = k + e*sk
-            scalar_mul(tmp, sig->s, kp->priv);
-            scalar_add(sig->s, k, tmp);
+// Starts signing at the commit stage, from the nonce digest that
+// message_derive() would compute (BLAKE2b-256 of roinput_derive_message()),
+// for callers that hash several derivation messages at once
+void sign_init_derived(SignCtx *ctx, const Keypair *kp, const ROInput *input,
+                       const uint8_t network_id, const uint8_t digest[SCALAR_BYTES])
+{
+    sign_init(ctx, kp, input, network_id);
+    memcpy(ctx->k, digest, sizeof(ctx->k));
+    scalar_from_digest(ctx->k);
+    ctx->stage = SIGN_STAGE_COMMIT;
+}
+
+bool sign_step(SignCtx *ctx)
+{
+    // The commit and hash stages own the arena for the whole step, nonce
+    // derivation takes it inside message_derive()
+    scratch_stage_t stage = SCRATCH_NONE;
+    if (ctx->stage == SIGN_STAGE_COMMIT) {
+        stage = SCRATCH_SCALAR_MUL;
+    }
+    else if (ctx->stage == SIGN_STAGE_HASH) {
+        stage = SCRATCH_HASH;
+    }
+    if (stage != SCRATCH_NONE) {
+        scratch_begin(stage);
+    }
+
+    BEGIN_TRY {
+        TRY {
+            switch (ctx->stage) {
+                case SIGN_STAGE_DERIVE:
+                    // k = message_derive(input.fields + kp.pub + input.bits + kp.priv)
+                    if (!message_derive(ctx->k, ctx->kp, ctx->input, ctx->network_id)) {
+                        THROW(INVALID_PARAMETER);
+                    }
+                    ctx->bit = 0;
+                    ctx->stage = SIGN_STAGE_COMMIT;
+                    break;
+
+                case SIGN_STAGE_COMMIT:
+                    // r = k*g, SIGN_COMMIT_STEP_BITS bits at a time
+                    if (scalar_mul_g_step(&ctx->r, ctx->k, &ctx->bit)) {
+                        ctx->stage = SIGN_STAGE_HASH;
+                    }
+                    break;
+
+                case SIGN_STAGE_HASH: {
+                    // e = message_hash(input + kp.pub + r.x), one Poseidon
+                    // permutation per step.  The hash message is rebuilt
+                    // at every step, which costs no permutation.
+                    Field   *hash_msg = _scratch.w.curve.u.hash.msg;
+                    uint8_t *tmp = _scratch.w.curve.u.hash.tmp;
+                    if (ctx->absorbed == 0) {
+                        Affine *r = &_scratch.w.curve.u.hash.r;
+                        affine_from_group(r, &ctx->r);
+                        field_copy(ctx->sig.rx, r->x);
+
+                        if (field_is_odd(r->y)) {
+                            // k = -k
+                            scalar_copy(tmp, ctx->k);
+                            scalar_negate(ctx->k, tmp);
+                        }
+                        poseidon_init(ctx->sponge, ctx->network_id);
+                    }
+
+                    int hash_msg_len = roinput_hash_message(hash_msg, HASH_MSG_FIELDS, &ctx->kp->pub,
+                                                            ctx->sig.rx, ctx->input);
+                    if (hash_msg_len < 0 || ctx->absorbed > (size_t)hash_msg_len) {
+                        THROW(INVALID_PARAMETER);
+                    }
+                    size_t n = hash_msg_len - ctx->absorbed < 2 ? hash_msg_len - ctx->absorbed : 2;
+                    poseidon_update(ctx->sponge, hash_msg + ctx->absorbed, n);
+                    ctx->absorbed += n;
+                    if (ctx->absorbed < (size_t)hash_msg_len) {
+                        break;
+                    }
+
+                    // s = k + e*sk
+                    poseidon_digest(ctx->sig.s, ctx->sponge);
+                    scalar_mul(tmp, ctx->sig.s, ctx->kp->priv);
+                    scalar_add(ctx->sig.s, ctx->k, tmp);
+
+                    explicit_bzero(ctx->k, sizeof(ctx->k));
+                    ctx->stage = SIGN_STAGE_DONE;
+                    break;
+                }
+
+                case SIGN_STAGE_DONE:
+                    break;
+
+                default:
+                    THROW(INVALID_PARAMETER);
+            }
         }
         CATCH_OTHER(e) {
-            error = true;
+            sign_clear(ctx);
+            ctx->stage = SIGN_STAGE_ERROR;
         }
         FINALLY {
             // Clear secrets from memory
-            explicit_bzero(tmp, sizeof(tmp));
-            explicit_bzero(k, sizeof(k));
+            if (stage != SCRATCH_NONE) {
+                scratch_end();
+            }
         }
         END_TRY;
     }
 
-    return !error;
+    return ctx->stage != SIGN_STAGE_ERROR;
+}
+
+bool sign(Signature *sig, const Keypair *kp, const ROInput *input, const uint8_t network_id)
+{
+    SignCtx ctx;
+
+    sign_init(&ctx, kp, input, network_id);
+    while (ctx.stage != SIGN_STAGE_DONE) {
+        if (!sign_step(&ctx)) {
+            return false;
+        }
+    }
+
+    memcpy(sig, &ctx.sig, sizeof(*sig));
+    sign_clear(&ctx);
+
+    return true;
+}
+
+// Checks that r = s*g - e*pub has even y and x = sig.rx, where
+// e = message_hash(input + pub + sig.rx)
+bool verify(const Signature *sig, const Affine *pub, const ROInput *input, const uint8_t network_id)
+{
+    Scalar e;
+    Group  g, r, t;
+    Affine ra;
+
+    if (memcmp(sig->rx, FIELD_MODULUS, sizeof(sig->rx)) >= 0) {
+        return false;
+    }
+    if (memcmp(sig->s, GROUP_ORDER, sizeof(sig->s)) >= 0) {
+        return false;
+    }
+    if (affine_is_zero(pub) || !affine_is_on_curve(pub)) {
+        return false;
+    }
+
+    if (!message_hash(e, pub, sig->rx, input, network_id)) {
+        return false;
+    }
+
+    // r = s*g - e*pub
+    affine_to_group(&g, &AFFINE_ONE);
+    group_scalar_mul(&r, sig->s, &g);
+    affine_to_group(&g, pub);
+    group_scalar_mul(&t, e, &g);
+    group_negate(&g, &t);
+    group_add(&t, &r, &g);
+    if (group_is_zero(&t)) {
+        return false;
+    }
+
+    affine_from_group(&ra, &t);
+
+    return !field_is_odd(ra.y) && field_eq(ra.x, sig->rx);
+}
+
+// verify() with the complete formulas
+bool verify_complete(const Signature *sig, const Affine *pub, const ROInput *input, const uint8_t network_id)
+{
+    Scalar     e;
+    Projective g, r, t;
+    Affine     ra;
+
+    if (memcmp(sig->rx, FIELD_MODULUS, sizeof(sig->rx)) >= 0) {
+        return false;
+    }
+    if (memcmp(sig->s, GROUP_ORDER, sizeof(sig->s)) >= 0) {
+        return false;
+    }
+    if (affine_is_zero(pub) || !affine_is_on_curve(pub)) {
+        return false;
+    }
+
+    if (!message_hash(e, pub, sig->rx, input, network_id)) {
+        return false;
+    }
+
+    // r = s*g - e*pub
+    affine_to_projective(&g, &AFFINE_ONE);
+    projective_scalar_mul(&r, sig->s, &g);
+    affine_to_projective(&g, pub);
+    projective_scalar_mul(&t, e, &g);
+    field_negate(t.Y, t.Y);
+    projective_add(&t, &r, &t);
+    if (field_eq(t.Z, FIELD_ZERO)) {
+        return false;
+    }
+
+    affine_from_projective(&ra, &t);
+
+    return !field_is_odd(ra.y) && field_eq(ra.x, sig->rx);
 }
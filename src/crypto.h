@@ -33,6 +33,13 @@ typedef struct group_t {
     Field Z;
 } Group;
 
+// Homogeneous projective (x = X/Z, y = Y/Z), for the complete formulas
+typedef struct projective_t {
+    Field X;
+    Field Y;
+    Field Z;
+} Projective;
+
 typedef struct affine_t {
     Field x;
     Field y;
@@ -43,6 +50,16 @@ typedef struct compressed_t {
     bool is_odd;
 } Compressed;
 
+// Base58 check address bytes; the checksum is the first bytes of the
+// double SHA-256 of the preceding RAW_ADDRESS_CHECKED_LEN bytes
+typedef struct raw_address_t {
+    uint8_t version;
+    uint8_t payload[35];
+    uint8_t checksum[4];
+} RawAddress;
+
+#define RAW_ADDRESS_CHECKED_LEN 36
+
 typedef struct signature_t {
     Field rx;
     Scalar s;
@@ -55,27 +72,96 @@ typedef struct keypair_t {
 
 typedef struct roinput_t ROInput; // Forward declaration
 
+// Signing can be performed incrementally with sign_step() so that the
+// work can be interleaved with other processing (e.g. UX events)
+#define SIGN_COMMIT_STEP_BITS 32 // Scalar bits processed per k*g step
+#define DERIVE_MSG_LEN        268 // roinput_derive_message() buffer
+
+typedef enum {
+    SIGN_STAGE_DERIVE = 0, // k = message_derive()
+    SIGN_STAGE_COMMIT,     // r = k*g
+    SIGN_STAGE_HASH,       // e = message_hash(), s = k + e*sk, one permutation per step
+    SIGN_STAGE_DONE,
+    SIGN_STAGE_ERROR
+} sign_stage_t;
+
+typedef struct sign_ctx_t {
+    const Keypair *kp;
+    const ROInput *input;
+    uint8_t        network_id;
+    uint8_t        stage;
+    size_t         bit;
+    size_t         absorbed;  // Hash message fields absorbed
+    Field          sponge[3]; // Poseidon State
+    Scalar         k;
+    Group          r;
+    Signature      sig;
+} SignCtx;
+
+// Public keys can be generated incrementally in the same way with
+// pubkey_step(), SIGN_COMMIT_STEP_BITS bits of the private key per step
+typedef struct pubkey_ctx_t {
+    const uint8_t *priv;
+    size_t         bit;
+    Group          q;
+} PubkeyCtx;
+
 void field_copy(Field b, const Field a);
 void field_add(Field c, const Field a, const Field b);
+void field_sub(Field c, const Field a, const Field b);
 void field_mul(Field c, const Field a, const Field b);
 void field_sq(Field b, const Field a);
+void field_inv(Field c, const Field a);
 void field_pow(Field c, const Field a, const Field e);
+bool field_is_odd(const Field y);
 
 void scalar_copy(Scalar b, const Scalar a);
 bool scalar_eq(const Scalar a, const Scalar b);
 void scalar_add(Scalar c, const Scalar a, const Scalar b);
 void scalar_mul(Scalar c, const Scalar a, const Scalar b);
 void scalar_negate(Field b, const Field a);
+void scalar_from_digest(Scalar a);
+
+void group_copy(Group *b, const Group *a);
+void group_dbl(Group *r, const Group *p);
+void group_add(Group *r, const Group *p, const Group *q);
+void group_scalar_mul(Group *q, const Scalar k, const Group *p);
 
+void projective_add(Projective *r, const Projective *p, const Projective *q);
+void projective_dbl(Projective *r, const Projective *p);
+void projective_scalar_mul(Projective *q, const Scalar k, const Projective *p);
+
+void affine_to_group(Group *q, const Affine *p);
+void affine_to_projective(Projective *q, const Affine *p);
+void affine_from_projective(Affine *q, const Projective *p);
 void affine_add(Affine *r, const Affine *p, const Affine *q);
 void affine_scalar_mul(Affine *q, const Scalar k, const Affine *p);
 void affine_negate(Affine *q, const Affine *p);
 bool affine_eq(const Affine *p, const Affine *q);
 bool affine_is_on_curve(const Affine *p);
 
+void generate_private_key(Scalar priv_key, uint32_t account);
 void generate_keypair(Keypair *keypair, uint32_t account);
 void generate_pubkey(Affine *pub_key, const Scalar priv_key);
+void generate_pubkey_complete(Affine *pub_key, const Scalar priv_key);
 bool generate_address(char *address, const size_t len, const Affine *pub_key);
+void pubkey_init(PubkeyCtx *ctx, const Scalar priv_key);
+bool pubkey_step(PubkeyCtx *ctx, Affine *pub_key);
+bool encode_address(char *address, const size_t len, const Compressed *pub_key);
+bool decode_address(Compressed *pub_key, const char *address);
+void raw_address_from_key(RawAddress *raw, const Compressed *pub_key);
+bool raw_address_encode(char *address, const size_t len, const RawAddress *raw);
+bool raw_address_decode(RawAddress *raw, const char *address);
 bool validate_address(const char *address);
 
+bool message_derive(Scalar out, const Keypair *kp, const ROInput *input, const uint8_t network_id);
+bool message_hash(Scalar out, const Affine *pub, const Field rx, const ROInput *input, const uint8_t network_id);
+
+void sign_init(SignCtx *ctx, const Keypair *kp, const ROInput *input, const uint8_t network_id);
+void sign_init_derived(SignCtx *ctx, const Keypair *kp, const ROInput *input,
+                       const uint8_t network_id, const uint8_t digest[SCALAR_BYTES]);
+bool sign_step(SignCtx *ctx);
+void sign_clear(SignCtx *ctx);
 bool sign(Signature *sig, const Keypair *kp, const ROInput *input, const uint8_t network_id);
+bool verify(const Signature *sig, const Affine *pub, const ROInput *input, const uint8_t network_id);
+bool verify_complete(const Signature *sig, const Affine *pub, const ROInput *input, const uint8_t network_id);
@@ -1,6 +1,7 @@
 #include "get_address.h"
 #include "utils.h"
 #include "crypto.h"
+#include "pubkey_cache.h"
 
 static bool     _generated;
 static uint32_t _account = 0;
@@ -18,24 +19,15 @@ static uint8_t set_result_get_address(void)
 static void gen_address(void)
 {
     if (!_generated) {
-        BEGIN_TRY {
-            Keypair kp;
-            TRY {
-                generate_keypair(&kp, _account);
-                if (!generate_address(_address, sizeof(_address), &kp.pub)) {
-                    THROW(INVALID_PARAMETER);
-                }
-                _generated = true;
-
-                #ifdef HAVE_ON_DEVICE_UNIT_TESTS
-                sendResponse(set_result_get_address(), true);
-                #endif
-            }
-            FINALLY {
-                explicit_bzero(kp.priv, sizeof(kp.priv));
-            }
-            END_TRY;
+        Affine pub;
+        if (!pubkey_cache_get(&pub, _address, sizeof(_address), _account)) {
+            THROW(INVALID_PARAMETER);
         }
+        _generated = true;
+
+        #ifdef HAVE_ON_DEVICE_UNIT_TESTS
+        sendResponse(set_result_get_address(), true);
+        #endif
     }
 }
 
@@ -81,10 +73,17 @@ static void gen_address(void)
         }
     );
 
+    static void approve_address(void)
+    {
+        // Only addresses the user confirmed are kept across sessions
+        pubkey_cache_persist(_account);
+        sendResponse(set_result_get_address(), true);
+    }
+
     UX_STEP_VALID(
         ux_get_address_result_flow_approve_step,
         pb,
-        sendResponse(set_result_get_address(), true),
+        approve_address(),
         {
             &C_icon_validate_14,
             "Approve",
@@ -1,5 +1,6 @@
 #include "globals.h"
 #include "menu.h"
+#include "stats.h"
 
 ux_state_t G_ux;
 bolos_ux_params_t G_ux_params;
@@ -9,9 +10,32 @@ unsigned int ux_step;
 unsigned int ux_step_count;
 const internalStorage_t N_storage_real;
 
+sign_state_t G_sign_state;
+
+// Message signing is meant to cost no RAM beyond transaction signing
+_Static_assert(sizeof(sign_msg_state_t) <= sizeof(sign_tx_state_t),
+               "message signing state outgrows the transaction state");
+
+void sign_state_take(const sign_state_owner_t owner)
+{
+    explicit_bzero(&G_sign_state, sizeof(G_sign_state));
+    G_sign_state.owner = owner;
+}
+
+void sign_state_release(const sign_state_owner_t owner)
+{
+    if (G_sign_state.owner == owner) {
+        // Clear secrets from memory
+        explicit_bzero(&G_sign_state, sizeof(G_sign_state));
+    }
+}
+
 void sendResponse(uint8_t tx, bool approve) {
     G_io_apdu_buffer[tx++] = approve? 0x90 : 0x69;
     G_io_apdu_buffer[tx++] = approve? 0x00 : 0x85;
+    #ifdef HAVE_APP_STATS
+        stats_command_end();
+    #endif
     // Send back the response, do not restart the event loop
     io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, tx);
     // Display back the original UX
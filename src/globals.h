@@ -4,6 +4,10 @@
 #include <ux.h>
 #include <os_io_seproxyhal.h>
 
+#include "crypto.h"
+#include "msg_stream.h"
+#include "parse_tx.h"
+
 #define P1_FIRST 0x00
 #define P1_MORE 0x80
 
@@ -12,13 +16,85 @@ extern ux_state_t ux;
 extern unsigned int ux_step;
 extern unsigned int ux_step_count;
 
+// Persistent public key cache (see pubkey_cache.c)
+#define NVM_PUBKEY_CACHE_VERSION    2
+#define NVM_PUBKEY_CACHE_SIZE       8
+#define NVM_SEED_FINGERPRINT_LEN    8
+#define NVM_PUBKEY_CHECKSUM_LEN     4
+
+typedef struct nvm_pubkey_entry_t {
+    uint32_t account;
+    uint32_t seq; // write order, the lowest is replaced first
+    Affine   pub;
+    char     address[MINA_ADDRESS_LEN];
+    uint8_t  checksum[NVM_PUBKEY_CHECKSUM_LEN];
+} nvm_pubkey_entry_t;
+
+typedef struct nvm_pubkey_header_t {
+    uint8_t version;
+    uint8_t seed_fingerprint[NVM_SEED_FINGERPRINT_LEN];
+} nvm_pubkey_header_t;
+
 typedef struct internalStorage_t {
-    uint8_t initialized;
+    uint8_t             initialized;
+    nvm_pubkey_header_t cache_header;
+    nvm_pubkey_entry_t  cache[NVM_PUBKEY_CACHE_SIZE];
 } internalStorage_t;
 
 extern const internalStorage_t N_storage_real;
 #define N_storage (*(volatile internalStorage_t*) PIC(&N_storage_real))
 
+// Signing state (see sign_tx.c and sign_msg.c)
+//
+//     Transaction and message signing never run at the same time, so
+//     their state shares one union.  The owner is the command that took
+//     it with sign_state_take(), which wipes whatever the other one left.
+//     sign_state_release() wipes it only for its owner, so that clearing
+//     one command cannot wipe the other's state.
+#define SIGN_MSG_PREVIEW_LEN 64
+
+typedef enum {
+    SIGN_STATE_NONE = 0,
+    SIGN_STATE_TX,
+    SIGN_STATE_MSG
+} sign_state_owner_t;
+
+typedef struct sign_tx_state_t {
+    tx_t    tx;
+    ROInput roinput;
+    Keypair kp;
+    // The public key (on a cache miss) and then the signature are
+    // computed incrementally, never both at once
+    union {
+        PubkeyCtx pubkey;
+        SignCtx   sign;
+    } ctx;
+} sign_tx_state_t;
+
+typedef struct sign_msg_state_t {
+    msg_stream_t stream;
+    struct {
+        char network[8];
+        char address[MINA_ADDRESS_LEN];
+        char preview[SIGN_MSG_PREVIEW_LEN + 4];
+        char length[11];
+        char digest[2*CX_SHA256_SIZE + 1];
+    } ui;
+} sign_msg_state_t;
+
+typedef struct sign_state_t {
+    uint8_t owner;
+    union {
+        sign_tx_state_t  tx;
+        sign_msg_state_t msg;
+    } u;
+} sign_state_t;
+
+extern sign_state_t G_sign_state;
+
+void sign_state_take(const sign_state_owner_t owner);
+void sign_state_release(const sign_state_owner_t owner);
+
 void sendResponse(uint8_t tx, bool approve);
 
     // type            userid    x    y   w    h  str rad fill      fg        bg      fid iid  txt   touchparams...       ]
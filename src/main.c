@@ -18,16 +18,27 @@
 #include "utils.h"
 #include "get_address.h"
 #include "sign_tx.h"
+#include "sign_msg.h"
 #include "test_crypto.h"
+#include "benchmark.h"
+#include "stack_profile.h"
+#include "stats.h"
+#include "op_counters.h"
 #include "menu.h"
+#include "pubkey_cache.h"
 
 unsigned char G_io_seproxyhal_spi_buffer[IO_SEPROXYHAL_BUFFER_SIZE_B];
 
-#define CLA             0xe0
-#define INS_GET_CONF    0x01
-#define INS_GET_ADDR    0x02
-#define INS_SIGN_TX     0x03
-#define INS_TEST_CRYPTO 0x04
+#define CLA               0xe0
+#define INS_GET_CONF      0x01
+#define INS_GET_ADDR      0x02
+#define INS_SIGN_TX       0x03
+#define INS_TEST_CRYPTO   0x04
+#define INS_SIGN_MSG      0x05
+#define INS_BENCHMARK     0x06
+#define INS_STACK_PROFILE 0x07
+#define INS_GET_STATS     0x08
+#define INS_OP_COUNTS     0x09
 
 #define APDU_HEADER_LEN 5U
 #define OFFSET_CLA 0
@@ -54,6 +65,22 @@ void handleApdu(volatile unsigned int *flags, volatile unsigned int *tx,
                 THROW(0x6E00);
             }
 
+            #ifdef HAVE_STACK_PROFILING
+                stack_profile_begin(G_io_apdu_buffer[OFFSET_INS]);
+            #endif
+            #ifdef HAVE_APP_STATS
+                stats_command_begin(G_io_apdu_buffer[OFFSET_INS]);
+            #endif
+
+            // A transaction under review or a message being streamed is
+            // abandoned by any other command
+            if (G_io_apdu_buffer[OFFSET_INS] != INS_SIGN_TX) {
+                sign_tx_clear();
+            }
+            if (G_io_apdu_buffer[OFFSET_INS] != INS_SIGN_MSG) {
+                sign_msg_clear();
+            }
+
             switch (G_io_apdu_buffer[OFFSET_INS]) {
                 case INS_GET_CONF:
                     G_io_apdu_buffer[0] = LEDGER_MAJOR_VERSION;
@@ -77,6 +104,13 @@ void handleApdu(volatile unsigned int *flags, volatile unsigned int *tx,
                                    dataLength, flags);
                     break;
 
+                case INS_SIGN_MSG:
+                    handle_sign_msg(G_io_apdu_buffer[OFFSET_P1],
+                                    G_io_apdu_buffer[OFFSET_P2],
+                                    G_io_apdu_buffer + OFFSET_CDATA,
+                                    dataLength, flags);
+                    break;
+
                 #ifdef HAVE_CRYPTO_TESTS
                     case INS_TEST_CRYPTO:
                         handle_test_crypto(G_io_apdu_buffer[OFFSET_P1],
@@ -86,6 +120,46 @@ void handleApdu(volatile unsigned int *flags, volatile unsigned int *tx,
                         break;
                 #endif
 
+                #ifdef HAVE_BENCHMARKS
+                    case INS_BENCHMARK:
+                        *tx = handle_benchmark(G_io_apdu_buffer[OFFSET_P1],
+                                               G_io_apdu_buffer[OFFSET_P2],
+                                               G_io_apdu_buffer + OFFSET_CDATA,
+                                               dataLength);
+                        THROW(0x9000);
+                        break;
+                #endif
+
+                #ifdef HAVE_STACK_PROFILING
+                    case INS_STACK_PROFILE:
+                        *tx = handle_stack_profile(G_io_apdu_buffer[OFFSET_P1],
+                                                   G_io_apdu_buffer[OFFSET_P2],
+                                                   G_io_apdu_buffer + OFFSET_CDATA,
+                                                   dataLength);
+                        THROW(0x9000);
+                        break;
+                #endif
+
+                #ifdef HAVE_APP_STATS
+                    case INS_GET_STATS:
+                        *tx = handle_get_stats(G_io_apdu_buffer[OFFSET_P1],
+                                               G_io_apdu_buffer[OFFSET_P2],
+                                               G_io_apdu_buffer + OFFSET_CDATA,
+                                               dataLength);
+                        THROW(0x9000);
+                        break;
+                #endif
+
+                #ifdef HAVE_OP_COUNTERS
+                    case INS_OP_COUNTS:
+                        *tx = handle_op_counts(G_io_apdu_buffer[OFFSET_P1],
+                                               G_io_apdu_buffer[OFFSET_P2],
+                                               G_io_apdu_buffer + OFFSET_CDATA,
+                                               dataLength);
+                        THROW(0x9000);
+                        break;
+                #endif
+
                 default:
                     THROW(0x6D00);
                     break;
@@ -115,6 +189,10 @@ void handleApdu(volatile unsigned int *flags, volatile unsigned int *tx,
             G_io_apdu_buffer[*tx] = sw >> 8;
             G_io_apdu_buffer[*tx + 1] = sw;
             *tx += 2;
+
+            #ifdef HAVE_APP_STATS
+                stats_command_end();
+            #endif
         }
         FINALLY {
         }
@@ -239,6 +317,15 @@ unsigned char io_event(unsigned char channel) {
                 }
             #endif // TARGET_NANOX
             });
+
+            #ifdef HAVE_APP_STATS
+                stats_tick();
+            #endif
+
+            // Advance signature precomputation while the user reviews and
+            // expire an abandoned message
+            sign_tx_precompute();
+            sign_msg_tick();
             break;
     }
 
@@ -280,6 +367,7 @@ unsigned short io_exchange_al(unsigned char channel, unsigned short tx_len) {
 
 
 void app_exit(void) {
+    pubkey_cache_clear();
 
     BEGIN_TRY_L(exit) {
         TRY_L(exit) {
@@ -294,9 +382,8 @@ void app_exit(void) {
 
 void nv_app_state_init(void) {
     if (N_storage.initialized != 0x01) {
-        internalStorage_t storage;
-        storage.initialized = 0x01;
-        nvm_write((internalStorage_t*)&N_storage, (void*)&storage, sizeof(internalStorage_t));
+        uint8_t initialized = 0x01;
+        nvm_write((void*)&N_storage.initialized, (void*)&initialized, sizeof(initialized));
     }
 }
 
@@ -1,4 +1,11 @@
 #include "menu.h"
+#include "pubkey_cache.h"
+
+static void app_quit(void)
+{
+    pubkey_cache_clear();
+    os_sched_exit(-1);
+}
 
 #ifdef HAVE_ON_DEVICE_UNIT_TESTS
 UX_STEP_NOCB(
@@ -29,7 +36,7 @@ UX_STEP_NOCB(
 UX_STEP_VALID(
     ux_idle_flow_3_step,
     pb,
-    os_sched_exit(-1),
+    app_quit(),
     {
       &C_icon_dashboard_x,
       "Quit",
@@ -0,0 +1,218 @@
+#include <string.h>
+
+#include "msg_stream.h"
+
+void msg_stream_clear(msg_stream_t *s)
+{
+    // Clear nonce from memory
+    explicit_bzero(s, sizeof(*s));
+}
+
+static void derive_update(msg_stream_t *s, const uint8_t *bits, const size_t nbits)
+{
+    uint8_t packed[MSG_STREAM_PACK_STEP + 1];
+    size_t  len = roinput_pack_bits(&s->u.derive.packer, packed, bits, nbits);
+
+    cx_hash(&s->u.derive.blake2b.header, 0, packed, len, NULL, 0);
+    explicit_bzero(packed, sizeof(packed));
+}
+
+static void derive_update_field(msg_stream_t *s, const Field a)
+{
+    // Mina field elements are little endian
+    uint8_t le[FIELD_BYTES];
+    for (size_t i = 0; i < FIELD_BYTES; i++) {
+        le[i] = a[FIELD_BYTES - i - 1];
+    }
+
+    derive_update(s, le, FIELD_BITS);
+    explicit_bzero(le, sizeof(le));
+}
+
+static void derive_final(msg_stream_t *s)
+{
+    uint8_t packed[1];
+    size_t  len;
+    Affine  r;
+    Scalar  priv;
+
+    // k = blake2b(pub.x, pub.y, msg, sk, network_id)
+    BEGIN_TRY {
+        TRY {
+            generate_private_key(priv, s->account);
+            derive_update_field(s, priv);
+        }
+        FINALLY {
+            explicit_bzero(priv, sizeof(priv));
+        }
+        END_TRY;
+    }
+    derive_update(s, &s->network_id, 8);
+
+    len = roinput_pack_flush(&s->u.derive.packer, packed);
+    cx_hash(&s->u.derive.blake2b.header, 0, packed, len, NULL, 0);
+    cx_hash(&s->u.derive.blake2b.header, CX_LAST, NULL, 0, s->k, sizeof(s->k));
+    scalar_from_digest(s->k);
+
+    // r = k*g
+    generate_pubkey(&r, s->k);
+    field_copy(s->rx, r.x);
+    if (field_is_odd(r.y)) {
+        // k = -k
+        Scalar tmp;
+        scalar_copy(tmp, s->k);
+        scalar_negate(s->k, tmp);
+        explicit_bzero(tmp, sizeof(tmp));
+    }
+}
+
+static void hash_absorb(msg_stream_t *s, const Field a)
+{
+    // Poseidon absorbs two field elements per permutation
+    field_copy(s->u.hash.pending[s->u.hash.pending_len], a);
+    s->u.hash.pending_len += 1;
+    if (s->u.hash.pending_len == ARRAY_LEN(s->u.hash.pending)) {
+        poseidon_update(s->u.hash.sponge, s->u.hash.pending, s->u.hash.pending_len);
+        s->u.hash.pending_len = 0;
+    }
+}
+
+static void hash_final(msg_stream_t *s)
+{
+    Field chunk;
+
+    // e = poseidon(pub.x, pub.y, r.x, msg)
+    if (roinput_field_pack_flush(&s->u.hash.packer, chunk)) {
+        hash_absorb(s, chunk);
+    }
+    if (s->u.hash.pending_len > 0) {
+        poseidon_update(s->u.hash.sponge, s->u.hash.pending, s->u.hash.pending_len);
+    }
+    poseidon_digest(s->e, s->u.hash.sponge);
+}
+
+// Starts the derive pass of a len byte message
+void msg_stream_init(msg_stream_t *s, const uint32_t account, const uint8_t network_id,
+                     const uint32_t len, const Affine *pub)
+{
+    msg_stream_clear(s);
+    s->account = account;
+    s->network_id = network_id;
+    s->len = len;
+    memcpy(&s->pub, pub, sizeof(s->pub));
+
+    cx_sha256_init(&s->sha);
+    cx_blake2b_init(&s->u.derive.blake2b, 256);
+    roinput_packer_init(&s->u.derive.packer);
+    derive_update_field(s, s->pub.x);
+    derive_update_field(s, s->pub.y);
+    s->state = MSG_STREAM_DERIVE;
+}
+
+// Adds a chunk to the derive pass, computing k and r.x after the last one
+bool msg_stream_derive(msg_stream_t *s, const uint8_t *data, const size_t len)
+{
+    if (s->state != MSG_STREAM_DERIVE || len > s->len - s->received) {
+        return false;
+    }
+
+    cx_hash(&s->sha.header, 0, data, len, NULL, 0);
+    for (size_t i = 0; i < len; i += MSG_STREAM_PACK_STEP) {
+        size_t n = len - i < MSG_STREAM_PACK_STEP ? len - i : MSG_STREAM_PACK_STEP;
+        derive_update(s, data + i, 8*n);
+    }
+    s->received += len;
+
+    if (s->received == s->len) {
+        derive_final(s);
+        cx_hash(&s->sha.header, CX_LAST, NULL, 0, s->digest, sizeof(s->digest));
+        s->state = MSG_STREAM_COMMITTED;
+    }
+
+    return true;
+}
+
+// Starts the hash pass, once the derive pass is complete
+bool msg_stream_hash_init(msg_stream_t *s)
+{
+    if (s->state != MSG_STREAM_COMMITTED) {
+        return false;
+    }
+
+    cx_sha256_init(&s->sha);
+    poseidon_init(s->u.hash.sponge, s->network_id);
+    s->u.hash.pending_len = 0;
+    roinput_field_packer_init(&s->u.hash.packer);
+    hash_absorb(s, s->pub.x);
+    hash_absorb(s, s->pub.y);
+    hash_absorb(s, s->rx);
+    s->received = 0;
+    s->state = MSG_STREAM_HASH;
+
+    return true;
+}
+
+// Adds a chunk to the hash pass, computing e after the last one.  Fails if
+// the message differs from the one of the derive pass.
+bool msg_stream_hash(msg_stream_t *s, const uint8_t *data, const size_t len)
+{
+    if (s->state != MSG_STREAM_HASH || len > s->len - s->received) {
+        return false;
+    }
+
+    cx_hash(&s->sha.header, 0, data, len, NULL, 0);
+    for (size_t offset = 0; offset < 8*len;) {
+        Field chunk;
+        bool  ready;
+        offset += roinput_field_pack_bits(&s->u.hash.packer, chunk, &ready, data, offset, 8*len - offset);
+        if (ready) {
+            hash_absorb(s, chunk);
+        }
+    }
+    s->received += len;
+
+    if (s->received < s->len) {
+        return true;
+    }
+
+    hash_final(s);
+
+    // Both passes must have seen the same message
+    uint8_t digest[CX_SHA256_SIZE];
+    cx_hash(&s->sha.header, CX_LAST, NULL, 0, digest, sizeof(digest));
+    if (memcmp(digest, s->digest, sizeof(digest)) != 0) {
+        return false;
+    }
+    s->state = MSG_STREAM_DONE;
+
+    return true;
+}
+
+// Computes the signature once both passes are complete and clears the stream
+bool msg_stream_sign(msg_stream_t *s, Signature *sig)
+{
+    Scalar priv, tmp;
+
+    if (s->state != MSG_STREAM_DONE) {
+        msg_stream_clear(s);
+        return false;
+    }
+
+    // s = k + e*sk
+    BEGIN_TRY {
+        TRY {
+            generate_private_key(priv, s->account);
+            scalar_mul(tmp, s->e, priv);
+            field_copy(sig->rx, s->rx);
+            scalar_add(sig->s, s->k, tmp);
+        }
+        FINALLY {
+            explicit_bzero(priv, sizeof(priv));
+            explicit_bzero(tmp, sizeof(tmp));
+            msg_stream_clear(s);
+        }
+        END_TRY;
+    }
+
+    return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "crypto.h"
+#include "poseidon.h"
+#include "random_oracle_input.h"
+
+// Streamed message signing
+//
+//     The message is streamed twice because the nonce
+//
+//         k = blake2b(pub.x, pub.y, msg, sk, network_id)
+//
+//     must be known before the challenge
+//
+//         e = poseidon(pub.x, pub.y, r.x, msg)
+//
+//     can be computed.  Neither pass buffers the message: its bits are
+//     packed straight into the BLAKE2b and Poseidon states, so its length
+//     is not bounded by RAM (sign_msg.c bounds it by SIGN_MSG_MAX_LEN).
+//     The SHA-256 of both passes must match, so that k is never used
+//     with a different message.  The signature is the one sign()
+//     computes over an ROInput holding only the message bytes.
+
+#define MSG_STREAM_PACK_STEP 32 // Message bytes packed per blake2b update
+
+typedef enum {
+    MSG_STREAM_IDLE = 0,
+    MSG_STREAM_DERIVE,    // Receiving the message for k
+    MSG_STREAM_COMMITTED, // k and r.x are known
+    MSG_STREAM_HASH,      // Receiving the message for e
+    MSG_STREAM_DONE       // e is known
+} msg_stream_state_t;
+
+typedef struct {
+    uint8_t     state;
+    uint8_t     network_id;
+    uint32_t    account;
+    uint32_t    len;      // Message length
+    uint32_t    received; // Message bytes received in the current pass
+    Affine      pub;
+    Scalar      k;
+    Field       rx;
+    Scalar      e;
+    cx_sha256_t sha;
+    uint8_t     digest[CX_SHA256_SIZE];
+    union {
+        struct {
+            cx_blake2b_t  blake2b;
+            ROInputPacker packer;
+        } derive;
+        struct {
+            State              sponge;
+            Field              pending[2];
+            size_t             pending_len;
+            ROInputFieldPacker packer;
+        } hash;
+    } u;
+} msg_stream_t;
+
+void msg_stream_init(msg_stream_t *s, const uint32_t account, const uint8_t network_id,
+                     const uint32_t len, const Affine *pub);
+bool msg_stream_derive(msg_stream_t *s, const uint8_t *data, const size_t len);
+bool msg_stream_hash_init(msg_stream_t *s);
+bool msg_stream_hash(msg_stream_t *s, const uint8_t *data, const size_t len);
+bool msg_stream_sign(msg_stream_t *s, Signature *sig);
+void msg_stream_clear(msg_stream_t *s);
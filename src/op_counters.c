@@ -0,0 +1,60 @@
+#include <string.h>
+
+#include "op_counters.h"
+#include "benchmark.h"
+#include "crypto.h"
+#include "globals.h"
+
+#ifdef HAVE_OP_COUNTERS
+
+#define OP_COUNTER_NAME(id, name) name,
+
+#define OP_NAME_LEN 24 // includes null-byte
+
+uint32_t G_op_counts[OP_COUNTER_COUNT];
+
+// Fixed size so that the table holds no pointers
+static const char OP_NAMES[OP_COUNTER_COUNT][OP_NAME_LEN] = {
+    OP_COUNTERS(OP_COUNTER_NAME)
+};
+
+const char *op_counter_name(const uint8_t op)
+{
+    if (op >= OP_COUNTER_COUNT) {
+        return NULL;
+    }
+    return OP_NAMES[op];
+}
+
+void op_counters_reset(void)
+{
+    memset(G_op_counts, 0, sizeof(G_op_counts));
+}
+
+uint8_t handle_op_counts(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                         uint8_t dataLength)
+{
+    UNUSED(p2);
+    UNUSED(dataBuffer);
+
+    const char *name = bench_name(p1);
+    if (!name || dataLength != 0) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    op_counters_reset();
+    bench_run(p1, 1);
+
+    uint8_t tx = 0;
+    memmove(G_io_apdu_buffer + tx, name, BENCH_NAME_LEN);
+    tx += BENCH_NAME_LEN;
+    for (size_t i = 0; i < OP_COUNTER_COUNT; i++) {
+        G_io_apdu_buffer[tx++] = G_op_counts[i] >> 24;
+        G_io_apdu_buffer[tx++] = G_op_counts[i] >> 16;
+        G_io_apdu_buffer[tx++] = G_op_counts[i] >> 8;
+        G_io_apdu_buffer[tx++] = G_op_counts[i];
+    }
+    return tx;
+}
+
+#endif
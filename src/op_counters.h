@@ -0,0 +1,68 @@
+// Crypto operation counters
+//
+//     Profiling instrumentation (HAVE_OP_COUNTERS) that counts calls to
+//     the field, scalar and group routines of crypto.c and to the Poseidon
+//     permutation.  Nested calls are counted too, so field_mul includes the
+//     multiplications done inside group_add.  Exact counts, unlike timings
+//     in the emulator, compare algorithmic changes reliably.
+//
+//     The counts of a benchmark case (benchmark.h) run once are printed by
+//     crypto_ops on the host and returned by INS_OP_COUNTS on the device.
+
+#pragma once
+
+#include <stdint.h>
+
+#define OP_COUNTERS(X)                                   \
+    X(OP_FIELD_ADD,             "field_add")             \
+    X(OP_FIELD_SUB,             "field_sub")             \
+    X(OP_FIELD_MUL,             "field_mul")             \
+    X(OP_FIELD_SQ,              "field_sq")              \
+    X(OP_FIELD_INV,             "field_inv")             \
+    X(OP_FIELD_NEGATE,          "field_negate")          \
+    X(OP_FIELD_POW,             "field_pow")             \
+    X(OP_SCALAR_ADD,            "scalar_add")            \
+    X(OP_SCALAR_SUB,            "scalar_sub")            \
+    X(OP_SCALAR_MUL,            "scalar_mul")            \
+    X(OP_SCALAR_SQ,             "scalar_sq")             \
+    X(OP_SCALAR_NEGATE,         "scalar_negate")         \
+    X(OP_SCALAR_POW,            "scalar_pow")            \
+    X(OP_GROUP_DBL,             "group_dbl")             \
+    X(OP_GROUP_ADD,             "group_add")             \
+    X(OP_GROUP_NEGATE,          "group_negate")          \
+    X(OP_GROUP_SCALAR_MUL,      "group_scalar_mul")      \
+    X(OP_GROUP_IS_ON_CURVE,     "group_is_on_curve")     \
+    X(OP_PROJECTIVE_DBL,        "projective_dbl")        \
+    X(OP_PROJECTIVE_ADD,        "projective_add")        \
+    X(OP_PROJECTIVE_SCALAR_MUL, "projective_scalar_mul") \
+    X(OP_COZ_ADD,               "coz_add")               \
+    X(OP_COZ_ADDC,              "coz_addc")              \
+    X(OP_AFFINE_FROM_GROUP,     "affine_from_group")     \
+    X(OP_POSEIDON_PERMUTATION,  "poseidon_permutation")
+
+#define OP_COUNTER_ENUM(id, name) id,
+
+typedef enum {
+    OP_COUNTERS(OP_COUNTER_ENUM)
+    OP_COUNTER_COUNT
+} op_counter_t;
+
+#ifdef HAVE_OP_COUNTERS
+
+extern uint32_t G_op_counts[OP_COUNTER_COUNT];
+
+#define OP_COUNT(op) (G_op_counts[op]++)
+
+const char *op_counter_name(const uint8_t op);
+void op_counters_reset(void);
+
+// Runs benchmark case p1 once
+// Response: case name (BENCH_NAME_LEN) | count per operation (uint32 BE each)
+uint8_t handle_op_counts(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                         uint8_t dataLength);
+
+#else
+
+#define OP_COUNT(op) do {} while (0)
+
+#endif
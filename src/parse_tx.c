@@ -3,8 +3,13 @@
 
 #include "parse_tx.h"
 
-bool parse_tx(const uint8_t *dataBuffer, uint8_t dataLength, tx_t *tx, ui_t *ui)
+// The memo is decoded through the address buffer
+_Static_assert(MEMO_BYTES - 1 <= MINA_ADDRESS_LEN, "memo does not fit the address buffer");
+
+bool parse_tx(const uint8_t *dataBuffer, uint8_t dataLength, tx_t *tx)
 {
+    char address[MINA_ADDRESS_LEN];
+
     if (dataLength != 172) {
         return false;
     }
@@ -13,60 +18,53 @@ bool parse_tx(const uint8_t *dataBuffer, uint8_t dataLength, tx_t *tx, ui_t *ui)
     tx->account = read_uint32_be(dataBuffer);
 
     // 4-58: from_address
-    memcpy(ui->from, dataBuffer + 4, MINA_ADDRESS_LEN - 1);
-    ui->from[MINA_ADDRESS_LEN - 1] = '\0';
-    if (!validate_address(ui->from)) {
+    memcpy(address, dataBuffer + 4, MINA_ADDRESS_LEN - 1);
+    address[MINA_ADDRESS_LEN - 1] = '\0';
+    if (!decode_address(&tx->tx.source_pk, address)) {
         return false;
     }
-    read_public_key_compressed(&tx->tx.source_pk, ui->from);
 
     // Always the same as from for sent-payment and delegate txs
-    read_public_key_compressed(&tx->tx.fee_payer_pk, ui->from);
+    tx->tx.fee_payer_pk = tx->tx.source_pk;
 
     // 59-113: to
-    memcpy(ui->to, dataBuffer + 59, MINA_ADDRESS_LEN - 1);
-    ui->to[MINA_ADDRESS_LEN - 1] = '\0';
-    if (!validate_address(ui->to)) {
+    memcpy(address, dataBuffer + 59, MINA_ADDRESS_LEN - 1);
+    address[MINA_ADDRESS_LEN - 1] = '\0';
+    if (!decode_address(&tx->tx.receiver_pk, address)) {
         return false;
     }
-    read_public_key_compressed(&tx->tx.receiver_pk, ui->to);
 
     // 114-121: amount
     tx->tx.amount = read_uint64_be(dataBuffer + 114);
-    amount_to_string(ui->amount, sizeof(ui->amount), tx->tx.amount);
 
     // Set to 1 until token support is released
     tx->tx.token_id = 1;
 
     // 122-129: fee
     tx->tx.fee = read_uint64_be(dataBuffer + 122);
-    amount_to_string(ui->fee, sizeof(ui->fee), tx->tx.fee);
 
     // UI total
     if (tx->tx.amount + tx->tx.fee < tx->tx.amount) {
         // Overflow
         return false;
     }
-    amount_to_string(ui->total, sizeof(ui->total), tx->tx.amount + tx->tx.fee);
 
     // Set to 1 until token support is released
     tx->tx.fee_token = 1;
 
     // 130-133: nonce
     tx->tx.nonce = read_uint32_be(dataBuffer + 130);
-    value_to_string(ui->nonce, sizeof(ui->nonce), tx->tx.nonce);
 
     // 134-137: valid_until
     tx->tx.valid_until = read_uint32_be(dataBuffer + 134);
-    value_to_string(ui->valid_until, sizeof(ui->valid_until), tx->tx.valid_until);
 
     // Fixed until token support is released
     tx->tx.token_locked = false;
 
     // 138-169: memo
-    memcpy(ui->memo, dataBuffer + 138, sizeof(ui->memo) - 1);
-    ui->memo[sizeof(ui->memo) - 1] = '\0';
-    transaction_prepare_memo(tx->tx.memo, ui->memo);
+    memcpy(address, dataBuffer + 138, MEMO_BYTES - 2);
+    address[MEMO_BYTES - 2] = '\0';
+    transaction_prepare_memo(tx->tx.memo, address);
 
     // 170: tag
     tx->tag = *(dataBuffer + 170);
@@ -85,3 +83,73 @@ bool parse_tx(const uint8_t *dataBuffer, uint8_t dataLength, tx_t *tx, ui_t *ui)
 
     return true;
 }
+
+static bool copy_string(char *out, const size_t len, const char *s)
+{
+    size_t s_len = strlen(s);
+    if (s_len >= len) {
+        return false;
+    }
+    memcpy(out, s, s_len + 1);
+    return true;
+}
+
+// Formats one review screen field into out (TX_FIELD_MAX_LEN bytes fit
+// any field).  Only called for the step being displayed, so that no
+// formatted copy of the transaction is kept in RAM.
+bool format_tx_field(char *out, const size_t len, const tx_t *tx, const tx_field_t field)
+{
+    const bool delegation = tx->tag == DELEGATION_TX;
+
+    if (len == 0) {
+        return false;
+    }
+    out[0] = '\0';
+
+    switch (field) {
+        case TX_FIELD_TYPE:
+            return copy_string(out, len, delegation ? "Delegation" : "Payment");
+
+        case TX_FIELD_FROM_TITLE:
+            return copy_string(out, len, delegation ? "Delegator" : "Sender");
+
+        case TX_FIELD_FROM:
+            return len >= MINA_ADDRESS_LEN
+                   && encode_address(out, MINA_ADDRESS_LEN, &tx->tx.source_pk);
+
+        case TX_FIELD_TO_TITLE:
+            return copy_string(out, len, delegation ? "Delegate" : "Receiver");
+
+        case TX_FIELD_TO:
+            return len >= MINA_ADDRESS_LEN
+                   && encode_address(out, MINA_ADDRESS_LEN, &tx->tx.receiver_pk);
+
+        case TX_FIELD_AMOUNT:
+            return *amount_to_string(out, len, tx->tx.amount) != '\0';
+
+        case TX_FIELD_FEE:
+            return *amount_to_string(out, len, tx->tx.fee) != '\0';
+
+        case TX_FIELD_TOTAL:
+            // Cannot overflow, checked by parse_tx()
+            return *amount_to_string(out, len, tx->tx.amount + tx->tx.fee) != '\0';
+
+        case TX_FIELD_NONCE:
+            return value_to_string(out, len, tx->tx.nonce) != NULL;
+
+        case TX_FIELD_VALID_UNTIL:
+            return value_to_string(out, len, tx->tx.valid_until) != NULL;
+
+        case TX_FIELD_MEMO:
+            // Prepared memo: 0x01 | length | bytes
+            if (tx->tx.memo[1] >= len) {
+                return false;
+            }
+            memcpy(out, tx->tx.memo + 2, tx->tx.memo[1]);
+            out[tx->tx.memo[1]] = '\0';
+            return true;
+
+        default:
+            return false;
+    }
+}
@@ -16,18 +16,23 @@ typedef struct {
     uint8_t     tag;
 } tx_t;
 
-typedef struct {
-    char from[MINA_ADDRESS_LEN];
-    char to[MINA_ADDRESS_LEN];
-    char amount[32];
-    char fee[32];
-    char total[32];
-    char nonce[32];
-    char valid_until[32];
-    char memo[MEMO_BYTES - 1];
-    char type[11];
-    char from_title[10];
-    char to_title[9];
-} ui_t;
+// Review screen fields, formatted on demand from the raw values in tx_t
+typedef enum {
+    TX_FIELD_TYPE = 0,
+    TX_FIELD_FROM_TITLE,
+    TX_FIELD_FROM,
+    TX_FIELD_TO_TITLE,
+    TX_FIELD_TO,
+    TX_FIELD_AMOUNT,
+    TX_FIELD_FEE,
+    TX_FIELD_TOTAL,
+    TX_FIELD_NONCE,
+    TX_FIELD_VALID_UNTIL,
+    TX_FIELD_MEMO,
+    TX_FIELD_COUNT
+} tx_field_t;
+
+#define TX_FIELD_MAX_LEN MINA_ADDRESS_LEN // includes null-byte
 
-bool parse_tx(const uint8_t *dataBuffer, uint8_t dataLength, tx_t *tx, ui_t *ui);
+bool parse_tx(const uint8_t *dataBuffer, uint8_t dataLength, tx_t *tx);
+bool format_tx_field(char *out, const size_t len, const tx_t *tx, const tx_field_t field);
@@ -30,1398 +30,14 @@
 
 #include "crypto.h"
 #include "poseidon.h"
+#include "stats.h"
+#include "op_counters.h"
 
-// Round constants Pasta Fp (first 64)
-static const Field round_keys[ROUNDS][SPONGE_SIZE] = {
-    {
-        {
-            0x02, 0xf9, 0xda, 0xda, 0xbb, 0xc9, 0x91, 0xf8,
-            0xd6, 0x91, 0xdc, 0x62, 0xfe, 0xa5, 0xf8, 0xae,
-            0x37, 0xb7, 0x6e, 0xfe, 0x51, 0x69, 0xa9, 0xb0,
-            0xcc, 0x92, 0xa4, 0x82, 0x0c, 0xcb, 0x53, 0x78
-        },
-        {
-            0x17, 0x83, 0xbe, 0xc6, 0xc3, 0x57, 0x0a, 0x73,
-            0x3c, 0x43, 0x95, 0x3d, 0x95, 0x84, 0xb2, 0x29,
-            0xa9, 0x73, 0x7a, 0x36, 0x29, 0xf1, 0xd0, 0xda,
-            0xb0, 0xb7, 0x86, 0x65, 0x58, 0x0b, 0x88, 0xe5
-        },
-        {
-            0x28, 0xc0, 0x1d, 0xf6, 0x66, 0x6b, 0x04, 0x19,
-            0x6c, 0xf0, 0x2a, 0xf0, 0x39, 0x07, 0x56, 0xbb,
-            0xa8, 0xec, 0xfe, 0x80, 0x10, 0x6e, 0x3f, 0x56,
-            0x37, 0x7e, 0xad, 0x89, 0x57, 0x34, 0x0c, 0x7b
-        }
-    },
-    {
-        {
-            0x0c, 0xd1, 0x02, 0xba, 0xdb, 0x12, 0x4e, 0xbe,
-            0x9c, 0x73, 0x58, 0x49, 0x4b, 0xd7, 0xfa, 0x35,
-            0x92, 0x8b, 0x7c, 0x09, 0x54, 0xbb, 0xf2, 0x5f,
-            0x00, 0xf9, 0x5d, 0xf0, 0xa6, 0x39, 0x92, 0xb4
-        },
-        {
-            0x02, 0x0f, 0x17, 0x31, 0xee, 0xf7, 0xb4, 0x19,
-            0x0a, 0x40, 0xda, 0xcf, 0x31, 0x75, 0x7c, 0xc3,
-            0x9b, 0xd1, 0x67, 0x33, 0xe1, 0x8d, 0x5f, 0x62,
-            0x47, 0x41, 0x75, 0x7b, 0xfd, 0x7a, 0x51, 0xd5
-        },
-        {
-            0x1e, 0x33, 0x39, 0xed, 0xe4, 0xca, 0x03, 0x04,
-            0xd2, 0xfd, 0xad, 0xf8, 0x4d, 0x09, 0x7d, 0x0b,
-            0xdd, 0x37, 0x0e, 0x0a, 0xea, 0xa4, 0x9d, 0x68,
-            0xdb, 0x98, 0xfd, 0xe0, 0x8c, 0xdb, 0xdf, 0x52
-        }
-    },
-    {
-        {
-            0x0d, 0x6f, 0x06, 0x78, 0x38, 0xfc, 0xa7, 0x0a,
-            0x3a, 0x82, 0xd8, 0xf7, 0xed, 0x72, 0x34, 0x5b,
-            0x0d, 0x88, 0xd5, 0x92, 0xe2, 0xed, 0x2a, 0xa0,
-            0x3f, 0xde, 0xb2, 0x83, 0x71, 0xbd, 0xad, 0x60
-        },
-        {
-            0x3f, 0xb9, 0x17, 0xbe, 0x23, 0xbf, 0x82, 0xc2,
-            0xba, 0x39, 0x1b, 0x81, 0x70, 0x4e, 0xe5, 0xa7,
-            0xaa, 0xe2, 0xa9, 0xa7, 0xe8, 0xa7, 0x5d, 0x4b,
-            0x56, 0x78, 0xf0, 0x3b, 0x72, 0x9c, 0x75, 0x6f
-        },
-        {
-            0x33, 0xc7, 0x66, 0xac, 0x8e, 0x43, 0xad, 0x4f,
-            0x00, 0x01, 0xfe, 0x8a, 0xa2, 0x16, 0x50, 0x58,
-            0xd1, 0x01, 0x5a, 0x3b, 0xed, 0x8b, 0x2c, 0xf6,
-            0x57, 0xa0, 0xd2, 0x19, 0x51, 0xec, 0x69, 0x95
-        }
-    },
-    {
-        {
-            0x1e, 0x68, 0x70, 0xfd, 0x34, 0x27, 0x83, 0xff,
-            0x94, 0xd6, 0x30, 0xd4, 0xae, 0x7a, 0xbe, 0x1b,
-            0x7c, 0x98, 0x9b, 0x53, 0x3d, 0x12, 0x3f, 0xe0,
-            0x29, 0x0a, 0x2f, 0xe9, 0xaf, 0xa8, 0xb5, 0x8d
-        },
-        {
-            0x31, 0x84, 0x1a, 0xf1, 0x66, 0xbe, 0xe1, 0x19,
-            0xa8, 0xeb, 0xe6, 0x1e, 0x07, 0x9a, 0x2b, 0x96,
-            0x2c, 0xe0, 0x0c, 0x71, 0xe0, 0x26, 0x94, 0x84,
-            0x7a, 0x61, 0x11, 0x8c, 0x86, 0x34, 0xe0, 0xda
-        },
-        {
-            0x1c, 0xe2, 0x18, 0xcb, 0xe1, 0xcd, 0x33, 0xd3,
-            0xbd, 0x38, 0x02, 0xdd, 0xe9, 0x99, 0xd1, 0xfb,
-            0x33, 0xb3, 0x80, 0x6b, 0x1b, 0x22, 0x2d, 0x1f,
-            0x48, 0x8e, 0x65, 0x56, 0x16, 0xf6, 0xd5, 0xaf
-        }
-    },
-    {
-        {
-            0x33, 0x37, 0x72, 0xc1, 0x42, 0x46, 0xfd, 0x78,
-            0x2e, 0x07, 0x47, 0x8d, 0x2c, 0xc2, 0x3c, 0xdd,
-            0x5d, 0x9d, 0x66, 0x10, 0x33, 0x77, 0xc0, 0x01,
-            0x76, 0xa8, 0xf5, 0x36, 0xb6, 0xc1, 0xd1, 0xaa
-        },
-        {
-            0x04, 0x25, 0xe6, 0xa4, 0x7a, 0xf4, 0x4e, 0x68,
-            0x35, 0x2c, 0x07, 0x0a, 0xc0, 0x3c, 0x82, 0xe9,
-            0x77, 0x58, 0x63, 0x0e, 0x93, 0x76, 0xe9, 0x20,
-            0x7e, 0x85, 0xbc, 0xf2, 0xbc, 0x46, 0x19, 0x20
-        },
-        {
-            0x38, 0x43, 0x33, 0x42, 0xa8, 0x31, 0xc7, 0x1d,
-            0x96, 0x04, 0xa5, 0xf0, 0x45, 0x95, 0x30, 0x8a,
-            0x32, 0xf0, 0xed, 0x60, 0xc7, 0x6f, 0x3d, 0x8f,
-            0xb7, 0x5f, 0xb6, 0x77, 0xa3, 0x2b, 0x6e, 0xb6
-        }
-    },
-    {
-        {
-            0x04, 0xc7, 0x93, 0xfc, 0x2c, 0x4d, 0xb3, 0x19,
-            0xf2, 0x56, 0x58, 0x81, 0xf0, 0xee, 0xfb, 0xde,
-            0xde, 0x66, 0xef, 0x0b, 0x0d, 0x31, 0x4f, 0x95,
-            0x3e, 0x87, 0x30, 0x63, 0x10, 0x54, 0x32, 0x11
-        },
-        {
-            0x2a, 0x5c, 0x18, 0x12, 0x09, 0x48, 0x9b, 0xf9,
-            0x1a, 0x44, 0x7f, 0x18, 0x77, 0x29, 0xb2, 0xf1,
-            0x44, 0xce, 0xb9, 0xb8, 0x25, 0xef, 0x2f, 0x8a,
-            0xd9, 0x79, 0x12, 0x8f, 0x18, 0xad, 0x10, 0x5e
-        },
-        {
-            0x36, 0xe4, 0x78, 0x1a, 0x62, 0x9f, 0xcf, 0xe8,
-            0x48, 0x9d, 0xbf, 0x28, 0xf6, 0xa7, 0x52, 0x6a,
-            0x7f, 0xe5, 0x64, 0x0f, 0xbe, 0xc1, 0xb3, 0xcf,
-            0x5f, 0x15, 0x5a, 0xe7, 0x60, 0xf2, 0x6f, 0x41
-        }
-    },
-    {
-        {
-            0x23, 0x48, 0xbe, 0xd1, 0x43, 0x60, 0x72, 0x3e,
-            0x8c, 0x64, 0x3f, 0xd1, 0xf0, 0x22, 0xce, 0x15,
-            0x0f, 0xb3, 0x49, 0xe2, 0xa5, 0xdb, 0x5f, 0x62,
-            0xfb, 0xc0, 0x97, 0x05, 0x71, 0x3e, 0x55, 0x47
-        },
-        {
-            0x11, 0xb3, 0x71, 0xd0, 0xf4, 0xa9, 0xd4, 0xdc,
-            0x68, 0x8e, 0xe6, 0xb4, 0x3d, 0x5e, 0xd6, 0x25,
-            0x8a, 0x13, 0x7a, 0xa1, 0x6a, 0xc4, 0xe1, 0x90,
-            0xf4, 0xae, 0xa3, 0x05, 0x16, 0xd1, 0x3d, 0x5a
-        },
-        {
-            0x29, 0x8d, 0x37, 0xb8, 0x5d, 0xec, 0x2b, 0x7d,
-            0x54, 0x88, 0x77, 0x97, 0x5b, 0x2d, 0xe1, 0x98,
-            0x32, 0x7e, 0x97, 0x34, 0xbd, 0xcd, 0xca, 0x9a,
-            0x1b, 0xd2, 0x65, 0x71, 0x21, 0xfb, 0x8e, 0xbb
-        }
-    },
-    {
-        {
-            0x2a, 0xe8, 0xb1, 0x48, 0x3a, 0xf5, 0xeb, 0x5c,
-            0x75, 0x4a, 0xd6, 0xa5, 0x19, 0xb2, 0x14, 0xce,
-            0x67, 0xc7, 0x72, 0xad, 0x75, 0x37, 0xdb, 0xd6,
-            0x07, 0x17, 0x49, 0x20, 0x56, 0x42, 0x1f, 0x43
-        },
-        {
-            0x1e, 0x30, 0x50, 0x26, 0x1e, 0x80, 0x37, 0x2f,
-            0xa5, 0x83, 0x0b, 0x0a, 0x6f, 0x11, 0x9c, 0xf3,
-            0xc4, 0xe4, 0xdd, 0xaa, 0x8f, 0x58, 0x53, 0x10,
-            0xa0, 0xc4, 0x88, 0xd8, 0x50, 0xd6, 0x53, 0xbf
-        },
-        {
-            0x1f, 0x28, 0xf3, 0xd4, 0x24, 0x2e, 0x8d, 0xfe,
-            0x21, 0x20, 0x1b, 0x6f, 0x28, 0xda, 0xac, 0xb1,
-            0xd9, 0x15, 0x9c, 0xbd, 0xbe, 0x2a, 0x26, 0xe6,
-            0x18, 0xca, 0x34, 0x99, 0x99, 0xde, 0x7c, 0x5d
-        }
-    },
-    {
-        {
-            0x1d, 0x46, 0x9a, 0x8e, 0xee, 0xb6, 0x75, 0x77,
-            0x3d, 0x9e, 0x91, 0x64, 0xc9, 0x4a, 0xed, 0xa3,
-            0x55, 0x68, 0x1f, 0xca, 0xcd, 0x87, 0xbd, 0x25,
-            0xfb, 0x68, 0x8d, 0x81, 0x6d, 0xd5, 0x02, 0x34
-        },
-        {
-            0x38, 0xd6, 0xec, 0xd1, 0x01, 0xeb, 0x00, 0x8b,
-            0xc3, 0xd9, 0x4b, 0x9f, 0x84, 0x0c, 0x68, 0xf5,
-            0xc9, 0x11, 0x87, 0x73, 0x03, 0xf0, 0x84, 0xf0,
-            0xf7, 0x2a, 0x04, 0xd5, 0x1f, 0xae, 0x0e, 0xad
-        },
-        {
-            0x3b, 0x65, 0xf8, 0xd1, 0xd6, 0x3b, 0xd4, 0xc2,
-            0x11, 0xe9, 0x65, 0x8a, 0xeb, 0x90, 0x98, 0x73,
-            0xd0, 0x74, 0xdf, 0x4b, 0xf8, 0xbb, 0x8b, 0x11,
-            0xcd, 0xbc, 0xb9, 0x2e, 0x17, 0x26, 0x57, 0xcd
-        }
-    },
-    {
-        {
-            0x34, 0xcf, 0x76, 0xf0, 0x34, 0x65, 0x7b, 0x1f,
-            0xa7, 0xc8, 0x3b, 0x6c, 0x8a, 0xaa, 0x9e, 0x65,
-            0x46, 0x6a, 0xae, 0xe1, 0xca, 0xd4, 0x33, 0xd7,
-            0xc0, 0x9a, 0x5c, 0x73, 0x61, 0xc8, 0x91, 0x09
-        },
-        {
-            0x25, 0x42, 0xcd, 0x14, 0x60, 0xd8, 0x69, 0x40,
-            0x02, 0x26, 0xd2, 0xd6, 0xc1, 0x26, 0xa4, 0x81,
-            0x24, 0x04, 0xcc, 0x7e, 0x00, 0x7a, 0x73, 0x85,
-            0x9d, 0xdd, 0xc6, 0xfc, 0x2e, 0x19, 0xc1, 0xe8
-        },
-        {
-            0x28, 0xc7, 0x56, 0x0c, 0x1e, 0xc8, 0x42, 0x17,
-            0x92, 0x68, 0xbc, 0xf3, 0x81, 0x3f, 0x4f, 0x4b,
-            0xe0, 0x5f, 0xa6, 0xe6, 0x00, 0xbb, 0xfb, 0x6d,
-            0xae, 0xd5, 0xb8, 0x62, 0x35, 0x82, 0x05, 0xed
-        }
-    },
-    {
-        {
-            0x25, 0x5b, 0x3e, 0x61, 0x38, 0x14, 0x6a, 0x37,
-            0xf7, 0x0c, 0xb9, 0xf8, 0xf4, 0xce, 0x44, 0xba,
-            0x6d, 0x7e, 0xb0, 0x8f, 0x09, 0x94, 0xa5, 0x37,
-            0xea, 0x6f, 0xf6, 0xb8, 0x41, 0x52, 0x58, 0x3f
-        },
-        {
-            0x34, 0xb6, 0x3e, 0xb1, 0x74, 0xec, 0x33, 0x4d,
-            0xae, 0x32, 0x41, 0x7f, 0x5c, 0xc2, 0x72, 0xf2,
-            0x17, 0x16, 0x65, 0xe3, 0x2d, 0x32, 0x3f, 0x6a,
-            0x58, 0xba, 0x76, 0x90, 0xac, 0x57, 0xcc, 0x28
-        },
-        {
-            0x35, 0xe0, 0xc2, 0xb6, 0x08, 0x54, 0x7a, 0xb6,
-            0x7f, 0x05, 0xec, 0xd6, 0x1f, 0x1a, 0xea, 0xea,
-            0xc0, 0x13, 0x9f, 0xff, 0xe7, 0x34, 0xfa, 0x07,
-            0x3c, 0x33, 0xea, 0x08, 0x7d, 0x1e, 0x1f, 0xbb
-        }
-    },
-    {
-        {
-            0x38, 0x11, 0x5c, 0x9f, 0x35, 0xb0, 0x3d, 0xcc,
-            0x03, 0x1a, 0x30, 0xd9, 0xbc, 0x4b, 0x1f, 0xf9,
-            0x38, 0x30, 0xd9, 0xe1, 0xed, 0xde, 0xd0, 0x22,
-            0xe0, 0x5d, 0x84, 0x3a, 0x2f, 0x03, 0x47, 0xe6
-        },
-        {
-            0x03, 0x49, 0x4b, 0x3e, 0xea, 0x9b, 0xd5, 0x53,
-            0x30, 0x03, 0xb3, 0xe5, 0x9a, 0x45, 0x5f, 0x35,
-            0x3b, 0x5e, 0xce, 0x83, 0xe7, 0x91, 0x34, 0x03,
-            0x3a, 0x22, 0x58, 0x0a, 0x05, 0x68, 0x5b, 0x5c
-        },
-        {
-            0x29, 0x3d, 0x81, 0x9a, 0xc2, 0x38, 0xe2, 0x33,
-            0x3c, 0x06, 0x4a, 0x81, 0x69, 0x55, 0xcf, 0xcb,
-            0xf3, 0xd5, 0x57, 0xa8, 0x17, 0x78, 0x5c, 0x51,
-            0x33, 0x49, 0xeb, 0x03, 0xc7, 0x21, 0xb7, 0x6e
-        }
-    },
-    {
-        {
-            0x29, 0xbc, 0xab, 0xb2, 0x3f, 0x2d, 0x09, 0xb8,
-            0x47, 0x5b, 0x95, 0x1f, 0x5b, 0xa2, 0xbb, 0x33,
-            0x8d, 0xae, 0x11, 0x94, 0x0b, 0x05, 0x57, 0x71,
-            0x8b, 0x63, 0xc4, 0x5e, 0x6c, 0x1e, 0xc9, 0xca
-        },
-        {
-            0x00, 0x65, 0x26, 0x48, 0xb3, 0x54, 0x88, 0x00,
-            0xe4, 0xc4, 0xe9, 0xa5, 0xbe, 0x98, 0xe2, 0x02,
-            0x71, 0x30, 0xf8, 0x3c, 0x2b, 0x57, 0xe3, 0xf1,
-            0xee, 0xa2, 0xee, 0x04, 0x29, 0x45, 0x30, 0x90
-        },
-        {
-            0x12, 0x87, 0x7b, 0x53, 0x82, 0x24, 0xe2, 0x35,
-            0xd9, 0x1d, 0x77, 0x66, 0x1f, 0x9e, 0x0c, 0x73,
-            0xd3, 0xd6, 0x73, 0x67, 0x85, 0x27, 0x69, 0x26,
-            0x8b, 0x6e, 0x79, 0x33, 0xe7, 0x53, 0x91, 0x18
-        }
-    },
-    {
-        {
-            0x09, 0x3c, 0x11, 0x5b, 0xb0, 0xf2, 0x88, 0x11,
-            0xa7, 0xa1, 0x1c, 0x04, 0x1e, 0xf5, 0x84, 0x7f,
-            0x4e, 0xc1, 0x1d, 0xd7, 0x87, 0x45, 0x7f, 0xfe,
-            0x97, 0x16, 0xb2, 0xa9, 0x96, 0xda, 0x3d, 0x6c
-        },
-        {
-            0x24, 0x34, 0xae, 0xdf, 0x50, 0x0c, 0xe5, 0x31,
-            0x4c, 0xce, 0x60, 0xf7, 0xd5, 0x40, 0x71, 0x01,
-            0x60, 0x34, 0x1e, 0xd7, 0xfe, 0x8f, 0xaa, 0xb2,
-            0xfc, 0xd2, 0xde, 0xef, 0x68, 0x73, 0x18, 0x29
-        },
-        {
-            0x12, 0x91, 0xb3, 0xe8, 0x1b, 0x69, 0xa2, 0xd7,
-            0xeb, 0x1b, 0x56, 0x6e, 0x4e, 0x22, 0xa2, 0x8b,
-            0x2a, 0x8a, 0xae, 0x13, 0xdc, 0x9b, 0x6f, 0xd5,
-            0x0c, 0x14, 0xca, 0x47, 0x89, 0x7a, 0x90, 0x5f
-        }
-    },
-    {
-        {
-            0x22, 0x20, 0x13, 0x37, 0x6f, 0x62, 0x83, 0xe3,
-            0xe6, 0x33, 0xf6, 0x96, 0x9e, 0xa0, 0x76, 0x41,
-            0xd5, 0x7e, 0x7d, 0xee, 0x49, 0x9a, 0xc3, 0xe8,
-            0x81, 0xee, 0x4e, 0x14, 0xd1, 0x42, 0x44, 0x99
-        },
-        {
-            0x09, 0x06, 0x7a, 0x14, 0x67, 0x76, 0xa1, 0x20,
-            0x55, 0xd0, 0x73, 0xe0, 0x32, 0x8a, 0xe1, 0xd4,
-            0x83, 0xa4, 0xc0, 0x0d, 0x89, 0xcc, 0x10, 0xd8,
-            0x0b, 0xdc, 0x2d, 0x67, 0x55, 0xf4, 0xd8, 0x89
-        },
-        {
-            0x3a, 0x40, 0xdc, 0x21, 0x98, 0xf8, 0x0b, 0x69,
-            0x0f, 0xf1, 0x67, 0x9b, 0xb0, 0x53, 0x8c, 0x75,
-            0xb3, 0xd7, 0x18, 0xa0, 0x28, 0x39, 0x20, 0xce,
-            0x8d, 0x39, 0xf1, 0x2d, 0x9c, 0xfa, 0x27, 0xab
-        }
-    },
-    {
-        {
-            0x15, 0x76, 0x53, 0x28, 0x89, 0xa8, 0xdd, 0x5d,
-            0xd7, 0xbc, 0x42, 0x84, 0x5f, 0x08, 0xf6, 0x3b,
-            0xac, 0xfb, 0x53, 0xd4, 0x08, 0x18, 0x38, 0x74,
-            0x2b, 0x15, 0x4b, 0xe8, 0x7b, 0x00, 0xb9, 0x34
-        },
-        {
-            0x3d, 0xb4, 0xef, 0x72, 0xbd, 0x8b, 0xd5, 0x85,
-            0x06, 0xed, 0x2e, 0x67, 0x70, 0x52, 0x0b, 0xfc,
-            0x13, 0x3b, 0x53, 0xd0, 0x95, 0xea, 0xf8, 0x20,
-            0xe4, 0x66, 0x85, 0x28, 0x93, 0x1d, 0xe9, 0xec
-        },
-        {
-            0x2d, 0x1e, 0x16, 0x87, 0xb8, 0xb9, 0x3e, 0x39,
-            0x8a, 0x98, 0x05, 0x11, 0x41, 0x60, 0x7f, 0x16,
-            0x92, 0xc7, 0x06, 0xd7, 0x02, 0x67, 0x00, 0x19,
-            0xeb, 0xdd, 0x2b, 0x72, 0x24, 0x7a, 0xd9, 0xba
-        }
-    },
-    {
-        {
-            0x32, 0x3e, 0x96, 0x76, 0xd5, 0x6b, 0xd5, 0x79,
-            0x06, 0xa4, 0x9e, 0x8f, 0x64, 0x29, 0x6b, 0x16,
-            0xa5, 0xab, 0x57, 0x58, 0x7c, 0x10, 0x92, 0xbd,
-            0x4f, 0x3d, 0x9f, 0xbc, 0x48, 0xd5, 0xbd, 0xaa
-        },
-        {
-            0x1b, 0x83, 0x09, 0x45, 0x0b, 0xc4, 0x50, 0x03,
-            0x89, 0xbf, 0xc6, 0xf7, 0x36, 0xaf, 0x14, 0x78,
-            0xd3, 0xa1, 0xea, 0xc5, 0x3d, 0xce, 0x59, 0x47,
-            0x3d, 0x7e, 0x68, 0x2e, 0xd2, 0x57, 0x58, 0xaf
-        },
-        {
-            0x3b, 0xeb, 0x7f, 0x00, 0x63, 0x01, 0x55, 0xff,
-            0x39, 0xe5, 0x31, 0x4b, 0xab, 0xba, 0x6a, 0xb0,
-            0x6f, 0xfd, 0xaa, 0x78, 0x6b, 0x7a, 0xdd, 0x69,
-            0xe9, 0x89, 0x57, 0x91, 0xb9, 0x05, 0x5b, 0xb7
-        }
-    },
-    {
-        {
-            0x1f, 0xe5, 0x85, 0x00, 0xa9, 0x14, 0x1b, 0x81,
-            0xfd, 0xac, 0xed, 0xf9, 0xfc, 0x56, 0xa9, 0xdb,
-            0x74, 0xad, 0x3e, 0x4b, 0x5a, 0xcf, 0x78, 0xbf,
-            0x8f, 0x01, 0xcd, 0x70, 0x44, 0x0f, 0x3c, 0xad
-        },
-        {
-            0x32, 0xaa, 0xd1, 0xdc, 0x3e, 0x6f, 0xe3, 0xbc,
-            0xac, 0x50, 0x4e, 0x2c, 0x1f, 0xd1, 0xb1, 0xd5,
-            0xd6, 0x7c, 0xcc, 0x44, 0x53, 0x49, 0x45, 0x95,
-            0xab, 0x54, 0xed, 0xdc, 0x36, 0x75, 0xb9, 0x68
-        },
-        {
-            0x07, 0xa3, 0x80, 0xf5, 0x95, 0xac, 0xad, 0x20,
-            0x4e, 0xa4, 0x5f, 0x40, 0x68, 0x77, 0x31, 0x5e,
-            0xd5, 0x04, 0xc7, 0x80, 0x44, 0xc1, 0x8c, 0x0f,
-            0x86, 0x7c, 0x0e, 0x50, 0xca, 0x17, 0x21, 0xcd
-        }
-    },
-    {
-        {
-            0x09, 0xfa, 0x52, 0xf7, 0xac, 0xb1, 0x00, 0x9c,
-            0x15, 0x41, 0x14, 0x74, 0x74, 0x11, 0xf2, 0xef,
-            0x09, 0x48, 0xb5, 0xa7, 0xb2, 0xba, 0x9f, 0xc7,
-            0x47, 0xbf, 0xfb, 0x97, 0x66, 0xba, 0x85, 0x89
-        },
-        {
-            0x28, 0x35, 0xd3, 0xee, 0x4c, 0xaa, 0x0b, 0x46,
-            0x51, 0x4e, 0xc4, 0x1c, 0x9f, 0x21, 0x96, 0xf5,
-            0xfd, 0xae, 0x2c, 0x68, 0xc4, 0x77, 0x10, 0xa4,
-            0x1f, 0x6e, 0xfd, 0x68, 0x86, 0x9c, 0x37, 0x6b
-        },
-        {
-            0x14, 0xe2, 0xd9, 0x7c, 0x0a, 0xbb, 0x87, 0x2d,
-            0x8e, 0xfe, 0x47, 0x5c, 0x9c, 0xcb, 0xdc, 0x09,
-            0x69, 0x47, 0x67, 0x91, 0x90, 0x87, 0xa5, 0x9d,
-            0x46, 0xb5, 0xa2, 0x26, 0xca, 0x29, 0xb9, 0x3a
-        }
-    },
-    {
-        {
-            0x07, 0x22, 0xe1, 0x11, 0x3d, 0x90, 0x32, 0x4e,
-            0x06, 0x82, 0x0f, 0xf8, 0x6d, 0xc1, 0x28, 0x0d,
-            0x74, 0x3f, 0x2a, 0x82, 0x88, 0xa1, 0x8b, 0x30,
-            0xb2, 0x6a, 0xf7, 0x5f, 0x13, 0x33, 0xe0, 0x86
-        },
-        {
-            0x20, 0xb7, 0x8c, 0xeb, 0x6e, 0x0d, 0xf0, 0x29,
-            0x2c, 0x43, 0xcd, 0xe8, 0xd5, 0x3d, 0xf0, 0xbc,
-            0x20, 0xc7, 0xc7, 0xfc, 0x6a, 0x66, 0xfd, 0xbd,
-            0x3f, 0x54, 0xd8, 0xdc, 0xe2, 0xba, 0x83, 0x96
-        },
-        {
-            0x32, 0xe1, 0x68, 0x96, 0x4b, 0xa2, 0x0a, 0x86,
-            0x3f, 0xd8, 0x4d, 0x46, 0xb4, 0x4b, 0xc8, 0x2f,
-            0xfc, 0x51, 0x74, 0xea, 0xd5, 0x95, 0xf3, 0x52,
-            0x53, 0xbc, 0x97, 0x2b, 0x8c, 0xd0, 0xee, 0x31
-        }
-    },
-    {
-        {
-            0x2e, 0x61, 0xcd, 0x35, 0xd9, 0xd9, 0x90, 0xf9,
-            0xf8, 0x71, 0xe9, 0x0b, 0x76, 0x89, 0x09, 0xd8,
-            0x83, 0x11, 0x73, 0x93, 0x21, 0xd8, 0x46, 0xf7,
-            0xaf, 0x89, 0x49, 0x4f, 0x89, 0x1b, 0xa4, 0xd3
-        },
-        {
-            0x2d, 0xed, 0x16, 0x08, 0x93, 0xae, 0x32, 0xd0,
-            0x74, 0xfb, 0x07, 0x00, 0xec, 0x13, 0x98, 0x91,
-            0x85, 0x43, 0xbf, 0x95, 0x10, 0x1c, 0x01, 0x44,
-            0x60, 0x4c, 0xc4, 0xd4, 0x53, 0x9f, 0x8b, 0x5c
-        },
-        {
-            0x16, 0x57, 0x7a, 0xe0, 0x73, 0xbe, 0x82, 0x23,
-            0x2c, 0x35, 0x88, 0x28, 0x54, 0x22, 0x27, 0x49,
-            0xe9, 0xd8, 0xe0, 0xa8, 0xfb, 0xbf, 0x70, 0x81,
-            0xee, 0x9c, 0x2b, 0x42, 0xa9, 0xf3, 0x09, 0xe5
-        }
-    },
-    {
-        {
-            0x18, 0x7e, 0x88, 0xba, 0x7c, 0xcc, 0xdf, 0x40,
-            0x57, 0xe2, 0x0f, 0xf2, 0xe0, 0x17, 0x75, 0x74,
-            0xd8, 0xc3, 0x47, 0x11, 0x91, 0x3f, 0xee, 0xbd,
-            0x5d, 0xab, 0x4f, 0x89, 0x5a, 0xf0, 0x05, 0xd3
-        },
-        {
-            0x0a, 0x60, 0xab, 0x41, 0xc1, 0x1f, 0x95, 0xfa,
-            0x60, 0x5f, 0x57, 0xc1, 0x0f, 0x8d, 0x34, 0xb8,
-            0x00, 0xb7, 0xd8, 0x15, 0x9e, 0x5f, 0x7b, 0x00,
-            0xa3, 0xb2, 0xcb, 0x5f, 0x20, 0x91, 0xa8, 0x46
-        },
-        {
-            0x29, 0x14, 0xe1, 0x88, 0x73, 0xf7, 0x37, 0x8e,
-            0xb2, 0x10, 0xb4, 0x93, 0xce, 0x39, 0x91, 0xac,
-            0x98, 0x08, 0xa9, 0xe9, 0xa4, 0xd4, 0x1e, 0x10,
-            0x4c, 0xfc, 0x2b, 0xac, 0xab, 0x72, 0xb6, 0x17
-        }
-    },
-    {
-        {
-            0x06, 0xc6, 0xf0, 0x1a, 0xa8, 0xca, 0x19, 0x0a,
-            0x0e, 0x95, 0x40, 0x9a, 0x41, 0x73, 0x85, 0x05,
-            0xc1, 0x30, 0x06, 0xcc, 0x00, 0x85, 0x34, 0xab,
-            0x8a, 0x68, 0xeb, 0xf9, 0xb7, 0x1d, 0x74, 0xe1
-        },
-        {
-            0x28, 0xef, 0x78, 0x8c, 0x20, 0x18, 0xea, 0xe1,
-            0x2c, 0x06, 0xb8, 0x2f, 0x19, 0x0c, 0xc9, 0x7e,
-            0x58, 0x0c, 0x3d, 0x3c, 0x56, 0x30, 0x85, 0x06,
-            0x8d, 0x0b, 0x62, 0xd6, 0x7b, 0xc6, 0x09, 0xaf
-        },
-        {
-            0x26, 0xd4, 0x5b, 0x1a, 0xa0, 0xe9, 0x72, 0x88,
-            0x61, 0x18, 0xfa, 0x56, 0xb5, 0x6e, 0x41, 0xdf,
-            0x4d, 0x3a, 0xcc, 0x76, 0x16, 0x85, 0xf5, 0xb2,
-            0x61, 0xff, 0xd0, 0x58, 0x20, 0x1c, 0x6a, 0xf6
-        }
-    },
-    {
-        {
-            0x39, 0xec, 0x87, 0xe4, 0xa9, 0x5d, 0xd9, 0x4e,
-            0x69, 0x30, 0xd7, 0x17, 0x22, 0xc6, 0xd1, 0xd7,
-            0xdf, 0x32, 0x9f, 0x29, 0x37, 0xcd, 0x15, 0x48,
-            0x34, 0x5d, 0x26, 0xb7, 0x67, 0xd6, 0x78, 0xba
-        },
-        {
-            0x10, 0xbf, 0xf0, 0xfc, 0xc6, 0x63, 0x26, 0x9e,
-            0x33, 0x76, 0xf4, 0x00, 0x5d, 0x19, 0x4d, 0xfd,
-            0x0f, 0xeb, 0xc1, 0xb3, 0x02, 0xe8, 0x07, 0xae,
-            0x79, 0x47, 0x65, 0x3a, 0x91, 0x0f, 0xb6, 0xed
-        },
-        {
-            0x2c, 0x58, 0xd0, 0xa4, 0x64, 0x6e, 0x33, 0xac,
-            0x9f, 0x63, 0x3d, 0x2c, 0x88, 0xa7, 0xac, 0xdb,
-            0x7a, 0x19, 0x2c, 0x23, 0xaa, 0x13, 0xf1, 0x13,
-            0x3b, 0x17, 0x8f, 0xad, 0xef, 0xf9, 0x3b, 0xd9
-        }
-    },
-    {
-        {
-            0x25, 0x5a, 0x12, 0xf7, 0x50, 0x5a, 0x81, 0xb7,
-            0x38, 0x7b, 0xbc, 0xaf, 0x2b, 0x69, 0xa0, 0x29,
-            0x83, 0xfc, 0xb1, 0xf0, 0x76, 0x0a, 0x5a, 0x35,
-            0x4a, 0xf7, 0x77, 0xac, 0x6f, 0x1b, 0x25, 0xb4
-        },
-        {
-            0x1e, 0xde, 0x0f, 0x41, 0xc9, 0x8e, 0x5a, 0x78,
-            0x9c, 0x12, 0xe1, 0x84, 0x9e, 0xa8, 0x32, 0x92,
-            0xfa, 0x0e, 0x2e, 0xc9, 0xe3, 0xc6, 0x09, 0x04,
-            0xd4, 0x0e, 0xa1, 0x29, 0xaa, 0x9b, 0xfc, 0x8d
-        },
-        {
-            0x37, 0xd6, 0xdd, 0xb1, 0x58, 0xb0, 0x7e, 0xee,
-            0x15, 0x9e, 0x3f, 0x53, 0x1d, 0xf6, 0x14, 0x29,
-            0x9d, 0xa7, 0x53, 0xea, 0x22, 0x7e, 0x2f, 0xfb,
-            0xf2, 0x70, 0xbc, 0x20, 0xb0, 0x51, 0x3b, 0xab
-        }
-    },
-    {
-        {
-            0x28, 0xf7, 0xcf, 0xe6, 0xa0, 0xb7, 0x6b, 0x75,
-            0xb8, 0xdb, 0xea, 0xc4, 0x3e, 0x03, 0x9b, 0xa1,
-            0xea, 0x12, 0x6a, 0xdd, 0xb9, 0x0e, 0xd9, 0xca,
-            0x84, 0x1c, 0x11, 0x67, 0xc2, 0xb8, 0xe6, 0xd4
-        },
-        {
-            0x32, 0xe1, 0xed, 0x2d, 0xbf, 0x09, 0x02, 0x6b,
-            0x61, 0x9f, 0x08, 0x9e, 0x04, 0x1d, 0x06, 0x28,
-            0x35, 0x42, 0x76, 0x38, 0x7e, 0x53, 0x0b, 0x05,
-            0xae, 0xeb, 0x86, 0x52, 0xf0, 0xcb, 0x20, 0xc5
-        },
-        {
-            0x3d, 0xb5, 0x4e, 0xb1, 0xd8, 0xc5, 0x28, 0x61,
-            0x11, 0xeb, 0x66, 0xc0, 0x2c, 0x2a, 0xee, 0x88,
-            0x6c, 0x89, 0x1f, 0x2d, 0x66, 0xe6, 0x35, 0xb9,
-            0x85, 0xee, 0x91, 0x5a, 0x0e, 0xff, 0x5d, 0xd9
-        }
-    },
-    {
-        {
-            0x02, 0x5c, 0x17, 0x8b, 0x22, 0x2b, 0xb3, 0x25,
-            0x14, 0x58, 0xea, 0xcd, 0x35, 0x93, 0xf1, 0x87,
-            0x16, 0x20, 0xce, 0x56, 0x10, 0x25, 0xd0, 0x33,
-            0xc4, 0xc2, 0xa1, 0x35, 0x4e, 0x92, 0xb2, 0xe2
-        },
-        {
-            0x26, 0x11, 0xa9, 0x44, 0x66, 0xf9, 0xef, 0x6e,
-            0x98, 0x5f, 0xa7, 0x2c, 0x1d, 0x2d, 0x2f, 0xbf,
-            0x05, 0x3c, 0xbe, 0xb6, 0xbe, 0x85, 0xd1, 0xc6,
-            0x4e, 0xf3, 0x57, 0xc2, 0xd4, 0x59, 0xdb, 0x54
-        },
-        {
-            0x24, 0x54, 0xb4, 0x29, 0x34, 0x01, 0x2f, 0xf7,
-            0x78, 0xe8, 0xe1, 0xe5, 0xc7, 0xc8, 0x19, 0xfe,
-            0xe2, 0xaf, 0x51, 0xfa, 0xdb, 0x59, 0x2e, 0xa7,
-            0xd0, 0x25, 0xc2, 0x5e, 0xc9, 0x2b, 0xe9, 0x80
-        }
-    },
-    {
-        {
-            0x3f, 0x40, 0x09, 0x2e, 0x86, 0xc6, 0xff, 0x92,
-            0x36, 0x97, 0x60, 0xf1, 0xae, 0x2a, 0xec, 0xda,
-            0x13, 0x06, 0x84, 0x44, 0x88, 0xf1, 0x57, 0x27,
-            0x1e, 0x7f, 0xb4, 0x67, 0x47, 0x83, 0xd6, 0x33
-        },
-        {
-            0x16, 0x60, 0xa3, 0xb2, 0x59, 0x9d, 0x67, 0xd0,
-            0x31, 0x08, 0x9b, 0xf3, 0x9d, 0xfb, 0x32, 0xd5,
-            0xf7, 0xc1, 0xf3, 0x9c, 0xc7, 0x62, 0xc1, 0x46,
-            0x24, 0xd4, 0x11, 0x3c, 0xb6, 0xe6, 0xfe, 0x9f
-        },
-        {
-            0x05, 0x30, 0xf1, 0x04, 0x5f, 0xfb, 0x5c, 0x20,
-            0xa9, 0xf1, 0x94, 0xc6, 0x4d, 0x1b, 0xff, 0xba,
-            0x49, 0xdf, 0xb7, 0x54, 0x41, 0x74, 0x93, 0x5a,
-            0x43, 0x7a, 0x32, 0x18, 0x5b, 0xa5, 0xe9, 0xd2
-        }
-    },
-    {
-        {
-            0x24, 0xbe, 0x84, 0xfe, 0x06, 0xb6, 0xe3, 0xdf,
-            0x8f, 0x63, 0xf2, 0x5b, 0xf8, 0x13, 0x2b, 0x99,
-            0x98, 0x01, 0x22, 0xbb, 0xb5, 0x7b, 0x42, 0x7d,
-            0xcb, 0x9c, 0xce, 0x48, 0xe9, 0xc2, 0x73, 0x24
-        },
-        {
-            0x05, 0x17, 0x22, 0x09, 0x04, 0x2e, 0xa9, 0x06,
-            0xe3, 0xff, 0x5e, 0xa1, 0xe8, 0x56, 0xc6, 0x43,
-            0xcb, 0xf6, 0x89, 0xe3, 0x63, 0xbf, 0xcd, 0x74,
-            0xec, 0x5a, 0x19, 0x63, 0x60, 0xfa, 0x6d, 0x88
-        },
-        {
-            0x3c, 0xd4, 0xad, 0x01, 0xb5, 0xce, 0xcc, 0xb9,
-            0xcb, 0x65, 0xac, 0x8f, 0xf4, 0x60, 0xcc, 0x9a,
-            0x4a, 0x01, 0xc3, 0xdc, 0xdc, 0xdf, 0x95, 0xeb,
-            0x13, 0x66, 0xd3, 0x16, 0x23, 0xd1, 0xc6, 0x11
-        }
-    },
-    {
-        {
-            0x14, 0xe9, 0xc2, 0xef, 0x46, 0xae, 0x06, 0x99,
-            0x7b, 0xaf, 0x59, 0x47, 0x95, 0xcf, 0x64, 0x2e,
-            0xe9, 0x75, 0x5a, 0xab, 0x50, 0xc6, 0x9b, 0x43,
-            0xa7, 0x29, 0xf3, 0x51, 0x9e, 0xaa, 0xc4, 0xc7
-        },
-        {
-            0x33, 0xca, 0x75, 0xb3, 0xf0, 0xee, 0xe2, 0x49,
-            0xba, 0x79, 0xab, 0x97, 0xf8, 0x11, 0xad, 0xf1,
-            0x95, 0xa7, 0x1f, 0x59, 0x79, 0x46, 0x33, 0xf5,
-            0x97, 0x6b, 0xa1, 0x0e, 0xbc, 0xce, 0xb3, 0xf9
-        },
-        {
-            0x10, 0xe5, 0x27, 0x56, 0xef, 0x1e, 0x90, 0x62,
-            0xab, 0x5a, 0xb4, 0xa3, 0xe7, 0xab, 0xe2, 0x9f,
-            0x01, 0xca, 0x70, 0x3e, 0x10, 0x9d, 0xc5, 0x76,
-            0x66, 0xf4, 0xbd, 0xf1, 0xc4, 0x01, 0x97, 0x7a
-        }
-    },
-    {
-        {
-            0x15, 0x2d, 0xc2, 0x82, 0x05, 0xbb, 0x98, 0x9f,
-            0x84, 0xfb, 0xe0, 0xa3, 0xe6, 0x4b, 0x25, 0x2c,
-            0xa6, 0x67, 0x94, 0xec, 0xac, 0x42, 0xc4, 0x68,
-            0x0a, 0x2d, 0x65, 0xb2, 0x75, 0xc5, 0x22, 0xf8
-        },
-        {
-            0x28, 0xee, 0x5d, 0xdd, 0xc9, 0xef, 0x49, 0xec,
-            0xa1, 0x87, 0x04, 0x9b, 0x82, 0x67, 0x9c, 0x92,
-            0xa9, 0xbe, 0x74, 0xe8, 0x88, 0xb0, 0x98, 0xc3,
-            0xf2, 0x56, 0xce, 0xbf, 0x8e, 0xb6, 0xa4, 0x67
-        },
-        {
-            0x37, 0x1a, 0x00, 0xf9, 0xd5, 0x1e, 0x93, 0xa5,
-            0xa0, 0x3d, 0x0b, 0x7f, 0x46, 0x2b, 0x72, 0x3c,
-            0xff, 0xd9, 0xbf, 0x00, 0x7e, 0xfd, 0x4b, 0x57,
-            0x26, 0xd1, 0x3b, 0x8b, 0xe1, 0xf4, 0x82, 0x64
-        }
-    },
-    {
-        {
-            0x2e, 0xb7, 0xe7, 0x5c, 0x62, 0xba, 0x1d, 0x7f,
-            0x03, 0xcb, 0x78, 0x4e, 0x41, 0xa6, 0xaf, 0xed,
-            0xbc, 0xda, 0x22, 0x21, 0x63, 0x97, 0x2f, 0xc2,
-            0x10, 0x85, 0xb1, 0xb5, 0x64, 0xc3, 0x6a, 0x89
-        },
-        {
-            0x2a, 0x77, 0x9c, 0xcb, 0x53, 0x9a, 0xb7, 0xa8,
-            0x51, 0x6c, 0xad, 0x9b, 0x7b, 0x6b, 0xef, 0x5d,
-            0x83, 0x5d, 0x73, 0xa4, 0x9f, 0x92, 0x56, 0xf6,
-            0xbd, 0xd2, 0x34, 0x30, 0xaa, 0x4b, 0x61, 0x76
-        },
-        {
-            0x35, 0x1c, 0xa4, 0x17, 0xa6, 0x77, 0x26, 0x4f,
-            0x4d, 0xf8, 0x29, 0xff, 0xa5, 0x5b, 0xff, 0x4e,
-            0x34, 0x90, 0xde, 0xa3, 0x6d, 0xc2, 0x25, 0xb9,
-            0x0f, 0x62, 0xa7, 0xfa, 0x97, 0x81, 0x63, 0x7c
-        }
-    },
-    {
-        {
-            0x10, 0x9a, 0xd2, 0x85, 0xb5, 0xb2, 0x0b, 0xde,
-            0xb9, 0x4e, 0xfe, 0x97, 0xb1, 0xc8, 0xaf, 0xc0,
-            0xb8, 0x4f, 0x7b, 0x41, 0xd9, 0x24, 0x2e, 0x9e,
-            0x58, 0xdd, 0xc3, 0xc5, 0x09, 0x3c, 0x81, 0xae
-        },
-        {
-            0x08, 0x2a, 0xf6, 0xfd, 0x0d, 0x47, 0x36, 0x30,
-            0xb2, 0xb8, 0xa2, 0xbc, 0x9c, 0x3c, 0x6c, 0x49,
-            0x5b, 0x69, 0xaf, 0xfe, 0x45, 0x6c, 0xf7, 0xce,
-            0xe1, 0x17, 0x14, 0xc3, 0xc3, 0xc3, 0x1d, 0x16
-        },
-        {
-            0x14, 0x61, 0xc7, 0xf0, 0x90, 0xcb, 0xda, 0x8b,
-            0x25, 0x39, 0x94, 0xa2, 0x7c, 0x72, 0xa0, 0xb2,
-            0x99, 0x28, 0xdb, 0x3a, 0xef, 0xa4, 0xe4, 0xa4,
-            0x8c, 0xb2, 0x02, 0x5d, 0x61, 0x1f, 0x8a, 0xf8
-        }
-    },
-    {
-        {
-            0x0b, 0x2e, 0xe9, 0x69, 0x27, 0x5d, 0x2a, 0x3a,
-            0xfb, 0x5c, 0x3a, 0xc0, 0x51, 0x46, 0xda, 0x01,
-            0xee, 0x35, 0x89, 0xad, 0xd7, 0x66, 0xf2, 0x2b,
-            0xe6, 0x33, 0x1b, 0xbe, 0xd9, 0x2c, 0xd0, 0xf1
-        },
-        {
-            0x1d, 0x11, 0xa5, 0xa4, 0x1c, 0xfd, 0xc7, 0x31,
-            0xec, 0xd7, 0xe5, 0x2e, 0x3f, 0xc0, 0xea, 0x81,
-            0xb2, 0xfe, 0x0b, 0xbb, 0x28, 0x01, 0xd1, 0x48,
-            0xf7, 0x5a, 0x05, 0x50, 0x29, 0x03, 0x00, 0x7a
-        },
-        {
-            0x21, 0x93, 0x6b, 0x37, 0x09, 0xc9, 0xdd, 0xd2,
-            0x28, 0xf6, 0xe0, 0xaa, 0xa2, 0x24, 0x95, 0x5a,
-            0xfd, 0x9b, 0x41, 0x1f, 0xd2, 0x60, 0xf4, 0x2a,
-            0xd9, 0x88, 0xd2, 0x92, 0x0d, 0x39, 0x26, 0x1e
-        }
-    },
-    {
-        {
-            0x06, 0x23, 0x20, 0xc5, 0x54, 0x6c, 0xfe, 0x62,
-            0x17, 0xf6, 0xdb, 0x99, 0x66, 0x4d, 0xe3, 0x60,
-            0xcf, 0x6f, 0x96, 0xe8, 0xec, 0xc2, 0x8b, 0x4d,
-            0xba, 0x45, 0x25, 0x4f, 0x15, 0x08, 0xed, 0x92
-        },
-        {
-            0x0d, 0xe1, 0x33, 0xd0, 0x7a, 0xf9, 0xbd, 0xfd,
-            0xbb, 0x3d, 0xdf, 0xaa, 0xb9, 0x10, 0x7d, 0x2c,
-            0x9e, 0x03, 0xc6, 0x30, 0xbf, 0x11, 0xa1, 0x59,
-            0x21, 0x6b, 0x2f, 0xa0, 0xfe, 0x0e, 0x66, 0x7d
-        },
-        {
-            0x35, 0x61, 0x70, 0x94, 0xe3, 0xc1, 0xec, 0xdb,
-            0x07, 0x31, 0x7e, 0xad, 0xd2, 0x6c, 0x63, 0x98,
-            0x5d, 0x01, 0xbc, 0x36, 0x02, 0x56, 0x37, 0x19,
-            0x1c, 0x79, 0xdc, 0x65, 0x35, 0x9c, 0xcb, 0xe1
-        }
-    },
-    {
-        {
-            0x39, 0x04, 0x21, 0x51, 0xc2, 0x0f, 0xa2, 0x18,
-            0x18, 0x45, 0xf3, 0x54, 0x74, 0xd6, 0x5b, 0x80,
-            0x6d, 0x93, 0xf6, 0x34, 0x48, 0xd5, 0xa5, 0x56,
-            0x74, 0x78, 0xd0, 0x61, 0x04, 0x42, 0xa9, 0x7e
-        },
-        {
-            0x2f, 0x88, 0xdf, 0x05, 0x74, 0xfd, 0x97, 0xb6,
-            0xd0, 0xbc, 0xeb, 0xb7, 0x8e, 0xcf, 0x67, 0x69,
-            0xbd, 0x59, 0xae, 0xed, 0x45, 0x1f, 0x7d, 0x73,
-            0x0a, 0x8d, 0x54, 0x81, 0xdb, 0x79, 0xd6, 0x80
-        },
-        {
-            0x25, 0xfe, 0x91, 0xa8, 0x82, 0x05, 0xb5, 0x69,
-            0x8b, 0xd3, 0x30, 0x87, 0xcd, 0x53, 0x63, 0x26,
-            0xfc, 0x4a, 0xc8, 0xec, 0x97, 0x7e, 0xc8, 0x07,
-            0xed, 0xc9, 0x1c, 0xb7, 0x2f, 0xe4, 0x8a, 0x9f
-        }
-    },
-    {
-        {
-            0x1b, 0x17, 0x75, 0xad, 0x9c, 0x2b, 0xa1, 0xf1,
-            0x18, 0xce, 0x3b, 0x21, 0x63, 0x24, 0xaf, 0xf9,
-            0xa8, 0xd6, 0xa1, 0x6e, 0x75, 0x74, 0x57, 0x87,
-            0x03, 0x1a, 0x71, 0xe5, 0xe4, 0x9e, 0xe8, 0x81
-        },
-        {
-            0x1c, 0xa5, 0x35, 0x6d, 0x21, 0xe1, 0x52, 0x45,
-            0xf0, 0x6d, 0xa0, 0x68, 0xe5, 0x81, 0x21, 0xe4,
-            0x8e, 0x7a, 0x9a, 0xb2, 0xb6, 0xb5, 0x62, 0xfe,
-            0xc7, 0xb9, 0x56, 0x9d, 0x87, 0x0d, 0x13, 0x06
-        },
-        {
-            0x06, 0xaf, 0x4c, 0x91, 0xa1, 0x1c, 0x52, 0xa5,
-            0xf0, 0x2f, 0x13, 0xd8, 0xfe, 0x5a, 0x54, 0xb4,
-            0x7c, 0x1c, 0x2c, 0x18, 0x21, 0x2b, 0x5d, 0xaf,
-            0xba, 0xae, 0x1c, 0x2b, 0xbd, 0xee, 0x12, 0x49
-        }
-    },
-    {
-        {
-            0x09, 0x41, 0x78, 0x92, 0x80, 0x99, 0x2d, 0xab,
-            0x6b, 0xc8, 0x3d, 0x32, 0xda, 0x89, 0x8d, 0x37,
-            0x9f, 0x26, 0x1f, 0xc5, 0x48, 0x06, 0xd6, 0x77,
-            0x18, 0xc3, 0x3e, 0xc0, 0xdb, 0x83, 0x6a, 0x4a
-        },
-        {
-            0x09, 0x6d, 0x4d, 0xec, 0xa9, 0xfd, 0x80, 0x93,
-            0x0e, 0x56, 0xd6, 0x2a, 0xdf, 0x81, 0xe3, 0xfb,
-            0x15, 0xe9, 0x80, 0x70, 0x41, 0xcb, 0xdb, 0xab,
-            0xa5, 0x03, 0x3c, 0x87, 0x81, 0x41, 0x21, 0x1b
-        },
-        {
-            0x35, 0x36, 0x7b, 0x94, 0x2f, 0x71, 0xe9, 0x4c,
-            0x66, 0x99, 0x74, 0x26, 0x42, 0xa6, 0xc6, 0xa2,
-            0xc1, 0x4a, 0xd8, 0x1e, 0x10, 0xa8, 0xc8, 0xbd,
-            0xa2, 0xe8, 0xf6, 0xf4, 0x5f, 0x3a, 0x16, 0x30
-        }
-    },
-    {
-        {
-            0x20, 0x33, 0x76, 0x71, 0xbc, 0x9d, 0x81, 0x45,
-            0x1d, 0x63, 0x8b, 0xc5, 0xf2, 0xd1, 0x0c, 0xae,
-            0xd4, 0x87, 0x56, 0x37, 0x3e, 0x93, 0xc5, 0xbc,
-            0x5d, 0x74, 0xae, 0xe8, 0xa2, 0x19, 0x21, 0x82
-        },
-        {
-            0x3e, 0xb7, 0x7d, 0x9c, 0x0a, 0xfb, 0xd2, 0x8c,
-            0x29, 0x15, 0x9c, 0xbd, 0xaa, 0xcb, 0x19, 0x3c,
-            0x1b, 0x54, 0x28, 0x2c, 0x4c, 0x6a, 0xb4, 0x5f,
-            0xf2, 0x3c, 0xfa, 0x21, 0xa6, 0x0a, 0x6b, 0x33
-        },
-        {
-            0x3f, 0x7a, 0x91, 0x45, 0xca, 0xfc, 0x9f, 0x7e,
-            0x62, 0x3f, 0x0e, 0x8f, 0xfa, 0xd7, 0xeb, 0xa2,
-            0x6c, 0xed, 0xe8, 0x85, 0xc9, 0x2b, 0x0f, 0x04,
-            0x5c, 0x8f, 0x8d, 0x23, 0x50, 0x44, 0x16, 0x52
-        }
-    },
-    {
-        {
-            0x0a, 0x0b, 0x04, 0xb0, 0x47, 0x75, 0xf0, 0x33,
-            0x84, 0x58, 0x70, 0xcf, 0x4d, 0x77, 0x9d, 0x60,
-            0xdc, 0x87, 0x37, 0x80, 0x0c, 0x3f, 0x9f, 0xf0,
-            0x1b, 0xba, 0x61, 0x87, 0xff, 0x9b, 0x6c, 0xb7
-        },
-        {
-            0x05, 0x98, 0x30, 0xcd, 0x83, 0xd3, 0x71, 0xe5,
-            0xb9, 0xe6, 0x29, 0xfa, 0x43, 0x2d, 0x3f, 0x24,
-            0x56, 0x00, 0x2b, 0xbe, 0x46, 0x09, 0x26, 0xdb,
-            0xec, 0x34, 0x7a, 0x8c, 0xbf, 0xa3, 0xf6, 0x23
-        },
-        {
-            0x1c, 0x7d, 0x70, 0xa4, 0x18, 0x50, 0xb0, 0x60,
-            0xaa, 0x60, 0x0f, 0xb3, 0x88, 0x96, 0x1d, 0x6e,
-            0xc2, 0x91, 0x4a, 0x44, 0xaf, 0x5b, 0x27, 0xdc,
-            0xf0, 0x97, 0x4e, 0x66, 0x20, 0x67, 0x44, 0x86
-        }
-    },
-    {
-        {
-            0x2f, 0xbd, 0xb6, 0x81, 0x9b, 0x90, 0x00, 0x2c,
-            0xff, 0xf4, 0x2f, 0x87, 0xa3, 0x7e, 0x1f, 0x7e,
-            0x80, 0x49, 0x74, 0x28, 0x0f, 0x79, 0x2a, 0x3b,
-            0x09, 0xc3, 0xe6, 0x84, 0x4e, 0xc6, 0x4c, 0x40
-        },
-        {
-            0x1d, 0x41, 0x9d, 0xa8, 0xb4, 0x9b, 0xd7, 0x3f,
-            0x5f, 0x43, 0xa8, 0xed, 0xc4, 0x4b, 0x16, 0x11,
-            0x4a, 0xe5, 0x7a, 0xa2, 0x51, 0xbf, 0x34, 0xfa,
-            0xf8, 0x6b, 0x58, 0xc3, 0x6d, 0xf2, 0x8e, 0xc8
-        },
-        {
-            0x2f, 0xcd, 0x8a, 0x73, 0xef, 0x62, 0x17, 0xc7,
-            0x54, 0xf8, 0xb6, 0xec, 0x6c, 0xac, 0x92, 0x9d,
-            0x22, 0xb6, 0xce, 0x02, 0xff, 0x0f, 0x4a, 0x78,
-            0x97, 0xa9, 0x26, 0x12, 0xab, 0x01, 0x51, 0x05
-        }
-    },
-    {
-        {
-            0x39, 0xa2, 0x50, 0xeb, 0x25, 0xa9, 0x2e, 0xa2,
-            0x3b, 0xf7, 0x5c, 0x9a, 0x37, 0xf2, 0x67, 0x4a,
-            0xc0, 0xa4, 0x10, 0xca, 0x09, 0x81, 0x05, 0x33,
-            0xac, 0x44, 0xca, 0x6c, 0x34, 0xb0, 0x7c, 0xa1
-        },
-        {
-            0x28, 0x58, 0x55, 0xef, 0x5d, 0xe9, 0x62, 0x28,
-            0x18, 0xdb, 0xc8, 0x7c, 0xcc, 0xd0, 0x92, 0xa9,
-            0x8b, 0x4c, 0x7d, 0xab, 0x24, 0xa2, 0xc5, 0x46,
-            0xb4, 0x3e, 0xf8, 0x5e, 0xe9, 0xc1, 0xd9, 0x25
-        },
-        {
-            0x2e, 0xf9, 0x73, 0xb3, 0x23, 0xeb, 0x9f, 0x2d,
-            0xac, 0xd5, 0xa6, 0x00, 0x02, 0x14, 0x91, 0x09,
-            0x66, 0x9b, 0x88, 0xff, 0x52, 0xe8, 0x71, 0x4b,
-            0x69, 0xbe, 0x77, 0x0a, 0x8d, 0xdb, 0xaf, 0x90
-        }
-    },
-    {
-        {
-            0x11, 0x92, 0x0f, 0x37, 0xc5, 0x83, 0x26, 0xcf,
-            0xab, 0xcc, 0xed, 0x87, 0x52, 0x3d, 0x3c, 0xd9,
-            0x01, 0x39, 0xc1, 0xa1, 0x19, 0x5d, 0x0d, 0xad,
-            0x4d, 0x51, 0xbb, 0xdc, 0xc1, 0xcb, 0xb8, 0x8c
-        },
-        {
-            0x31, 0x05, 0x7f, 0x19, 0x1b, 0xda, 0x3f, 0x1e,
-            0xb5, 0xb6, 0x04, 0x6f, 0x0b, 0xb9, 0x30, 0xdf,
-            0xc9, 0x7b, 0x8c, 0xa5, 0x05, 0xea, 0xa4, 0xda,
-            0xa1, 0xf7, 0x47, 0xd6, 0xf2, 0x1e, 0x17, 0x52
-        },
-        {
-            0x25, 0x15, 0x4f, 0x7a, 0xc7, 0x6e, 0xdf, 0xc8,
-            0x21, 0x96, 0x79, 0x79, 0x46, 0xe2, 0x93, 0xe8,
-            0xc8, 0xa7, 0xfb, 0x88, 0xfa, 0x58, 0x3f, 0x92,
-            0x9a, 0xad, 0x0f, 0xe5, 0x0e, 0xa8, 0x97, 0xf3
-        }
-    },
-    {
-        {
-            0x17, 0xac, 0xe9, 0xf6, 0x36, 0x7a, 0xc2, 0x92,
-            0x73, 0xdb, 0xce, 0x8e, 0xcc, 0xd3, 0x75, 0x58,
-            0x4c, 0x34, 0x3a, 0xdf, 0x14, 0x17, 0x3d, 0x9b,
-            0x5a, 0x25, 0x73, 0xb5, 0xff, 0x11, 0x05, 0x77
-        },
-        {
-            0x2e, 0xfb, 0x03, 0xfd, 0xba, 0x21, 0x7d, 0x26,
-            0x01, 0xc2, 0x09, 0xf6, 0xd3, 0xaa, 0x19, 0xc2,
-            0x58, 0x22, 0xc2, 0xc4, 0x66, 0x8b, 0x27, 0x74,
-            0x8a, 0x6a, 0x58, 0x4b, 0x25, 0xe4, 0x88, 0xb8
-        },
-        {
-            0x1b, 0xd0, 0xb4, 0x3c, 0xf6, 0xac, 0x7b, 0x6c,
-            0xd5, 0x35, 0xa6, 0xc9, 0x4e, 0x32, 0x9c, 0xe6,
-            0xbc, 0x1d, 0x58, 0xd6, 0xec, 0x3f, 0xc9, 0x80,
-            0xd4, 0xdf, 0x42, 0x94, 0x4c, 0x63, 0x9d, 0x09
-        }
-    },
-    {
-        {
-            0x2b, 0xba, 0xdb, 0x54, 0xfd, 0x14, 0x21, 0x42,
-            0xe5, 0xd9, 0xda, 0x72, 0x6c, 0x6e, 0xff, 0xc1,
-            0x6e, 0x6a, 0xdd, 0x29, 0x77, 0x76, 0x03, 0x6a,
-            0x24, 0x5d, 0xd4, 0x99, 0x8d, 0xf2, 0xa7, 0x2a
-        },
-        {
-            0x30, 0x15, 0x9e, 0xcc, 0x49, 0xfe, 0x86, 0x7e,
-            0xb8, 0xad, 0xc0, 0x27, 0x60, 0x5f, 0x04, 0x80,
-            0xc0, 0x79, 0xaa, 0x5a, 0x61, 0x83, 0x05, 0x6d,
-            0x6c, 0xdb, 0xe5, 0xdb, 0x82, 0x7c, 0x86, 0xb9
-        },
-        {
-            0x26, 0xe9, 0x45, 0xe1, 0xec, 0x40, 0x25, 0x04,
-            0xa6, 0xed, 0x02, 0xd4, 0x1a, 0x30, 0xa4, 0x56,
-            0x2c, 0x0c, 0x55, 0x97, 0x43, 0xe0, 0x89, 0xbb,
-            0xc7, 0x2e, 0x8a, 0x29, 0xd2, 0xf9, 0xcf, 0xc8
-        }
-    },
-    {
-        {
-            0x06, 0x0a, 0xc0, 0x54, 0xa5, 0xdb, 0x07, 0xd9,
-            0xc3, 0xb4, 0x3e, 0x3b, 0xaa, 0x67, 0x7f, 0x8b,
-            0xe1, 0xc6, 0x59, 0x64, 0x4c, 0x5b, 0xd9, 0xce,
-            0xa2, 0x20, 0x2e, 0x4d, 0x5b, 0x25, 0x8f, 0x4c
-        },
-        {
-            0x1e, 0x4b, 0xa4, 0x04, 0xdf, 0x70, 0xc4, 0xb2,
-            0x5e, 0x94, 0xdc, 0x2f, 0x45, 0x06, 0xd1, 0xce,
-            0x9a, 0xad, 0x21, 0xbf, 0xaf, 0xd9, 0x08, 0xb2,
-            0x5d, 0xac, 0x88, 0x4b, 0x54, 0x5b, 0xd9, 0x6d
-        },
-        {
-            0x3e, 0xe4, 0xd5, 0x54, 0xf5, 0x6f, 0x37, 0x12,
-            0x02, 0x9c, 0x99, 0x36, 0xbf, 0x7a, 0xdb, 0xe8,
-            0x97, 0x33, 0x45, 0x92, 0x04, 0x6b, 0x64, 0x42,
-            0xeb, 0x23, 0x61, 0x59, 0xef, 0xed, 0xf7, 0xc1
-        }
-    },
-    {
-        {
-            0x3f, 0x19, 0x0b, 0x8c, 0xe4, 0x41, 0x86, 0xa9,
-            0xa0, 0xbe, 0x8c, 0x63, 0xcb, 0xd7, 0xf5, 0xa3,
-            0x67, 0xcf, 0x64, 0x46, 0x4b, 0x31, 0x6b, 0x2a,
-            0x27, 0x70, 0xd1, 0x17, 0xd1, 0x1a, 0xfe, 0xa4
-        },
-        {
-            0x2f, 0x27, 0xf7, 0x67, 0xed, 0xf5, 0x20, 0x9a,
-            0xae, 0xbd, 0x36, 0xd2, 0x54, 0x77, 0xda, 0xca,
-            0x86, 0xe0, 0x32, 0xbd, 0xd7, 0xe4, 0xc7, 0xbd,
-            0x2d, 0x05, 0x4a, 0x00, 0xfb, 0x99, 0x9f, 0xc7
-        },
-        {
-            0x3e, 0x34, 0x04, 0x45, 0xd8, 0xf2, 0x74, 0xa2,
-            0x41, 0x7a, 0xc0, 0x7b, 0x2c, 0x83, 0xd6, 0xa4,
-            0x26, 0x4e, 0x60, 0xaf, 0x0e, 0x67, 0x19, 0x3d,
-            0x47, 0xe0, 0x43, 0xb0, 0xa8, 0x26, 0x49, 0xc1
-        }
-    },
-    {
-        {
-            0x37, 0x3a, 0x9d, 0xfa, 0x29, 0xc8, 0xa1, 0x2b,
-            0x7a, 0xea, 0x71, 0xef, 0x6c, 0xcf, 0xbf, 0x37,
-            0x1e, 0x93, 0xdf, 0x71, 0xae, 0xfb, 0xcf, 0xeb,
-            0x37, 0x51, 0x35, 0x42, 0xd1, 0x9d, 0xfd, 0x9b
-        },
-        {
-            0x2c, 0xf7, 0xfb, 0x4f, 0x8e, 0x34, 0x33, 0x02,
-            0x56, 0x54, 0x3c, 0x7b, 0xe2, 0xb0, 0x82, 0xe4,
-            0x9c, 0x18, 0x59, 0x1f, 0x6e, 0x1c, 0x3a, 0x5a,
-            0x6c, 0x52, 0x3f, 0x21, 0x85, 0xd0, 0x60, 0xa3
-        },
-        {
-            0x11, 0x87, 0xd2, 0x23, 0x84, 0x5b, 0x0f, 0x88,
-            0x8a, 0x34, 0x0d, 0xff, 0x2c, 0xc6, 0xf5, 0x0b,
-            0xac, 0x15, 0xf7, 0x52, 0x0f, 0x8b, 0x42, 0xb9,
-            0xae, 0xdd, 0xd3, 0xf9, 0xe4, 0x5b, 0x69, 0x7e
-        }
-    },
-    {
-        {
-            0x13, 0xb3, 0x7f, 0xdc, 0x3d, 0xaa, 0x81, 0x7b,
-            0x24, 0x2c, 0x69, 0x75, 0xee, 0x13, 0xc2, 0xa9,
-            0xb7, 0x95, 0x95, 0xdd, 0xbc, 0x15, 0xbb, 0x52,
-            0xda, 0xd3, 0x5f, 0x16, 0xaa, 0xed, 0x68, 0xfb
-        },
-        {
-            0x2b, 0x70, 0xdc, 0x6b, 0x83, 0xfa, 0xaf, 0x01,
-            0xe6, 0x62, 0xfe, 0x5f, 0x48, 0x8e, 0x69, 0x5f,
-            0xa9, 0x12, 0x3b, 0xfb, 0xb8, 0x2c, 0x00, 0x32,
-            0x9b, 0x1e, 0x76, 0xc6, 0xb2, 0x62, 0xa2, 0x84
-        },
-        {
-            0x20, 0x5b, 0x55, 0xea, 0x84, 0xe9, 0x9f, 0x47,
-            0x9a, 0x3a, 0x65, 0xed, 0x58, 0x1e, 0xea, 0xe8,
-            0xda, 0x77, 0x80, 0x31, 0x84, 0x3c, 0xc1, 0x60,
-            0x70, 0xff, 0xaf, 0x16, 0x38, 0xdd, 0xb5, 0x5f
-        }
-    },
-    {
-        {
-            0x19, 0x8c, 0x04, 0xb2, 0x2d, 0xf4, 0x6d, 0xe4,
-            0xf1, 0x39, 0xc4, 0xa6, 0xc4, 0xaa, 0x88, 0x9f,
-            0xe1, 0x40, 0xe9, 0xde, 0xb9, 0x7e, 0xc1, 0xe5,
-            0xd8, 0x3e, 0x36, 0xac, 0x74, 0x29, 0xd5, 0xd4
-        },
-        {
-            0x2e, 0x33, 0x3c, 0x8d, 0x9b, 0x77, 0x86, 0xb8,
-            0x91, 0xfc, 0xfe, 0x79, 0xae, 0x56, 0xb4, 0xea,
-            0x8b, 0xda, 0xb8, 0xe6, 0x4f, 0x9b, 0xc5, 0xce,
-            0x5b, 0xf3, 0x2b, 0x48, 0xb2, 0x0d, 0xe7, 0x5d
-        },
-        {
-            0x0a, 0x47, 0xe5, 0x70, 0xb4, 0xea, 0x64, 0x90,
-            0x89, 0xbb, 0xa9, 0x0b, 0xf6, 0x15, 0x40, 0xed,
-            0xae, 0x5a, 0x8b, 0x03, 0x7b, 0xf5, 0x91, 0x10,
-            0xfb, 0xb5, 0xcb, 0x32, 0x0d, 0x71, 0x59, 0x5e
-        }
-    },
-    {
-        {
-            0x1e, 0xb0, 0x2c, 0xe0, 0x9e, 0xd3, 0xc4, 0x26,
-            0x04, 0xfa, 0x93, 0xfb, 0x09, 0xfa, 0xc1, 0xe5,
-            0xde, 0x0b, 0x66, 0xa5, 0x67, 0x87, 0x22, 0x30,
-            0x80, 0x44, 0xde, 0xc1, 0xac, 0x6c, 0x90, 0xd2
-        },
-        {
-            0x11, 0xc8, 0x79, 0xe6, 0xcc, 0x20, 0x01, 0x60,
-            0x7e, 0x17, 0x29, 0xb8, 0x22, 0xdc, 0xfa, 0xa9,
-            0xa4, 0xc1, 0x0a, 0x25, 0xd3, 0x54, 0xfb, 0x02,
-            0x20, 0xf4, 0xab, 0x5e, 0x9e, 0x3d, 0xec, 0x64
-        },
-        {
-            0x04, 0xb8, 0x06, 0xf5, 0xfc, 0x40, 0xf1, 0x5e,
-            0x66, 0x3e, 0xac, 0x16, 0xba, 0x02, 0x92, 0x3d,
-            0x97, 0xa2, 0xac, 0xa5, 0xf0, 0xef, 0xea, 0x8e,
-            0x89, 0x55, 0xa3, 0xeb, 0xc3, 0x28, 0xcf, 0xa1
-        }
-    },
-    {
-        {
-            0x3c, 0x67, 0x1c, 0x81, 0x85, 0x11, 0x4e, 0x52,
-            0xc2, 0x1f, 0x7b, 0x77, 0x9d, 0x05, 0xb6, 0xe7,
-            0x60, 0x33, 0x73, 0x7f, 0xd9, 0x1c, 0xca, 0x53,
-            0x66, 0x55, 0x4e, 0xb1, 0xc4, 0x91, 0x0d, 0x0a
-        },
-        {
-            0x33, 0xc5, 0xd4, 0x96, 0x65, 0x2b, 0x2d, 0xbd,
-            0xfd, 0x32, 0x81, 0x23, 0x9d, 0x59, 0xff, 0x1c,
-            0x15, 0x63, 0x81, 0x47, 0x91, 0xb2, 0xaf, 0xc1,
-            0x80, 0x5e, 0xf9, 0xdc, 0xf2, 0x0b, 0x49, 0xdb
-        },
-        {
-            0x26, 0xf0, 0x47, 0xd6, 0xb5, 0xd2, 0xb3, 0xe7,
-            0x4a, 0xd0, 0x1e, 0x16, 0x35, 0x87, 0x7f, 0xec,
-            0x3d, 0x24, 0x15, 0xc2, 0x73, 0xcf, 0x9e, 0x07,
-            0x8f, 0x3a, 0x03, 0x52, 0x60, 0xa7, 0x61, 0xef
-        }
-    },
-    {
-        {
-            0x17, 0xae, 0x35, 0xd7, 0x6c, 0x90, 0xb9, 0x90,
-            0x6e, 0x2a, 0x83, 0x64, 0x78, 0x60, 0x01, 0xe1,
-            0x9e, 0xf5, 0x94, 0x2f, 0x85, 0xdb, 0x2e, 0xea,
-            0x77, 0x26, 0xc8, 0x32, 0x57, 0x48, 0x11, 0x54
-        },
-        {
-            0x21, 0x11, 0xfb, 0x41, 0xb7, 0x9e, 0x1e, 0xd7,
-            0xb5, 0x2a, 0xb0, 0x74, 0x34, 0x45, 0x55, 0xc1,
-            0x33, 0x9f, 0x6d, 0xea, 0xd7, 0x4c, 0x81, 0xd0,
-            0x2f, 0x2f, 0xe3, 0x7d, 0xad, 0x97, 0xbc, 0xcb
-        },
-        {
-            0x35, 0x46, 0x08, 0x98, 0x8a, 0x63, 0x49, 0x4d,
-            0x3d, 0x2e, 0x11, 0xd1, 0x2f, 0x40, 0x98, 0x1c,
-            0xee, 0x7e, 0x2e, 0x5e, 0x43, 0x8e, 0x80, 0xbb,
-            0x2e, 0x97, 0x66, 0x28, 0xf9, 0x8a, 0x53, 0xb3
-        }
-    },
-    {
-        {
-            0x27, 0xc2, 0x6d, 0x59, 0x98, 0xde, 0x1e, 0xd7,
-            0xdc, 0xad, 0x2c, 0x1d, 0x94, 0x06, 0xaf, 0x2d,
-            0x0a, 0xfc, 0x38, 0x94, 0x43, 0xf7, 0x70, 0x6e,
-            0x67, 0xad, 0x5d, 0xab, 0x07, 0xb9, 0x8a, 0x25
-        },
-        {
-            0x26, 0xe8, 0x2b, 0x78, 0xed, 0x77, 0xfa, 0x2c,
-            0x7a, 0xb0, 0xd9, 0xd8, 0x6f, 0xe9, 0xb2, 0xb3,
-            0x13, 0xc2, 0x9e, 0xc0, 0xa2, 0x0d, 0x31, 0xd9,
-            0x9e, 0x7c, 0xeb, 0x88, 0xb4, 0xa6, 0x1a, 0x89
-        },
-        {
-            0x3c, 0x9f, 0x89, 0x63, 0x89, 0xf9, 0x16, 0x8c,
-            0xd5, 0x21, 0xe8, 0x1f, 0x4c, 0x4c, 0x6e, 0x24,
-            0xdb, 0xfb, 0x31, 0x6a, 0x68, 0x5e, 0xf8, 0xa4,
-            0xa5, 0x9e, 0x78, 0x10, 0xbc, 0x1a, 0xf9, 0x09
-        }
-    },
-    {
-        {
-            0x00, 0xfd, 0xdd, 0x23, 0x4b, 0x11, 0xd1, 0xb7,
-            0x7f, 0xf3, 0x59, 0x5b, 0x74, 0xc9, 0x4a, 0x57,
-            0xa9, 0xb7, 0xca, 0x46, 0x05, 0xc6, 0x26, 0xa4,
-            0xe7, 0x0a, 0xa1, 0xde, 0x72, 0x1e, 0xdb, 0xc2
-        },
-        {
-            0x33, 0xf1, 0x3c, 0xba, 0xa0, 0xe9, 0x19, 0x6a,
-            0x78, 0xdb, 0xd6, 0xc9, 0xd3, 0x48, 0x27, 0xb7,
-            0x4c, 0x74, 0x9a, 0x37, 0xb3, 0x37, 0xf5, 0xff,
-            0xa2, 0xdf, 0x7b, 0x8f, 0x0e, 0x3b, 0x6c, 0x21
-        },
-        {
-            0x32, 0x06, 0x0e, 0x68, 0x13, 0x69, 0xe9, 0xd8,
-            0xab, 0x9f, 0x49, 0xdc, 0x69, 0x78, 0xcd, 0x85,
-            0x29, 0x2c, 0xf1, 0xc9, 0x08, 0xb1, 0xba, 0xcd,
-            0xcd, 0x75, 0x85, 0xfa, 0x7f, 0x83, 0x63, 0xd1
-        }
-    },
-    {
-        {
-            0x39, 0xc4, 0x13, 0x60, 0xd5, 0x21, 0x42, 0xa4,
-            0xe3, 0x04, 0xdc, 0xda, 0x3b, 0x1a, 0xb0, 0xd7,
-            0xee, 0xdc, 0xe9, 0x09, 0xe0, 0x74, 0x62, 0x19,
-            0x6c, 0x4f, 0x45, 0x9c, 0x5e, 0xdc, 0x97, 0x48
-        },
-        {
-            0x2c, 0xb7, 0x64, 0x7a, 0x82, 0xd0, 0xe7, 0x0c,
-            0x9f, 0x9e, 0xf8, 0x83, 0x15, 0x71, 0x41, 0xfb,
-            0x65, 0x73, 0x15, 0xbf, 0xf8, 0x6c, 0x27, 0x42,
-            0x87, 0x18, 0x1b, 0x81, 0x6c, 0xbf, 0xf5, 0x35
-        },
-        {
-            0x10, 0xaa, 0xd9, 0x8f, 0xc9, 0x2a, 0xe6, 0x2c,
-            0x72, 0x11, 0x43, 0x72, 0x40, 0xda, 0xd8, 0x44,
-            0x41, 0x6d, 0x85, 0x8f, 0x2b, 0x6f, 0xf9, 0xf8,
-            0x5b, 0x8d, 0x2a, 0x83, 0x72, 0xd1, 0xc9, 0xc4
-        }
-    },
-    {
-        {
-            0x39, 0xe3, 0xee, 0xcf, 0x71, 0xa7, 0xae, 0x29,
-            0x34, 0xf5, 0x57, 0xcf, 0x2a, 0xf1, 0xee, 0x80,
-            0x97, 0x54, 0xca, 0xf2, 0x28, 0x58, 0x81, 0x6b,
-            0x84, 0xea, 0xc7, 0x4a, 0x64, 0x6e, 0x82, 0x46
-        },
-        {
-            0x3f, 0x92, 0xe6, 0x65, 0x4a, 0x83, 0xeb, 0xe9,
-            0x85, 0xdd, 0xba, 0xb5, 0xe9, 0xaf, 0x40, 0xc0,
-            0x02, 0x83, 0x53, 0x6c, 0xd0, 0xac, 0x92, 0xc9,
-            0x6e, 0x0f, 0xec, 0x7c, 0x22, 0xa2, 0xd2, 0x4f
-        },
-        {
-            0x1a, 0x4c, 0xef, 0x4f, 0x36, 0x6f, 0xa8, 0x07,
-            0x72, 0xb8, 0x5b, 0x94, 0x84, 0x94, 0x2b, 0xc3,
-            0xb5, 0x79, 0xcd, 0x3a, 0x36, 0xa9, 0xef, 0x25,
-            0xe7, 0x99, 0x9b, 0x9a, 0x9d, 0x1f, 0x23, 0xc9
-        }
-    },
-    {
-        {
-            0x2f, 0xe1, 0xd6, 0x05, 0xaf, 0x67, 0x42, 0x60,
-            0xae, 0x9e, 0x13, 0xcf, 0x71, 0xee, 0x8f, 0x6a,
-            0x3b, 0xeb, 0xf4, 0xe3, 0xca, 0x4e, 0xd0, 0xba,
-            0x39, 0x4c, 0x69, 0x5e, 0x9d, 0x25, 0x2c, 0xab
-        },
-        {
-            0x14, 0x5f, 0x74, 0xe0, 0x79, 0x08, 0x88, 0x45,
-            0x2e, 0x10, 0x24, 0x44, 0xc8, 0xd2, 0x8b, 0xe2,
-            0x19, 0x2d, 0x39, 0x2c, 0x23, 0xc8, 0x1a, 0x69,
-            0x35, 0xa6, 0x69, 0x7b, 0x80, 0x3d, 0x5f, 0x2d
-        },
-        {
-            0x29, 0x5d, 0x8c, 0x45, 0x44, 0x3d, 0xbc, 0x0a,
-            0x49, 0x88, 0x2d, 0xe5, 0x3c, 0x92, 0xa2, 0x95,
-            0xb4, 0xf6, 0x7c, 0xba, 0x2c, 0x49, 0xa9, 0x45,
-            0xde, 0xf3, 0xa9, 0xf7, 0x1d, 0x53, 0x41, 0x5d
-        }
-    },
-    {
-        {
-            0x0f, 0x10, 0x61, 0x7e, 0xb0, 0xf6, 0x91, 0x95,
-            0x82, 0x2e, 0x05, 0x18, 0xad, 0x06, 0xef, 0xc4,
-            0x5d, 0x33, 0xb1, 0x4a, 0x68, 0xf9, 0x3a, 0x91,
-            0x49, 0xab, 0xb0, 0xf8, 0x9e, 0xb1, 0x9e, 0x43
-        },
-        {
-            0x2d, 0x6c, 0xf4, 0x8b, 0x81, 0x91, 0x98, 0x24,
-            0xfb, 0x6c, 0xbb, 0xd3, 0x25, 0xb1, 0x4d, 0xb6,
-            0xf4, 0xd2, 0x9e, 0xed, 0x69, 0xb3, 0xb4, 0x9c,
-            0xdd, 0x45, 0xb7, 0x53, 0xaa, 0x32, 0xcb, 0x3e
-        },
-        {
-            0x2c, 0x69, 0x1a, 0x55, 0x19, 0xe9, 0xc0, 0xc8,
-            0x9d, 0x49, 0x6d, 0x6b, 0x60, 0x22, 0x9b, 0xc8,
-            0x52, 0x64, 0x45, 0x73, 0xb4, 0x5f, 0x0f, 0xb0,
-            0x8b, 0x9a, 0x3b, 0xb8, 0xdd, 0x01, 0xcc, 0x6f
-        }
-    },
-    {
-        {
-            0x3e, 0x50, 0x34, 0x4a, 0xdf, 0x9e, 0x70, 0x18,
-            0x1e, 0x4f, 0x1d, 0xf0, 0xb8, 0x7d, 0xc8, 0x29,
-            0x39, 0x9c, 0x9e, 0xe2, 0xba, 0xdb, 0x2e, 0x13,
-            0xc6, 0x17, 0x28, 0xf7, 0x9d, 0xa7, 0xe6, 0x97
-        },
-        {
-            0x16, 0x59, 0x1f, 0x51, 0xa5, 0x44, 0x64, 0xee,
-            0xff, 0xe9, 0xc4, 0x2a, 0xf2, 0x1e, 0x6c, 0x8c,
-            0xc2, 0xa4, 0x23, 0x92, 0x12, 0x1a, 0x1e, 0x6a,
-            0xfd, 0xd4, 0x38, 0x56, 0x9e, 0x98, 0xd9, 0x0f
-        },
-        {
-            0x19, 0x47, 0x35, 0x02, 0x78, 0xed, 0x8b, 0x4a,
-            0xc2, 0x9c, 0x88, 0x48, 0x6d, 0xb3, 0x25, 0x9d,
-            0x8c, 0x0a, 0x1e, 0x5e, 0x4b, 0x81, 0xef, 0x93,
-            0xca, 0x6c, 0x9c, 0xea, 0x8c, 0x8f, 0x10, 0x7a
-        }
-    },
-    {
-        {
-            0x3d, 0x9e, 0x5c, 0x32, 0x52, 0xcc, 0x09, 0xdc,
-            0x78, 0xef, 0x80, 0xa1, 0x6f, 0x38, 0x15, 0x0c,
-            0x79, 0x44, 0xe8, 0xfb, 0x27, 0xf2, 0xf2, 0x9c,
-            0xd5, 0xcd, 0x3a, 0xe4, 0x8b, 0x2b, 0x19, 0xb9
-        },
-        {
-            0x00, 0x39, 0xe7, 0xc1, 0x87, 0xe0, 0xb6, 0x4f,
-            0x15, 0x75, 0x7e, 0x5a, 0xc9, 0x0b, 0xf4, 0x72,
-            0x9d, 0x6a, 0xd6, 0x62, 0x8e, 0xa7, 0xb4, 0xa8,
-            0x64, 0x49, 0x92, 0xe8, 0x64, 0x0a, 0xf6, 0x7d
-        },
-        {
-            0x32, 0x81, 0x44, 0xc1, 0x2f, 0xff, 0xac, 0xab,
-            0xff, 0x01, 0x7f, 0x07, 0x26, 0xc8, 0x6f, 0x42,
-            0xec, 0xaa, 0xd7, 0x43, 0x5e, 0xff, 0x27, 0x0f,
-            0x46, 0x27, 0x43, 0xf0, 0x12, 0x6e, 0xfa, 0xbe
-        }
-    },
-    {
-        {
-            0x28, 0x9a, 0x1a, 0x58, 0xeb, 0x1d, 0xc1, 0x07,
-            0x17, 0xfa, 0xc7, 0x69, 0xb5, 0x08, 0x15, 0x6d,
-            0x58, 0x1d, 0x8b, 0x63, 0xae, 0xd8, 0xfe, 0x69,
-            0x02, 0xe0, 0x8b, 0xcd, 0xdf, 0x9e, 0x33, 0x95
-        },
-        {
-            0x05, 0x7b, 0xfb, 0xce, 0xaa, 0x7f, 0x9d, 0x51,
-            0x10, 0xfe, 0xb2, 0x95, 0x92, 0x2e, 0xa7, 0x30,
-            0x06, 0xa7, 0x0b, 0x25, 0x53, 0x05, 0x7e, 0xd6,
-            0x34, 0x37, 0x24, 0xca, 0xc8, 0xbf, 0x4e, 0xa9
-        },
-        {
-            0x25, 0x18, 0x8b, 0x12, 0x75, 0x7e, 0x81, 0xd8,
-            0xe1, 0x03, 0x52, 0xd5, 0xa6, 0xb5, 0x40, 0xa6,
-            0x17, 0x37, 0xb0, 0x57, 0xaa, 0x34, 0xaf, 0xb8,
-            0x8c, 0x56, 0xe6, 0xa1, 0x7f, 0x10, 0x21, 0xe4
-        }
-    },
-    {
-        {
-            0x1a, 0x6a, 0x14, 0xf5, 0xb7, 0xa8, 0xfa, 0x4e,
-            0xd5, 0x0a, 0x60, 0x24, 0x4f, 0xbb, 0xa4, 0xbc,
-            0x54, 0x70, 0xe4, 0xcd, 0x4c, 0xa7, 0xa3, 0x26,
-            0xd8, 0xae, 0x86, 0x64, 0xbc, 0x19, 0x51, 0x7e
-        },
-        {
-            0x06, 0xed, 0x52, 0x44, 0xe5, 0xe6, 0xe5, 0x5c,
-            0x98, 0x7f, 0xe9, 0x95, 0xcf, 0x28, 0x1e, 0x6d,
-            0x87, 0x3e, 0x87, 0x50, 0xd5, 0x0f, 0x28, 0x13,
-            0xf1, 0x3d, 0x66, 0x09, 0x52, 0x8f, 0x08, 0x89
-        },
-        {
-            0x3d, 0x40, 0x5c, 0x06, 0x1d, 0x98, 0x7d, 0x6d,
-            0x24, 0xe7, 0x05, 0xf8, 0x73, 0x61, 0x85, 0x49,
-            0x8f, 0x94, 0x54, 0xee, 0x64, 0x1c, 0xa2, 0x53,
-            0x31, 0x73, 0x5e, 0x31, 0x83, 0xb8, 0x92, 0xb5
-        }
-    },
-    {
-        {
-            0x1c, 0xbe, 0x94, 0x5e, 0x02, 0x62, 0x5d, 0x9a,
-            0xf4, 0x0f, 0x5a, 0x29, 0x45, 0xa3, 0x11, 0xfc,
-            0x95, 0x24, 0x6a, 0xe0, 0x7c, 0xce, 0x8c, 0x07,
-            0x77, 0x26, 0x5f, 0xbc, 0x01, 0xfa, 0xca, 0xde
-        },
-        {
-            0x01, 0x0e, 0x27, 0x99, 0x01, 0xe0, 0xb4, 0xa0,
-            0x8f, 0x59, 0x0e, 0x5a, 0x44, 0xb6, 0x66, 0x7b,
-            0x3e, 0x60, 0x8b, 0xc7, 0xd2, 0x41, 0x1e, 0x91,
-            0x90, 0xc6, 0x53, 0x8a, 0x91, 0x6e, 0xa2, 0x98
-        },
-        {
-            0x1e, 0xc2, 0xe8, 0x1e, 0xba, 0x84, 0xf4, 0x52,
-            0x7a, 0xae, 0xf4, 0x3f, 0x2e, 0xa9, 0x8d, 0x3e,
-            0xdc, 0xf8, 0xf7, 0x53, 0xc7, 0x05, 0xa5, 0x4b,
-            0x53, 0x84, 0x1c, 0x26, 0x4b, 0x1d, 0x8d, 0x5e
-        }
-    }
-};
-
-// MDS matrix Pasta Fp
-static const Field mds_matrix[SPONGE_SIZE][SPONGE_SIZE] = {
-    {
-        {
-            0x0b, 0xc7, 0xbd, 0x43, 0x47, 0x0f, 0x27, 0x1e,
-            0xdd, 0x56, 0x11, 0x75, 0x95, 0x9c, 0xad, 0x06,
-            0xbb, 0x21, 0xd6, 0x4f, 0xa3, 0x14, 0xa7, 0x78,
-            0x87, 0x37, 0x62, 0xe6, 0xff, 0xb4, 0xa5, 0xca
-        },
-        {
-            0x21, 0xa3, 0x3b, 0xa4, 0xeb, 0xd3, 0xdf, 0xf4,
-            0x0b, 0x65, 0x4a, 0x6b, 0x39, 0x0c, 0xb2, 0x8f,
-            0x9e, 0xca, 0x5e, 0x02, 0x88, 0x31, 0xb9, 0x40,
-            0x79, 0xea, 0x43, 0xb9, 0x7f, 0x1b, 0xff, 0xfc
-        },
-        {
-            0x31, 0x85, 0xad, 0xbd, 0xc9, 0x32, 0x10, 0x52,
-            0x2a, 0xe0, 0xcc, 0x0e, 0xab, 0x26, 0xcc, 0x70,
-            0x77, 0xa1, 0x4f, 0x12, 0x63, 0xf1, 0x71, 0x4c,
-            0xdc, 0xe8, 0xe4, 0xcd, 0x29, 0x32, 0x08, 0xb1
-        }
-    },
-    {
-        {
-            0x16, 0x4c, 0xd4, 0x51, 0x38, 0x65, 0x25, 0x70,
-            0xac, 0x04, 0x42, 0xe3, 0x5c, 0xde, 0x96, 0xaa,
-            0x4f, 0xb2, 0x4c, 0x86, 0x98, 0x3b, 0xb1, 0xb2,
-            0xb1, 0x62, 0x07, 0x58, 0xf5, 0xca, 0xf3, 0x18
-        },
-        {
-            0x25, 0xde, 0x16, 0x27, 0xec, 0x1a, 0x57, 0x54,
-            0xe9, 0xc0, 0xdb, 0x69, 0x69, 0xb0, 0xcc, 0x16,
-            0xa0, 0x8f, 0x57, 0x22, 0x5c, 0x1f, 0xfd, 0x9d,
-            0xb8, 0x33, 0xab, 0xc2, 0x04, 0xf5, 0x61, 0x2b
-        },
-        {
-            0x1f, 0x69, 0x0f, 0x93, 0x72, 0xcc, 0xa3, 0xa6,
-            0x45, 0x30, 0x46, 0x89, 0x36, 0x7c, 0x2e, 0x0c,
-            0x82, 0x32, 0x41, 0xc6, 0x8d, 0xd5, 0xea, 0xeb,
-            0x67, 0xbe, 0x04, 0xf3, 0x51, 0x68, 0x0a, 0x4f
-        }
-    },
-    {
-        {
-            0x06, 0xc3, 0x64, 0x44, 0x0a, 0xa3, 0xb6, 0xcf,
-            0x17, 0x61, 0x5d, 0x71, 0x14, 0xa8, 0x7b, 0xdd,
-            0x15, 0x91, 0x7e, 0xe6, 0xc2, 0xd6, 0xec, 0x84,
-            0x51, 0x33, 0x6a, 0xde, 0xad, 0x4a, 0xb5, 0xa7
-        },
-        {
-            0x25, 0x0b, 0x79, 0x7d, 0x72, 0xca, 0xb6, 0xbd,
-            0xcf, 0x47, 0x52, 0x08, 0x51, 0xe6, 0xd9, 0xe0,
-            0x69, 0x92, 0x7f, 0xf5, 0x9c, 0xa0, 0x03, 0x8c,
-            0x81, 0xfa, 0xb3, 0xc8, 0xf2, 0xec, 0x22, 0x61
-        },
-        {
-            0x25, 0x57, 0x46, 0x0f, 0x35, 0x63, 0xba, 0x3a,
-            0xa6, 0xc4, 0xa8, 0x26, 0xba, 0x86, 0x39, 0x37,
-            0x71, 0x29, 0xac, 0xef, 0x2f, 0x25, 0x89, 0xb1,
-            0x30, 0x2d, 0xcc, 0x8b, 0x61, 0xee, 0xa7, 0xbf
-        }
-    }
-};
+// Round keys, MDS matrix and initial states, generated by the build in
+// the native form of the arithmetic backend (utils/gen_poseidon_constants.py)
+#include "poseidon_constants.h"
 
-// Initial sponge state testnet
-static const State TESTNET_IV = {
-    {
-        0x3e, 0x32, 0x37, 0x18, 0xb3, 0xfe, 0x2a, 0x3d,
-        0x6a, 0x27, 0x89, 0x07, 0xaf, 0xa2, 0xa9, 0xfc,
-        0x7d, 0x17, 0x93, 0x3d, 0x1e, 0xf7, 0xc6, 0x65,
-        0x50, 0x07, 0xb9, 0x62, 0xb8, 0xc8, 0x53, 0x92
-    },
-    {
-        0x37, 0x0a, 0x1c, 0x8b, 0x48, 0x37, 0x40, 0xa5,
-        0xcc, 0xe5, 0xc5, 0x0c, 0x92, 0xcb, 0x64, 0xb9,
-        0x64, 0xaf, 0x7d, 0x48, 0xa0, 0x24, 0x8c, 0x54,
-        0xd1, 0x03, 0x2c, 0x6a, 0x3d, 0xe4, 0x4e, 0x99
-    },
-    {
-        0x07, 0x1c, 0x33, 0x03, 0xf0, 0x2d, 0x91, 0x1a,
-        0xff, 0xae, 0xfb, 0x48, 0x9e, 0x71, 0x4b, 0x51,
-        0xd7, 0xe1, 0x8e, 0x31, 0xb3, 0x2d, 0x83, 0x9c,
-        0xfd, 0x3d, 0x55, 0x33, 0x46, 0xc1, 0x0d, 0x36
-    }
-};
-
-// Initial sponge state mainnet
-static const State MAINNET_IV = {
-    {
-        0x37, 0xc2, 0x22, 0xad, 0x32, 0x09, 0x47, 0x70,
-        0xdb, 0xd1, 0x37, 0x64, 0xc7, 0xb0, 0xa0, 0x52,
-        0xfd, 0x6c, 0x78, 0x04, 0x47, 0x38, 0x88, 0x4b,
-        0x33, 0xd6, 0x1d, 0xd9, 0xa9, 0xa4, 0x96, 0x94
-    },
-    {
-        0x10, 0xb8, 0xdf, 0x53, 0x5d, 0x1a, 0xde, 0x92,
-        0xdb, 0x67, 0x28, 0xcf, 0xf8, 0x56, 0xf1, 0xf7,
-        0x88, 0xa0, 0x29, 0xe4, 0x43, 0x16, 0xad, 0x76,
-        0xd9, 0x71, 0x10, 0x55, 0xc6, 0x9c, 0xd3, 0x33
-    },
-    {
-        0x00, 0x61, 0x38, 0x94, 0xaa, 0xc2, 0xc3, 0x50,
-        0xc0, 0x1e, 0x37, 0x8e, 0x01, 0x3a, 0xd5, 0x59,
-        0xb8, 0x1e, 0x87, 0xdc, 0xed, 0x63, 0xd7, 0xf1,
-        0xf5, 0x6d, 0xa9, 0x90, 0x8a, 0x21, 0xe6, 0xe4
-    }
-};
+#ifndef POSEIDON_CONSTANTS_MONT64
 
 // Used by sbox(), α = 5
 static const Field FIELD_FIVE = {
@@ -1467,6 +83,9 @@ void poseidon_permutation(State s)
 {
     Field tmp;
 
+    STATS_OP(STATS_POSEIDON_PERMUTATION);
+    OP_COUNT(OP_POSEIDON_PERMUTATION);
+
     // Full rounds
     for (size_t r = 0; r < FULL_ROUNDS; r++) {
         // ark
@@ -1491,6 +110,51 @@ void poseidon_permutation(State s)
         field_add(s[i], tmp, round_keys[ROUNDS - 1][i]);
     }
 }
+#else
+// Same permutation with the state in the Montgomery domain of the host
+// arithmetic, converted once on entry and exit
+void poseidon_permutation(State s)
+{
+    const cx_mont_ctx_t *ctx = cx_mont_ctx(POSEIDON_MODULUS, FIELD_BYTES);
+    cx_mont_t x[SPONGE_SIZE], y[SPONGE_SIZE], t;
+
+    STATS_OP(STATS_POSEIDON_PERMUTATION);
+    OP_COUNT(OP_POSEIDON_PERMUTATION);
+
+    for (size_t i = 0; i < SPONGE_SIZE; i++) {
+        cx_mont_from_bytes(x[i], s[i], FIELD_BYTES, ctx);
+    }
+
+    // Full rounds
+    for (size_t r = 0; r < FULL_ROUNDS; r++) {
+        for (size_t i = 0; i < SPONGE_SIZE; i++) {
+            // ark
+            cx_mont_add(x[i], x[i], round_keys[r][i], ctx);
+
+            // sbox, x^5
+            cx_mont_mul(t, x[i], x[i], ctx);
+            cx_mont_mul(t, t, t, ctx);
+            cx_mont_mul(x[i], t, x[i], ctx);
+        }
+
+        // mds
+        for (size_t row = 0; row < SPONGE_SIZE; row++) {
+            cx_mont_mul(y[row], x[0], mds_matrix[row][0], ctx);
+            for (size_t col = 1; col < SPONGE_SIZE; col++) {
+                cx_mont_mul(t, x[col], mds_matrix[row][col], ctx);
+                cx_mont_add(y[row], y[row], t, ctx);
+            }
+        }
+        memcpy(x, y, sizeof(x));
+    }
+
+    // Final ark
+    for (size_t i = 0; i < SPONGE_SIZE; i++) {
+        cx_mont_add(x[i], x[i], round_keys[ROUNDS - 1][i], ctx);
+        cx_mont_to_bytes(s[i], FIELD_BYTES, x[i], ctx);
+    }
+}
+#endif
 
 inline void poseidon_init(State s, const uint8_t network_id)
 {
@@ -0,0 +1,302 @@
+#include <string.h>
+
+#include "pubkey_cache.h"
+#include "globals.h"
+
+#define SEED_FINGERPRINT_TAG "MinaPubkeyCache"
+
+typedef struct {
+    bool     valid;
+    bool     persisted;
+    uint32_t account;
+    Affine   pub;
+    char     address[MINA_ADDRESS_LEN];
+} pubkey_cache_entry_t;
+
+static pubkey_cache_entry_t _cache[PUBKEY_CACHE_SIZE];
+static uint8_t              _next;
+static bool                 _nvm_checked;
+
+static pubkey_cache_entry_t *lookup(const uint32_t account)
+{
+    for (size_t i = 0; i < PUBKEY_CACHE_SIZE; i++) {
+        if (_cache[i].valid && _cache[i].account == account) {
+            return &_cache[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void insert(const uint32_t account, const Affine *pub, const char *address,
+                   const bool persisted)
+{
+    pubkey_cache_entry_t *entry = &_cache[_next];
+    _next = (_next + 1) % PUBKEY_CACHE_SIZE;
+
+    entry->valid = true;
+    entry->persisted = persisted;
+    entry->account = account;
+    memcpy(&entry->pub, pub, sizeof(entry->pub));
+    memcpy(entry->address, address, sizeof(entry->address));
+}
+
+// Fingerprint of the seed, derived from the chain code of account 0 so
+// that no scalar multiplication is needed to check it
+static void seed_fingerprint(uint8_t *fingerprint)
+{
+    const uint32_t bip32_path[BIP32_PATH_LEN] = {
+        44    | BIP32_HARDENED_OFFSET,
+        12586 | BIP32_HARDENED_OFFSET,
+        0     | BIP32_HARDENED_OFFSET,
+        0,
+        0
+    };
+
+    struct {
+        char    tag[sizeof(SEED_FINGERPRINT_TAG) - 1];
+        uint8_t chain[32];
+    } msg;
+    Scalar  priv;
+    uint8_t hash[CX_SHA256_SIZE];
+
+    BEGIN_TRY {
+        TRY {
+            memcpy(msg.tag, SEED_FINGERPRINT_TAG, sizeof(msg.tag));
+            os_perso_derive_node_bip32(CX_CURVE_256K1, bip32_path, BIP32_PATH_LEN, priv, msg.chain);
+            cx_hash_sha256((const unsigned char *)&msg, sizeof(msg), hash, sizeof(hash));
+            memcpy(fingerprint, hash, NVM_SEED_FINGERPRINT_LEN);
+        }
+        FINALLY {
+            explicit_bzero(priv, sizeof(priv));
+            explicit_bzero(&msg, sizeof(msg));
+        }
+        END_TRY;
+    }
+}
+
+// Checksum binding an entry to the cache version and seed fingerprint, so
+// that rewriting the header invalidates every entry
+static void entry_checksum(uint8_t *checksum, const nvm_pubkey_entry_t *entry)
+{
+    struct {
+        nvm_pubkey_header_t header;
+        uint32_t            account;
+        uint32_t            seq;
+        Affine              pub;
+        char                address[MINA_ADDRESS_LEN];
+    } msg;
+    uint8_t hash[CX_SHA256_SIZE];
+
+    memset(&msg, 0, sizeof(msg)); // padding after the header
+    memmove(&msg.header, (const void *)&N_storage.cache_header, sizeof(msg.header));
+    msg.account = entry->account;
+    msg.seq = entry->seq;
+    memmove(&msg.pub, &entry->pub, sizeof(msg.pub));
+    memmove(msg.address, entry->address, sizeof(msg.address));
+
+    cx_hash_sha256((const unsigned char *)&msg, sizeof(msg), hash, sizeof(hash));
+    memcpy(checksum, hash, NVM_PUBKEY_CHECKSUM_LEN);
+}
+
+// Reads entry i, returns false if it is not valid for this seed
+static bool nvm_read(const size_t i, nvm_pubkey_entry_t *entry)
+{
+    uint8_t checksum[NVM_PUBKEY_CHECKSUM_LEN];
+
+    memmove(entry, (const void *)&N_storage.cache[i], sizeof(*entry));
+    entry_checksum(checksum, entry);
+
+    return memcmp(checksum, entry->checksum, sizeof(checksum)) == 0;
+}
+
+// Invalidates the NVM cache if its version or the seed changed.  The seed
+// fingerprint costs a BIP32 derivation, so this is deferred to the first
+// time the NVM cache is used instead of being done at every start.
+static void nvm_check(void)
+{
+    nvm_pubkey_header_t header;
+
+    if (_nvm_checked) {
+        return;
+    }
+
+    header.version = NVM_PUBKEY_CACHE_VERSION;
+    seed_fingerprint(header.seed_fingerprint);
+    if (memcmp(&header, (const void *)&N_storage.cache_header, sizeof(header)) != 0) {
+        // A single write, the entries' checksums no longer match
+        nvm_write((void *)&N_storage.cache_header, (void *)&header, sizeof(header));
+    }
+    _nvm_checked = true;
+}
+
+// Checks that an entry's address is the encoding of its public key, as
+// both are shown to the user and the checksum is too short to vouch for
+// them.  Encoding is a SHA-256d and a base58 pass, much cheaper than the
+// derivation it saves.
+static bool nvm_entry_matches(const nvm_pubkey_entry_t *entry)
+{
+    char address[MINA_ADDRESS_LEN];
+
+    if (entry->address[MINA_ADDRESS_LEN - 1] != '\0' || !affine_is_on_curve(&entry->pub)) {
+        return false;
+    }
+    if (!generate_address(address, sizeof(address), &entry->pub)) {
+        return false;
+    }
+
+    return memcmp(address, entry->address, sizeof(address)) == 0;
+}
+
+static bool nvm_lookup(const uint32_t account, Affine *pub, char *address)
+{
+    nvm_pubkey_entry_t entry;
+
+    nvm_check();
+    for (size_t i = 0; i < NVM_PUBKEY_CACHE_SIZE; i++) {
+        if (N_storage.cache[i].account != account) {
+            continue;
+        }
+
+        if (!nvm_read(i, &entry) || !nvm_entry_matches(&entry)) {
+            continue;
+        }
+
+        memcpy(pub, &entry.pub, sizeof(*pub));
+        memcpy(address, entry.address, MINA_ADDRESS_LEN);
+        return true;
+    }
+
+    return false;
+}
+
+// Writes a new entry over the first invalid one, or else the least
+// recently written one.  The write order is kept in the entries, so that
+// an insertion is a single NVM write.
+static void nvm_insert(const uint32_t account, const Affine *pub, const char *address)
+{
+    nvm_pubkey_entry_t entry;
+    size_t   slot = NVM_PUBKEY_CACHE_SIZE, oldest = 0;
+    uint32_t seq = 0, oldest_seq = UINT32_MAX;
+
+    nvm_check();
+    for (size_t i = 0; i < NVM_PUBKEY_CACHE_SIZE; i++) {
+        if (!nvm_read(i, &entry)) {
+            if (slot == NVM_PUBKEY_CACHE_SIZE) {
+                slot = i;
+            }
+            continue;
+        }
+        if (entry.seq >= seq) {
+            seq = entry.seq + 1;
+        }
+        if (entry.seq < oldest_seq) {
+            oldest_seq = entry.seq;
+            oldest = i;
+        }
+    }
+    if (slot == NVM_PUBKEY_CACHE_SIZE) {
+        slot = oldest;
+    }
+
+    entry.account = account;
+    entry.seq = seq;
+    memcpy(&entry.pub, pub, sizeof(entry.pub));
+    memcpy(entry.address, address, sizeof(entry.address));
+    entry_checksum(entry.checksum, &entry);
+
+    nvm_write((void *)&N_storage.cache[slot], (void *)&entry, sizeof(entry));
+}
+
+// Gets the public key and address of account from the cache, without
+// deriving them on a miss
+bool pubkey_cache_lookup(Affine *pub, char *address, const size_t len,
+                         const uint32_t account)
+{
+    if (len != MINA_ADDRESS_LEN) {
+        return false;
+    }
+
+    const pubkey_cache_entry_t *entry = lookup(account);
+    if (entry) {
+        memcpy(pub, &entry->pub, sizeof(*pub));
+        memcpy(address, entry->address, len);
+        return true;
+    }
+
+    if (nvm_lookup(account, pub, address)) {
+        insert(account, pub, address, true);
+        return true;
+    }
+
+    return false;
+}
+
+// Caches a public key and address the caller derived itself, for the
+// session only until pubkey_cache_persist()
+void pubkey_cache_put(const uint32_t account, const Affine *pub, const char *address)
+{
+    insert(account, pub, address, false);
+}
+
+// Persists the cached entry of an account the user confirmed on screen.
+// The cache only saves work, so a failed NVM write is ignored rather than
+// failing the command the user just approved.
+void pubkey_cache_persist(const uint32_t account)
+{
+    pubkey_cache_entry_t *entry = lookup(account);
+    if (!entry || entry->persisted) {
+        return;
+    }
+
+    BEGIN_TRY {
+        TRY {
+            nvm_insert(account, &entry->pub, entry->address);
+            entry->persisted = true;
+        }
+        CATCH_OTHER(e) {
+        }
+        FINALLY {
+        }
+        END_TRY;
+    }
+}
+
+// Gets the public key and address of account, deriving them on a cache miss
+bool pubkey_cache_get(Affine *pub, char *address, const size_t len,
+                      const uint32_t account)
+{
+    if (pubkey_cache_lookup(pub, address, len, account)) {
+        return true;
+    }
+    if (len != MINA_ADDRESS_LEN) {
+        return false;
+    }
+
+    BEGIN_TRY {
+        Keypair kp;
+        TRY {
+            generate_keypair(&kp, account);
+            memcpy(pub, &kp.pub, sizeof(*pub));
+        }
+        FINALLY {
+            explicit_bzero(kp.priv, sizeof(kp.priv));
+        }
+        END_TRY;
+    }
+
+    if (!generate_address(address, len, pub)) {
+        return false;
+    }
+
+    pubkey_cache_put(account, pub, address);
+
+    return true;
+}
+
+// Clears the session (RAM) cache, the NVM cache persists
+void pubkey_cache_clear(void)
+{
+    explicit_bzero(_cache, sizeof(_cache));
+    _next = 0;
+}
@@ -0,0 +1,29 @@
+// Public key cache
+//
+//     Deriving the public key of an account costs a full scalar
+//     multiplication, so the results are cached in RAM for the
+//     duration of the app session.  Accounts the user confirmed on
+//     screen are also persisted in NVM (N_storage), the most recently
+//     confirmed ones replacing the oldest.  The RAM cache is cleared on
+//     exit and the NVM cache is checked on its first use, and
+//     invalidated if its version or the seed fingerprint no longer
+//     match.  An entry read back from NVM is only used if its address
+//     is the encoding of its public key.
+
+#pragma once
+
+#include "crypto.h"
+
+#ifdef TARGET_NANOX
+    #define PUBKEY_CACHE_SIZE 8
+#else
+    #define PUBKEY_CACHE_SIZE 2
+#endif
+
+bool pubkey_cache_get(Affine *pub, char *address, const size_t len,
+                      const uint32_t account);
+bool pubkey_cache_lookup(Affine *pub, char *address, const size_t len,
+                         const uint32_t account);
+void pubkey_cache_put(const uint32_t account, const Affine *pub, const char *address);
+void pubkey_cache_persist(const uint32_t account);
+void pubkey_cache_clear(void);
@@ -225,3 +225,98 @@ int roinput_hash_message(Field *out, const size_t len, const Affine *pub, const
 
     return roinput_to_fields(out, len, &input);
 }
+
+void roinput_packer_init(ROInputPacker *p)
+{
+    p->carry = 0;
+    p->carry_bits = 0;
+}
+
+// Appends nbits bits to the byte stream, writing the completed bytes to out
+// (at most nbits/8 + 1 bytes).  Returns the number of bytes written.
+size_t roinput_pack_bits(ROInputPacker *p, uint8_t *out, const uint8_t *bits, const size_t nbits)
+{
+    size_t out_len = 0;
+
+    // Whole bytes
+    for (size_t i = 0; i < nbits / 8; i++) {
+        out[out_len++] = p->carry | (uint8_t)(bits[i] << p->carry_bits);
+        p->carry = p->carry_bits ? bits[i] >> (8 - p->carry_bits) : 0;
+    }
+
+    // Remaining bits
+    size_t remaining = nbits % 8;
+    if (remaining) {
+        uint16_t b = bits[nbits / 8] & ((1 << remaining) - 1);
+        b = p->carry | (b << p->carry_bits);
+        remaining += p->carry_bits;
+        if (remaining >= 8) {
+            out[out_len++] = b & 0xff;
+            b >>= 8;
+            remaining -= 8;
+        }
+        p->carry = b;
+        p->carry_bits = remaining;
+    }
+
+    return out_len;
+}
+
+// Writes the final partial byte, if any.  Returns the number of bytes written.
+size_t roinput_pack_flush(ROInputPacker *p, uint8_t *out)
+{
+    size_t out_len = 0;
+
+    if (p->carry_bits) {
+        out[out_len++] = p->carry;
+    }
+    roinput_packer_init(p);
+
+    return out_len;
+}
+
+void roinput_field_packer_init(ROInputFieldPacker *p)
+{
+    explicit_bzero(p->chunk, sizeof(p->chunk));
+    p->chunk_bits = 0;
+}
+
+static void field_packer_emit(ROInputFieldPacker *p, Field out)
+{
+    for (size_t i = FIELD_BYTES; i > 0; i--) {
+        out[i - 1] = p->chunk[FIELD_BYTES - i];
+    }
+    roinput_field_packer_init(p);
+}
+
+// Packs bits [offset, offset + nbits) into field elements, stopping as soon
+// as one is completed, in which case it is written to out and *ready is set.
+// Returns the number of bits consumed.
+size_t roinput_field_pack_bits(ROInputFieldPacker *p, Field out, bool *ready, const uint8_t *bits, const size_t offset, const size_t nbits)
+{
+    const size_t MAX_CHUNK_SIZE = FIELD_BITS - 1;
+
+    *ready = false;
+    for (size_t i = 0; i < nbits; i++) {
+        packed_bit_array_set(p->chunk, p->chunk_bits, packed_bit_array_get(bits, offset + i));
+        p->chunk_bits += 1;
+        if (p->chunk_bits == MAX_CHUNK_SIZE) {
+            field_packer_emit(p, out);
+            *ready = true;
+            return i + 1;
+        }
+    }
+
+    return nbits;
+}
+
+// Writes the final partial field element, if any, and returns whether it did
+bool roinput_field_pack_flush(ROInputFieldPacker *p, Field out)
+{
+    if (p->chunk_bits == 0) {
+        return false;
+    }
+    field_packer_emit(p, out);
+
+    return true;
+}
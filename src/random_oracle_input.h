@@ -14,6 +14,21 @@ struct roinput_t {
     size_t  bits_capacity;   // in bytes
 };
 
+// Streaming packers
+//
+//     Produce the same output as roinput_to_bytes() and roinput_to_fields()
+//     without holding the whole input in memory, so that arbitrarily long
+//     inputs can be hashed in chunks.  Bits are given as packed bit arrays.
+typedef struct roinput_packer_t {
+    uint8_t carry;      // pending bits of the next output byte
+    uint8_t carry_bits; // number of pending bits
+} ROInputPacker;
+
+typedef struct roinput_field_packer_t {
+    Field  chunk;      // little endian bits of the pending field element
+    size_t chunk_bits; // number of pending bits
+} ROInputFieldPacker;
+
 #define roinput_create(fs, bs) { \
     .fields = fs, \
     .fields_capacity = ARRAY_LEN(fs), \
@@ -28,4 +43,10 @@ void roinput_add_bytes(ROInput *input, const uint8_t *bytes, size_t len);
 void roinput_add_uint32(ROInput *input, const uint32_t x);
 void roinput_add_uint64(ROInput *input, const uint64_t x);
 int roinput_derive_message(uint8_t *out, const size_t len, const Keypair *kp, const ROInput *msg, const uint8_t network_id);
+void roinput_packer_init(ROInputPacker *p);
+size_t roinput_pack_bits(ROInputPacker *p, uint8_t *out, const uint8_t *bits, const size_t nbits);
+size_t roinput_pack_flush(ROInputPacker *p, uint8_t *out);
+void roinput_field_packer_init(ROInputFieldPacker *p);
+size_t roinput_field_pack_bits(ROInputFieldPacker *p, Field out, bool *ready, const uint8_t *bits, const size_t offset, const size_t nbits);
+bool roinput_field_pack_flush(ROInputFieldPacker *p, Field out);
 int roinput_hash_message(Field *out, const size_t len, const Affine *pub, const Field rx, const ROInput *msg);
@@ -0,0 +1,352 @@
+#include "menu.h"
+#include "sign_msg.h"
+#include "utils.h"
+#include "crypto.h"
+#include "msg_stream.h"
+#include "pubkey_cache.h"
+
+// Message signing
+//
+//     The message is streamed twice over chained APDUs (see msg_stream.h)
+//
+//     P2_DERIVE, P1_FIRST: account (4) | network_id (1) | length (4) | message
+//     P2_HASH,   P1_FIRST: message
+//     P1_MORE continues the current pass with more of the message.
+
+#define P2_DERIVE 0x00
+#define P2_HASH   0x01
+
+#define SIGN_MSG_HEADER_LEN 9
+
+// The nonce is held from the end of the derive pass until the message is
+// signed or rejected.  It is cleared by any other command and once
+// SIGN_MSG_TIMEOUT_TICKS pass without a message APDU, which also rejects
+// an abandoned review.
+#define SIGN_MSG_TIMEOUT_TICKS 600 // 60 s of 100 ms ticker events
+
+// The message's part of the signing state shared with sign_tx.c
+#define _msg    (G_sign_state.u.msg.stream)
+#define _msg_ui (G_sign_state.u.msg.ui)
+
+static uint16_t _msg_ticks;
+
+static void clear_message(void)
+{
+    // Clear nonce from memory
+    sign_state_release(SIGN_STATE_MSG);
+    _msg_ticks = 0;
+}
+
+static void preview_update(const size_t offset, const uint8_t *data, const size_t len)
+{
+    for (size_t i = 0; i < len && offset + i < SIGN_MSG_PREVIEW_LEN; i++) {
+        // Only show printable characters
+        char c = data[i];
+        _msg_ui.preview[offset + i] = (c >= 0x20 && c < 0x7f) ? c : '.';
+    }
+}
+
+static void sign_msg_derive(const uint8_t p1, const uint8_t *data, size_t len)
+{
+    if (p1 == P1_FIRST) {
+        Affine pub;
+
+        sign_state_take(SIGN_STATE_MSG);
+        if (len < SIGN_MSG_HEADER_LEN) {
+            THROW(INVALID_PARAMETER);
+        }
+
+        const uint32_t account = read_uint32_be(data);
+        const uint8_t network_id = data[4];
+        const uint32_t msg_len = read_uint32_be(data + 5);
+        if (network_id != TESTNET_ID && network_id != MAINNET_ID) {
+            THROW(INVALID_PARAMETER);
+        }
+        if (msg_len > SIGN_MSG_MAX_LEN) {
+            THROW(INVALID_PARAMETER);
+        }
+        data += SIGN_MSG_HEADER_LEN;
+        len -= SIGN_MSG_HEADER_LEN;
+
+        if (!pubkey_cache_get(&pub, _msg_ui.address, sizeof(_msg_ui.address), account)) {
+            THROW(INVALID_PARAMETER);
+        }
+        msg_stream_init(&_msg, account, network_id, msg_len, &pub);
+    }
+    else if (p1 != P1_MORE) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    if (!msg_stream_derive(&_msg, data, len)) {
+        THROW(INVALID_PARAMETER);
+    }
+}
+
+// Returns true once the whole message has been received
+static bool sign_msg_hash(const uint8_t p1, const uint8_t *data, const size_t len)
+{
+    if (p1 == P1_FIRST) {
+        if (!msg_stream_hash_init(&_msg)) {
+            THROW(INVALID_PARAMETER);
+        }
+        explicit_bzero(_msg_ui.preview, sizeof(_msg_ui.preview));
+    }
+    else if (p1 != P1_MORE) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    const size_t offset = _msg.received;
+    if (!msg_stream_hash(&_msg, data, len)) {
+        THROW(INVALID_PARAMETER);
+    }
+    preview_update(offset, data, len);
+
+    return _msg.state == MSG_STREAM_DONE;
+}
+
+static void sign_message(void)
+{
+    Signature sig;
+
+    BEGIN_TRY {
+        TRY {
+            if (G_sign_state.owner != SIGN_STATE_MSG || _msg.state != MSG_STREAM_DONE) {
+                THROW(INVALID_PARAMETER);
+            }
+            pubkey_cache_persist(_msg.account);
+            if (!msg_stream_sign(&_msg, &sig)) {
+                THROW(INVALID_PARAMETER);
+            }
+        }
+        FINALLY {
+            // Runs from the UX callback, clear the nonce even on error
+            clear_message();
+        }
+        END_TRY;
+    }
+
+    memmove(G_io_apdu_buffer, &sig, sizeof(sig));
+    sendResponse(sizeof(sig), true);
+}
+
+UX_STEP_NOCB_INIT(
+    ux_sign_msg_done_flow_done_step,
+    pb,
+    sign_message(),
+    {
+        &C_icon_validate_14,
+        "Done"
+    }
+);
+
+UX_FLOW(
+    ux_sign_msg_done_flow,
+    &ux_sign_msg_done_flow_done_step
+);
+
+#ifdef HAVE_ON_DEVICE_UNIT_TESTS
+    UX_STEP_TIMEOUT(
+        ux_sign_msg_flow_unit_tests_step,
+        pb,
+        1,
+        ux_sign_msg_done_flow,
+        {
+            &C_icon_processing,
+            "Unit tests..."
+        }
+    );
+
+    UX_FLOW(
+        ux_sign_msg_flow,
+        &ux_sign_msg_flow_unit_tests_step
+    );
+#else
+    UX_STEP_TIMEOUT(
+        ux_sign_msg_comfort_flow_signing_step,
+        pb,
+        1,
+        ux_sign_msg_done_flow,
+        {
+            &C_icon_processing,
+            "Signing..."
+        }
+    );
+
+    UX_FLOW(
+        ux_sign_msg_comfort_flow,
+        &ux_sign_msg_comfort_flow_signing_step
+    );
+
+    UX_STEP_NOCB(
+        ux_sign_msg_flow_topic_step,
+        pnn,
+        {
+            &C_icon_eye,
+            "Sign",
+            "Message"
+        }
+    );
+
+    UX_STEP_NOCB(
+        ux_sign_msg_flow_network_step,
+        bn,
+        {
+            "Network",
+            _msg_ui.network
+        }
+    );
+
+    UX_STEP_NOCB(
+        ux_sign_msg_flow_signer_step,
+        bnnn_paging,
+        {
+            .title = "Signer",
+            .text = _msg_ui.address
+        }
+    );
+
+    UX_STEP_NOCB(
+        ux_sign_msg_flow_message_step,
+        bnnn_paging,
+        {
+            .title = "Message",
+            .text = _msg_ui.preview
+        }
+    );
+
+    UX_STEP_NOCB(
+        ux_sign_msg_flow_length_step,
+        bn,
+        {
+            "Length",
+            _msg_ui.length
+        }
+    );
+
+    UX_STEP_NOCB(
+        ux_sign_msg_flow_digest_step,
+        bnnn_paging,
+        {
+            .title = "SHA-256",
+            .text = _msg_ui.digest
+        }
+    );
+
+    UX_STEP_VALID(
+        ux_sign_msg_flow_approve_step,
+        pb,
+        ux_flow_init(0, ux_sign_msg_comfort_flow, NULL);,
+        {
+            &C_icon_validate_14,
+            "Approve"
+        }
+    );
+
+    static void reject_message(void)
+    {
+        clear_message();
+        sendResponse(0, false);
+    }
+
+    UX_STEP_VALID(
+        ux_sign_msg_flow_reject_step,
+        pb,
+        reject_message(),
+        {
+            &C_icon_crossmark,
+            "Reject"
+        }
+    );
+
+    UX_FLOW(
+        ux_sign_msg_flow,
+        &ux_sign_msg_flow_topic_step,
+        &ux_sign_msg_flow_network_step,
+        &ux_sign_msg_flow_signer_step,
+        &ux_sign_msg_flow_message_step,
+        &ux_sign_msg_flow_length_step,
+        &ux_sign_msg_flow_digest_step,
+        &ux_sign_msg_flow_approve_step,
+        &ux_sign_msg_flow_reject_step
+    );
+#endif
+
+// Clears a message abandoned for another command, without touching the
+// signing state if that command owns it
+void sign_msg_clear(void)
+{
+    clear_message();
+}
+
+// Expires a message left waiting for its next APDU or for review
+void sign_msg_tick(void)
+{
+    if (G_sign_state.owner != SIGN_STATE_MSG) {
+        return;
+    }
+    if (++_msg_ticks < SIGN_MSG_TIMEOUT_TICKS) {
+        return;
+    }
+
+    const bool review = _msg.state == MSG_STREAM_DONE;
+    clear_message();
+    if (review) {
+        // Reject the abandoned review, which no longer has a nonce
+        sendResponse(0, false);
+    }
+}
+
+void handle_sign_msg(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                     uint8_t dataLength, volatile unsigned int *flags)
+{
+    bool review = false;
+
+    _msg_ticks = 0;
+
+    BEGIN_TRY {
+        TRY {
+            switch (p2) {
+                case P2_DERIVE:
+                    sign_msg_derive(p1, dataBuffer, dataLength);
+                    break;
+
+                case P2_HASH:
+                    review = sign_msg_hash(p1, dataBuffer, dataLength);
+                    break;
+
+                default:
+                    THROW(INVALID_PARAMETER);
+            }
+        }
+        CATCH_OTHER(e) {
+            clear_message();
+            THROW(e);
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+
+    if (!review) {
+        // Ready for the next chunk
+        THROW(0x9000);
+    }
+
+    strncpy(_msg_ui.network, _msg.network_id == MAINNET_ID ? "mainnet" : "testnet",
+            sizeof(_msg_ui.network));
+    if (_msg.len > SIGN_MSG_PREVIEW_LEN) {
+        strncpy(&_msg_ui.preview[SIGN_MSG_PREVIEW_LEN], "...", 4);
+    }
+    value_to_string(_msg_ui.length, sizeof(_msg_ui.length), _msg.len);
+
+    static const char hex[] = "0123456789abcdef";
+    for (size_t i = 0; i < CX_SHA256_SIZE; i++) {
+        _msg_ui.digest[2*i] = hex[_msg.digest[i] >> 4];
+        _msg_ui.digest[2*i + 1] = hex[_msg.digest[i] & 0x0f];
+    }
+    _msg_ui.digest[2*CX_SHA256_SIZE] = '\0';
+
+    ux_flow_init(0, ux_sign_msg_flow, NULL);
+
+    *flags |= IO_ASYNCH_REPLY;
+}
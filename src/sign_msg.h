@@ -0,0 +1,13 @@
+#pragma once
+
+#include "globals.h"
+
+// Maximum message length in bytes.  The message is streamed, so this
+// bounds the time the nonce is held and the two passes take, not RAM.
+#define SIGN_MSG_MAX_LEN 4096
+
+void handle_sign_msg(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                     uint8_t dataLength, volatile unsigned int *flags);
+
+void sign_msg_clear(void);
+void sign_msg_tick(void);
@@ -5,60 +5,178 @@
 #include "sign_tx.h"
 #include "utils.h"
 #include "crypto.h"
+#include "pubkey_cache.h"
 #include "random_oracle_input.h"
 #include "parse_tx.h"
 
-static tx_t _tx;
-static ui_t _ui;
+// The transaction's part of the signing state shared with sign_msg.c
+#define _tx      (G_sign_state.u.tx.tx)
+#define _roinput (G_sign_state.u.tx.roinput)
+#define _kp      (G_sign_state.u.tx.kp)
+#define _ctx     (G_sign_state.u.tx.ctx)
+
+// The signature is precomputed while the user reviews the transaction,
+// one bounded step per UX ticker event (see sign_tx_precompute).  Nothing
+// is released until the user approves and everything is cleared on
+// reject, on any other APDU and when the review outlasts
+// PRECOMPUTE_TIMEOUT_TICKS, after which approving computes it afresh.
+#define PRECOMPUTE_TIMEOUT_TICKS 300 // 30 s of 100 ms ticker events
+
+typedef enum {
+    PRECOMPUTE_IDLE = 0,
+    PRECOMPUTE_KEYPAIR, // private key, public key if cached
+    PRECOMPUTE_PUBKEY,  // public key on a cache miss
+    PRECOMPUTE_SIGN,
+    PRECOMPUTE_DONE,
+    PRECOMPUTE_EXPIRED,
+    PRECOMPUTE_ERROR
+} precompute_state_t;
+
+static precompute_state_t _precompute_state = PRECOMPUTE_IDLE;
+static uint16_t           _precompute_ticks;
+
+static void clear_secrets(void)
+{
+    // Clear private key and signing secrets from memory
+    explicit_bzero((void *)&_kp, sizeof(_kp));
+    explicit_bzero((void *)&_ctx, sizeof(_ctx));
+}
 
-static void sign_transaction(void)
+static void clear_transaction(void)
 {
-    char      address[MINA_ADDRESS_LEN];
-    Signature sig;
-    ROInput   roinput;
-    Keypair   kp;
-    bool      error = false;
+    clear_secrets();
+    _precompute_state = PRECOMPUTE_IDLE;
+    _precompute_ticks = 0;
+}
 
-    BEGIN_TRY {
-        TRY {
-            // Get the account's private key and validate corresponding
-            // public key matches the from address
-            generate_keypair(&kp, _tx.account);
-            if (!generate_address(address, sizeof(address), &kp.pub)) {
-                THROW(INVALID_PARAMETER);
-            }
-            if (memcmp(address, _ui.from, sizeof(address)) != 0) {
-                THROW(INVALID_PARAMETER);
-            }
+static bool precompute_pending(void)
+{
+    return _precompute_state == PRECOMPUTE_KEYPAIR
+        || _precompute_state == PRECOMPUTE_PUBKEY
+        || _precompute_state == PRECOMPUTE_SIGN;
+}
 
-            // Create random oracle input from transaction
-            roinput.fields = _tx.input_fields;
-            roinput.fields_capacity = ARRAY_LEN(_tx.input_fields);
-            roinput.bits = _tx.input_bits;
-            roinput.bits_capacity = ARRAY_LEN(_tx.input_bits);
-            transaction_to_roinput(&roinput, &_tx.tx);
+// Validates that the public key matches the from address and starts signing
+static void start_signing(void)
+{
+    if (memcmp(_kp.pub.x, _tx.tx.source_pk.x, sizeof(_kp.pub.x)) != 0
+            || field_is_odd(_kp.pub.y) != _tx.tx.source_pk.is_odd) {
+        THROW(INVALID_PARAMETER);
+    }
 
-            if (!sign(&sig, &kp, &roinput, _tx.network_id)) {
-                THROW(INVALID_PARAMETER);
+    // Create random oracle input from transaction
+    _roinput.fields = _tx.input_fields;
+    _roinput.fields_capacity = ARRAY_LEN(_tx.input_fields);
+    _roinput.bits = _tx.input_bits;
+    _roinput.bits_capacity = ARRAY_LEN(_tx.input_bits);
+    transaction_to_roinput(&_roinput, &_tx.tx);
+
+    sign_init(&_ctx.sign, &_kp, &_roinput, _tx.network_id);
+    _precompute_state = PRECOMPUTE_SIGN;
+}
+
+static void precompute_step(void)
+{
+    char address[MINA_ADDRESS_LEN];
+
+    BEGIN_TRY {
+        TRY {
+            switch (_precompute_state) {
+                case PRECOMPUTE_KEYPAIR:
+                    // Get the account's private key and, if cached, public key
+                    generate_private_key(_kp.priv, _tx.account);
+                    if (pubkey_cache_lookup(&_kp.pub, address, sizeof(address), _tx.account)) {
+                        start_signing();
+                    }
+                    else {
+                        pubkey_init(&_ctx.pubkey, _kp.priv);
+                        _precompute_state = PRECOMPUTE_PUBKEY;
+                    }
+                    break;
+
+                case PRECOMPUTE_PUBKEY:
+                    if (pubkey_step(&_ctx.pubkey, &_kp.pub)) {
+                        if (!generate_address(address, sizeof(address), &_kp.pub)) {
+                            THROW(INVALID_PARAMETER);
+                        }
+                        pubkey_cache_put(_tx.account, &_kp.pub, address);
+                        start_signing();
+                    }
+                    break;
+
+                case PRECOMPUTE_SIGN:
+                    if (!sign_step(&_ctx.sign)) {
+                        THROW(INVALID_PARAMETER);
+                    }
+                    if (_ctx.sign.stage == SIGN_STAGE_DONE) {
+                        // Private key is no longer needed
+                        explicit_bzero((void *)_kp.priv, sizeof(_kp.priv));
+                        _precompute_state = PRECOMPUTE_DONE;
+                    }
+                    break;
+
+                default:
+                    break;
             }
         }
         CATCH_OTHER(e) {
-            error = true;
+            clear_transaction();
+            _precompute_state = PRECOMPUTE_ERROR;
         }
         FINALLY {
-            // Clear private key from memory
-            explicit_bzero((void *)kp.priv, sizeof(kp.priv));
         }
         END_TRY;
     }
+}
+
+void sign_tx_precompute(void)
+{
+    if (!precompute_pending() && _precompute_state != PRECOMPUTE_DONE) {
+        return;
+    }
+
+    if (++_precompute_ticks >= PRECOMPUTE_TIMEOUT_TICKS) {
+        // Do not keep secrets around for an abandoned review
+        clear_secrets();
+        _precompute_state = PRECOMPUTE_EXPIRED;
+    }
+    else if (precompute_pending()) {
+        precompute_step();
+    }
+}
+
+// Clears a transaction abandoned for another command, without touching
+// the signing state if that command owns it
+void sign_tx_clear(void)
+{
+    _precompute_state = PRECOMPUTE_IDLE;
+    _precompute_ticks = 0;
+    sign_state_release(SIGN_STATE_TX);
+}
+
+static void sign_transaction(void)
+{
+    // Finish whatever was not precomputed during review
+    if (_precompute_state == PRECOMPUTE_EXPIRED) {
+        _precompute_state = PRECOMPUTE_KEYPAIR;
+    }
+    while (precompute_pending()) {
+        precompute_step();
+    }
 
-    if (error) {
+    if (_precompute_state != PRECOMPUTE_DONE) {
+        clear_transaction();
         THROW(INVALID_PARAMETER);
     }
 
-    memmove(G_io_apdu_buffer, &sig, sizeof(sig));
+    // Before the response buffer is written, so that nothing can come
+    // between the signature and sendResponse()
+    pubkey_cache_persist(_tx.account);
+
+    memmove(G_io_apdu_buffer, &_ctx.sign.sig, sizeof(_ctx.sign.sig));
+    clear_transaction();
 
-    sendResponse(sizeof(sig), true);
+    sendResponse(sizeof(Signature), true);
 }
 
 UX_STEP_NOCB_INIT(
@@ -109,6 +227,22 @@ UX_FLOW(
         &ux_sign_tx_comfort_flow_signing_step
     );
 
+    // Review fields are formatted into one shared buffer when their step
+    // is entered (see format_tx_field) instead of being kept formatted
+    static char _title[10];
+    static char _display[TX_FIELD_MAX_LEN];
+
+    static void display_field(const tx_field_t field)
+    {
+        format_tx_field(_display, sizeof(_display), &_tx, field);
+    }
+
+    static void display_titled_field(const tx_field_t title, const tx_field_t field)
+    {
+        format_tx_field(_title, sizeof(_title), &_tx, title);
+        display_field(field);
+    }
+
     UX_STEP_NOCB(
         ux_sign_tx_flow_topic_step,
         pnn,
@@ -128,84 +262,93 @@ UX_FLOW(
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_type_step,
         bn,
+        display_field(TX_FIELD_TYPE),
         {
             "Type",
-            _ui.type
+            _display
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_from_step,
         bnnn_paging,
+        display_titled_field(TX_FIELD_FROM_TITLE, TX_FIELD_FROM),
         {
-            .title = _ui.from_title,
-            .text = _ui.from
+            .title = _title,
+            .text = _display
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_to_step,
         bnnn_paging,
+        display_titled_field(TX_FIELD_TO_TITLE, TX_FIELD_TO),
         {
-            .title = _ui.to_title,
-            .text = _ui.to
+            .title = _title,
+            .text = _display
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_amount_step,
         bn,
+        display_field(TX_FIELD_AMOUNT),
         {
             .line1 = "Amount",
-            .line2 = _ui.amount
+            .line2 = _display
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_fee_step,
         bn,
+        display_field(TX_FIELD_FEE),
         {
            "Fee",
-           _ui.fee
+           _display
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_total_step,
         bn,
+        display_field(TX_FIELD_TOTAL),
         {
             "Total",
-            _ui.total
+            _display
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_nonce_step,
         bn,
+        display_field(TX_FIELD_NONCE),
         {
             "Nonce",
-            _ui.nonce
+            _display
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_valid_until_step,
         bn,
+        display_field(TX_FIELD_VALID_UNTIL),
         {
             "Valid until",
-            _ui.valid_until
+            _display
         }
     );
 
-    UX_STEP_NOCB(
+    UX_STEP_NOCB_INIT(
         ux_sign_tx_flow_memo_step,
         bnnn_paging,
+        display_field(TX_FIELD_MEMO),
         {
             .title = "Memo",
-            .text = _ui.memo
+            .text = _display
         }
     );
 
@@ -219,274 +362,58 @@ UX_FLOW(
         }
     );
 
+    static void reject_transaction(void)
+    {
+        clear_transaction();
+        sendResponse(0, false);
+    }
+
     UX_STEP_VALID(
         ux_sign_tx_flow_reject_step,
         pb,
-        sendResponse(0, false),
+        reject_transaction(),
         {
             &C_icon_crossmark,
             "Reject"
         }
     );
 
-    // Unfortunately ux flows cannot be generated dynamically
-    // so we must define 16 static flows...
-
-    UX_FLOW(ux_sign_tx_flow_testnet_payment_0_0,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_network_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_amount_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_total_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_testnet_payment_0_memo,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_network_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_amount_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_total_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_memo_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_testnet_payment_valid_until_0,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_network_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_amount_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_total_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_valid_until_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_testnet_payment_valid_until_memo,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_network_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_amount_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_total_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_valid_until_step,
-            &ux_sign_tx_flow_memo_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_testnet_delegation_0_0,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_network_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_testnet_delegation_0_memo,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_network_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_memo_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_testnet_delegation_valid_until_0,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_network_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_valid_until_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_testnet_delegation_valid_until_memo,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_network_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_valid_until_step,
-            &ux_sign_tx_flow_memo_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_mainnet_payment_0_0,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_amount_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_total_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_mainnet_payment_0_memo,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_amount_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_total_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_memo_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_mainnet_payment_valid_until_0,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_amount_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_total_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_valid_until_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_mainnet_payment_valid_until_memo,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_amount_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_total_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_valid_until_step,
-            &ux_sign_tx_flow_memo_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_mainnet_delegation_0_0,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_mainnet_delegation_0_memo,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_memo_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_mainnet_delegation_valid_until_0,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_valid_until_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    UX_FLOW(ux_sign_tx_flow_mainnet_delegation_valid_until_memo,
-            &ux_sign_tx_flow_topic_step,
-            &ux_sign_tx_flow_type_step,
-            &ux_sign_tx_flow_from_step,
-            &ux_sign_tx_flow_to_step,
-            &ux_sign_tx_flow_fee_step,
-            &ux_sign_tx_flow_nonce_step,
-            &ux_sign_tx_flow_valid_until_step,
-            &ux_sign_tx_flow_memo_step,
-            &ux_sign_tx_flow_approve_step,
-            &ux_sign_tx_flow_reject_step);
-
-    // Create an ux flow index to simplify application logic
-    //
-    #define GET_FLOW_PTR(x) ((const ux_flow_step_t** const )&x)
-    //
-    //     n - network_id       (0 testnet, 1 mainnet)
-    //     t - transaction type (0 payment, 1 delegation)
-    //     v - valid_until      (0 omitted, 1 present)
-    //     m - memo             (0 omitted, 1 present)
-    //                                                  n  t  v  m
-    static const ux_flow_step_t** const ux_sign_tx_flow[2][2][2][2] = {
-        { // testnet
-            { // payment
-                {
-                    GET_FLOW_PTR(ux_sign_tx_flow_testnet_payment_0_0),
-                    GET_FLOW_PTR(ux_sign_tx_flow_testnet_payment_0_memo)
-                },
-                {
-                    GET_FLOW_PTR(ux_sign_tx_flow_testnet_payment_valid_until_0),
-                    GET_FLOW_PTR(ux_sign_tx_flow_testnet_payment_valid_until_memo)
-                }
-            },
-            { // delegation
-                {
-                    GET_FLOW_PTR(ux_sign_tx_flow_testnet_delegation_0_0),
-                    GET_FLOW_PTR(ux_sign_tx_flow_testnet_delegation_0_memo)
-                },
-                {
-                    GET_FLOW_PTR(ux_sign_tx_flow_testnet_delegation_valid_until_0),
-                    GET_FLOW_PTR(ux_sign_tx_flow_testnet_delegation_valid_until_memo)
-                }
-            }
-        },
-        { // mainnet
-            { // payment
-                {
-                    GET_FLOW_PTR(ux_sign_tx_flow_mainnet_payment_0_0),
-                    GET_FLOW_PTR(ux_sign_tx_flow_mainnet_payment_0_memo)
-                },
-                {
-                    GET_FLOW_PTR(ux_sign_tx_flow_mainnet_payment_valid_until_0),
-                    GET_FLOW_PTR(ux_sign_tx_flow_mainnet_payment_valid_until_memo)
-                }
-            },
-            { // delegation
-                {
-                    GET_FLOW_PTR(ux_sign_tx_flow_mainnet_delegation_0_0),
-                    GET_FLOW_PTR(ux_sign_tx_flow_mainnet_delegation_0_memo)
-                },
-                {
-                    GET_FLOW_PTR(ux_sign_tx_flow_mainnet_delegation_valid_until_0),
-                    GET_FLOW_PTR(ux_sign_tx_flow_mainnet_delegation_valid_until_memo)
-                }
-            }
+    // The review flow is assembled for each transaction, skipping the
+    // steps that do not apply, instead of one static flow per combination
+    #define SIGN_TX_FLOW_MAX_STEPS 13
+
+    static const ux_flow_step_t *_flow[SIGN_TX_FLOW_MAX_STEPS + 1];
+
+    static void build_flow(void)
+    {
+        const bool payment = _tx.tag == PAYMENT_TX;
+        size_t n = 0;
+
+        _flow[n++] = &ux_sign_tx_flow_topic_step;
+        if (_tx.network_id != MAINNET_ID) {
+            _flow[n++] = &ux_sign_tx_flow_network_step;
+        }
+        _flow[n++] = &ux_sign_tx_flow_type_step;
+        _flow[n++] = &ux_sign_tx_flow_from_step;
+        _flow[n++] = &ux_sign_tx_flow_to_step;
+        if (payment) {
+            _flow[n++] = &ux_sign_tx_flow_amount_step;
+        }
+        _flow[n++] = &ux_sign_tx_flow_fee_step;
+        if (payment) {
+            _flow[n++] = &ux_sign_tx_flow_total_step;
         }
-    };
+        _flow[n++] = &ux_sign_tx_flow_nonce_step;
+        if (_tx.tx.valid_until != (uint32_t)-1) {
+            _flow[n++] = &ux_sign_tx_flow_valid_until_step;
+        }
+        if (_tx.tx.memo[1] != 0) {
+            _flow[n++] = &ux_sign_tx_flow_memo_step;
+        }
+        _flow[n++] = &ux_sign_tx_flow_approve_step;
+        _flow[n++] = &ux_sign_tx_flow_reject_step;
+        _flow[n] = FLOW_END_STEP;
+    }
 #endif
 
 void handle_sign_tx(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
@@ -495,32 +422,22 @@ void handle_sign_tx(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
     UNUSED(p1);
     UNUSED(p2);
 
-    if (!parse_tx(dataBuffer, dataLength, &_tx, &_ui)) {
+    sign_state_take(SIGN_STATE_TX);
+    clear_transaction();
+
+    if (!parse_tx(dataBuffer, dataLength, &_tx)) {
         THROW(INVALID_PARAMETER);
     }
 
+    // Start computing the signature while the user reviews the transaction
+    _precompute_state = PRECOMPUTE_KEYPAIR;
+
     #ifdef HAVE_ON_DEVICE_UNIT_TESTS
         ux_flow_init(0, ux_sign_tx_unit_test_flow, NULL);
     #else
-        if (_tx.tag == PAYMENT_TX) {
-            strncpy(_ui.type, "Payment", sizeof(_ui.type));
-            strncpy(_ui.from_title, "Sender", sizeof(_ui.from_title));
-            strncpy(_ui.to_title, "Receiver", sizeof(_ui.to_title));
-        }
-        else if (_tx.tag == DELEGATION_TX) {
-            strncpy(_ui.type, "Delegation", sizeof(_ui.type));
-            strncpy(_ui.from_title, "Delegator", sizeof(_ui.from_title));
-            strncpy(_ui.to_title, "Delegate", sizeof(_ui.to_title));
-        }
-
-        // Select the appropriate UX flow
-        int n_idx = _tx.network_id == MAINNET_ID;
-        int t_idx = _tx.tag == DELEGATION_TX;
-        int v_idx = _tx.tx.valid_until != (uint32_t)-1;
-        int m_idx = _ui.memo[0] != '\0';
-
         // Run the UX flow
-        ux_flow_init(0, ux_sign_tx_flow[n_idx][t_idx][v_idx][m_idx], NULL);
+        build_flow();
+        ux_flow_init(0, _flow, NULL);
     #endif
 
     *flags |= IO_ASYNCH_REPLY;
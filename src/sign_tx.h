@@ -4,3 +4,6 @@
 
 void handle_sign_tx(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
                     uint8_t dataLength, volatile unsigned int *flags);
+
+void sign_tx_precompute(void);
+void sign_tx_clear(void);
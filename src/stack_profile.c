@@ -0,0 +1,85 @@
+#include <string.h>
+
+#include "stack_profile.h"
+#include "globals.h"
+
+#ifdef HAVE_STACK_PROFILING
+
+#define STACK_PAINT       0xa5a5a5a5
+#define STACK_PAINT_GUARD 16 // words left unpainted below the current frame
+
+// Bounds of the app stack from the SDK linker script
+extern uint32_t _stack;
+extern uint32_t _estack;
+
+static uint16_t _max_used[STACK_PROFILE_SLOTS];
+static uint8_t  _slot;
+static bool     _painted;
+
+static uint8_t ins_slot(const uint8_t ins)
+{
+    return ins < STACK_PROFILE_SLOTS ? ins : 0;
+}
+
+// Bytes of stack used since the last paint
+static uint16_t stack_used(void)
+{
+    const uint32_t *p = &_stack;
+
+    while (p < &_estack && *p == STACK_PAINT) {
+        p++;
+    }
+    return (uintptr_t)&_estack - (uintptr_t)p;
+}
+
+static void stack_paint(void)
+{
+    volatile uint32_t marker;
+    uint32_t *end = (uint32_t *)&marker - STACK_PAINT_GUARD;
+
+    for (uint32_t *p = &_stack; p < end; p++) {
+        *p = STACK_PAINT;
+    }
+}
+
+void stack_profile_begin(const uint8_t ins)
+{
+    if (_painted) {
+        uint16_t used = stack_used();
+        if (used > _max_used[_slot]) {
+            _max_used[_slot] = used;
+        }
+    }
+
+    _slot = ins_slot(ins);
+    stack_paint();
+    _painted = true;
+}
+
+uint8_t handle_stack_profile(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                             uint8_t dataLength)
+{
+    UNUSED(p2);
+    UNUSED(dataBuffer);
+
+    if (p1 > 0x01 || dataLength != 0) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    uint16_t size = (uintptr_t)&_estack - (uintptr_t)&_stack;
+    uint8_t tx = 0;
+    G_io_apdu_buffer[tx++] = size >> 8;
+    G_io_apdu_buffer[tx++] = size;
+    for (size_t i = 0; i < STACK_PROFILE_SLOTS; i++) {
+        G_io_apdu_buffer[tx++] = _max_used[i] >> 8;
+        G_io_apdu_buffer[tx++] = _max_used[i];
+    }
+
+    if (p1 == 0x01) {
+        memset(_max_used, 0, sizeof(_max_used));
+    }
+
+    return tx;
+}
+
+#endif
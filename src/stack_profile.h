@@ -0,0 +1,27 @@
+// Stack profiling
+//
+//     Debug instrumentation (HAVE_STACK_PROFILING) that measures how much
+//     of the app stack each command uses.  The unused part of the stack is
+//     painted with a pattern when an APDU arrives and, when the next one
+//     arrives, the deepest overwritten word gives the high-water mark of
+//     the previous command, including its UX flow and signing steps.  The
+//     maximum per INS is reported by INS_STACK_PROFILE.
+
+#pragma once
+
+#include <stdint.h>
+
+#define STACK_PROFILE_SLOTS 8 // INS 0x00-0x07, other INS in slot 0
+
+#ifdef HAVE_STACK_PROFILING
+
+// Records the high-water mark of the previous command and repaints the
+// stack for the command ins
+void stack_profile_begin(const uint8_t ins);
+
+// p1 = 0x01 clears the recorded maxima after reporting them
+// Response: stack size (uint16 BE) | max used per slot (uint16 BE each)
+uint8_t handle_stack_profile(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                             uint8_t dataLength);
+
+#endif
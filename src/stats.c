@@ -0,0 +1,92 @@
+#include <string.h>
+
+#include "stats.h"
+#include "globals.h"
+
+#ifdef HAVE_APP_STATS
+
+typedef struct {
+    uint32_t calls;
+    uint32_t total_ticks;
+    uint32_t max_ticks;
+} ins_stats_t;
+
+uint32_t G_stats_ops[STATS_OP_COUNT];
+
+static ins_stats_t _ins[STATS_INS_SLOTS];
+static uint32_t    _ticks;
+static uint32_t    _start;
+static uint8_t     _slot;
+static bool        _running;
+
+void stats_tick(void)
+{
+    _ticks++;
+}
+
+void stats_command_begin(const uint8_t ins)
+{
+    // A command without a response (e.g. a rejected one) ends here
+    stats_command_end();
+
+    _slot = ins < STATS_INS_SLOTS ? ins : 0;
+    _start = _ticks;
+    _running = true;
+    _ins[_slot].calls++;
+}
+
+void stats_command_end(void)
+{
+    if (!_running) {
+        return;
+    }
+    _running = false;
+
+    uint32_t ticks = _ticks - _start;
+    _ins[_slot].total_ticks += ticks;
+    if (ticks > _ins[_slot].max_ticks) {
+        _ins[_slot].max_ticks = ticks;
+    }
+}
+
+static uint8_t write_uint32_be(uint8_t *out, const uint32_t value)
+{
+    out[0] = value >> 24;
+    out[1] = value >> 16;
+    out[2] = value >> 8;
+    out[3] = value;
+    return sizeof(value);
+}
+
+uint8_t handle_get_stats(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                         uint8_t dataLength)
+{
+    UNUSED(p2);
+    UNUSED(dataBuffer);
+
+    if (p1 > 0x01 || dataLength != 0) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    uint8_t tx = 0;
+    tx += write_uint32_be(G_io_apdu_buffer + tx, _ticks);
+    for (size_t i = 0; i < STATS_INS_SLOTS; i++) {
+        tx += write_uint32_be(G_io_apdu_buffer + tx, _ins[i].calls);
+        tx += write_uint32_be(G_io_apdu_buffer + tx, _ins[i].total_ticks);
+        tx += write_uint32_be(G_io_apdu_buffer + tx, _ins[i].max_ticks);
+    }
+    for (size_t i = 0; i < STATS_OP_COUNT; i++) {
+        tx += write_uint32_be(G_io_apdu_buffer + tx, G_stats_ops[i]);
+    }
+
+    if (p1 == 0x01) {
+        // The current INS_GET_STATS command is still accounted
+        memset(_ins, 0, sizeof(_ins));
+        memset(G_stats_ops, 0, sizeof(G_stats_ops));
+        _ins[_slot].calls = 1;
+    }
+
+    return tx;
+}
+
+#endif
@@ -0,0 +1,44 @@
+// Runtime statistics
+//
+//     Per-INS call counts and durations and crypto operation counts for
+//     field diagnostics (HAVE_APP_STATS), reported by INS_GET_STATS.
+//     Durations are counted in SEPROXYHAL ticker events (100 ms) from the
+//     arrival of an APDU to its response, so commands that prompt the user
+//     include the review time; the operation counts attribute the rest.
+
+#pragma once
+
+#include <stdint.h>
+
+#define STATS_INS_SLOTS 9 // INS 0x00-0x08, other INS in slot 0
+
+typedef enum {
+    STATS_SCALAR_MUL = 0,       // complete scalar multiplications
+    STATS_POSEIDON_PERMUTATION,
+    STATS_B58_ENCODE,
+    STATS_B58_DECODE,
+    STATS_OP_COUNT
+} stats_op_t;
+
+#ifdef HAVE_APP_STATS
+
+extern uint32_t G_stats_ops[STATS_OP_COUNT];
+
+#define STATS_OP(op) (G_stats_ops[op]++)
+
+void stats_tick(void);
+void stats_command_begin(const uint8_t ins);
+void stats_command_end(void);
+
+// p1 = 0x01 clears the statistics after reporting them
+// Response: uptime ticks (uint32 BE)
+//           | per INS slot: calls, total ticks, max ticks (uint32 BE each)
+//           | per operation: count (uint32 BE)
+uint8_t handle_get_stats(uint8_t p1, uint8_t p2, uint8_t *dataBuffer,
+                         uint8_t dataLength);
+
+#else
+
+#define STATS_OP(op) do {} while (0)
+
+#endif
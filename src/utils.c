@@ -4,6 +4,7 @@
 
 #include "utils.h"
 #include "crypto.h"
+#include "stats.h"
 
 #ifdef LEDGER_BUILD
     #include <os.h>
@@ -16,54 +17,96 @@ static const char B58_ALPHABET[] = {
     'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'
 };
 
+// The number is converted through limbs in base 58^5 (< 2^30) fed with
+// 32-bit words of input, so each step handles five base58 digits and four
+// input bytes instead of the textbook one digit per pass over every byte.
+// That needs 64-bit divisions, which the Cortex-M0 does not have (they
+// would be __aeabi_uldivmod calls), so the device uses base 58^4 (< 2^24)
+// limbs fed one byte at a time and only 32-bit arithmetic.
+#if defined(__arm__) || defined(B58_NARROW_LIMBS)
+    typedef uint32_t b58_wide_t;
+    #define B58_LIMB_DIGITS 4
+    #define B58_LIMB_BASE   11316496UL // 58^4
+    #define B58_WORD_BYTES  1
+#else
+    typedef uint64_t b58_wide_t;
+    #define B58_LIMB_DIGITS 5
+    #define B58_LIMB_BASE   656356768UL // 58^5
+    #define B58_WORD_BYTES  4
+#endif
+#define B58_MAX_INPUT_LEN 164
+#define B58_MAX_LIMBS     ((B58_MAX_INPUT_LEN * 138 / 100) / B58_LIMB_DIGITS + 1)
+
 // >= 0 : OK
 // -2   : EXCEPTION_OVERFLOW
 // -1   : INVALID_PARAMETER
 int b58_encode(const unsigned char *in, unsigned char length,
                unsigned char *out, const unsigned char maxoutlen)
 {
-    unsigned char tmp[164];
-    unsigned char buffer[164];
-    unsigned char j;
-    unsigned char startAt;
-    unsigned char zeroCount = 0;
-    if (length > sizeof(tmp)) {
+    uint32_t limbs[B58_MAX_LIMBS]; // least significant first
+    size_t   limbs_len = 0;
+    size_t   zeroCount = 0;
+
+    STATS_OP(STATS_B58_ENCODE);
+
+    if (length > B58_MAX_INPUT_LEN) {
         // Input buffer too big
         return -1;
     }
-    memcpy(tmp, in, length);
-    while ((zeroCount < length) && (tmp[zeroCount] == 0)) {
+    while ((zeroCount < length) && (in[zeroCount] == 0)) {
         ++zeroCount;
     }
-    j = 2 * length;
-    startAt = zeroCount;
-    while (startAt < length) {
-        unsigned short remainder = 0;
-        unsigned char divLoop;
-        for (divLoop = startAt; divLoop < length; divLoop++) {
-            unsigned short digit256 = (unsigned short)(tmp[divLoop] & 0xff);
-            unsigned short tmpDiv = remainder * 256 + digit256;
-            tmp[divLoop] = (unsigned char)(tmpDiv / 58);
-            remainder = (tmpDiv % 58);
+
+    // Leading partial word first, then whole words
+    size_t i = zeroCount;
+    while (i < length) {
+        size_t     bytes = (length - i) % B58_WORD_BYTES ? (length - i) % B58_WORD_BYTES : B58_WORD_BYTES;
+        b58_wide_t carry = 0;
+        for (size_t k = 0; k < bytes; k++) {
+            carry = (carry << 8) | in[i++];
+        }
+
+        // limbs = limbs*2^(8*bytes) + word, the carry stays below 2^(8*bytes)
+        for (size_t j = 0; j < limbs_len; j++) {
+            b58_wide_t t = ((b58_wide_t)limbs[j] << (8 * bytes)) | carry;
+            limbs[j] = t % B58_LIMB_BASE;
+            carry = t / B58_LIMB_BASE;
         }
-        if (tmp[startAt] == 0) {
-            ++startAt;
+        while (carry) {
+            limbs[limbs_len++] = carry % B58_LIMB_BASE;
+            carry /= B58_LIMB_BASE;
         }
-        buffer[--j] = (unsigned char)B58_ALPHABET[remainder];
     }
-    while ((j < (2 * length)) && (buffer[j] == B58_ALPHABET[0])) {
-        ++j;
+
+    // Number of significant digits in the top limb
+    size_t top_digits = 0;
+    if (limbs_len) {
+        for (uint32_t top = limbs[limbs_len - 1]; top; top /= 58) {
+            ++top_digits;
+        }
     }
-    while (zeroCount-- > 0) {
-        buffer[--j] = B58_ALPHABET[0];
+
+    size_t outlen = zeroCount;
+    if (limbs_len) {
+        outlen += (limbs_len - 1) * B58_LIMB_DIGITS + top_digits;
     }
-    length = 2 * length - j;
-    if (maxoutlen < length) {
+    if (maxoutlen < outlen) {
         // Output buffer too small
         return -1;
     }
-    memcpy(out, (buffer + j), length);
-    return length;
+
+    unsigned char *p = out + outlen;
+    for (size_t j = 0; j < limbs_len; j++) {
+        size_t   digits = j + 1 < limbs_len ? B58_LIMB_DIGITS : top_digits;
+        uint32_t limb = limbs[j];
+        for (size_t k = 0; k < digits; k++) {
+            *--p = B58_ALPHABET[limb % 58];
+            limb /= 58;
+        }
+    }
+    memset(out, B58_ALPHABET[0], zeroCount);
+
+    return outlen;
 }
 
 /*
@@ -86,6 +129,57 @@ typedef uint64_t b58_maxint_t;
 typedef uint32_t b58_almostmaxint_t;
 #define b58_almostmaxint_bits (sizeof(b58_almostmaxint_t) * 8)
 static const b58_almostmaxint_t b58_almostmaxint_mask = ((((b58_maxint_t)1) << b58_almostmaxint_bits) - 1);
+
+// Fast path for Mina addresses: exactly 55 digits into exactly 40 bytes
+//
+//     Digits are combined five at a time into base 58^5 values (< 2^30),
+//     which are accumulated into ten 32-bit words, and decoding stops at
+//     the first invalid digit.  Returns false for invalid digits or if
+//     the number does not fit in 40 bytes.
+#define B58_ADDRESS_LEN     55
+#define B58_ADDRESS_BIN_LEN 40
+#define B58_ADDRESS_WORDS   (B58_ADDRESS_BIN_LEN / 4)
+#define B58_ADDRESS_BASE    656356768UL // 58^5, multiplied only
+
+static bool b58_decode_address(uint8_t *bin, const unsigned char *b58)
+{
+    uint32_t outi[B58_ADDRESS_WORDS] = { };
+
+    for (size_t i = 0; i < B58_ADDRESS_LEN; i += 5) {
+        const int8_t d0 = B58_DIGITS_MAP[b58[i] & 0x7f];
+        const int8_t d1 = B58_DIGITS_MAP[b58[i + 1] & 0x7f];
+        const int8_t d2 = B58_DIGITS_MAP[b58[i + 2] & 0x7f];
+        const int8_t d3 = B58_DIGITS_MAP[b58[i + 3] & 0x7f];
+        const int8_t d4 = B58_DIGITS_MAP[b58[i + 4] & 0x7f];
+        if (((b58[i] | b58[i + 1] | b58[i + 2] | b58[i + 3] | b58[i + 4]) & 0x80) ||
+            ((d0 | d1 | d2 | d3 | d4) < 0)) {
+            // Invalid base58 digit
+            return false;
+        }
+
+        // outi = outi*58^5 + digits
+        uint64_t c = (((d0*58 + d1)*58 + d2)*58 + d3)*58 + (uint64_t)d4;
+        for (size_t j = B58_ADDRESS_WORDS; j--; ) {
+            uint64_t t = (uint64_t)outi[j] * B58_ADDRESS_BASE + c;
+            outi[j] = (uint32_t)t;
+            c = t >> 32;
+        }
+        if (c) {
+            // Output number too big
+            return false;
+        }
+    }
+
+    for (size_t j = 0; j < B58_ADDRESS_WORDS; j++) {
+        bin[4*j]     = outi[j] >> 24;
+        bin[4*j + 1] = outi[j] >> 16;
+        bin[4*j + 2] = outi[j] >> 8;
+        bin[4*j + 3] = outi[j];
+    }
+
+    return true;
+}
+
 bool b58_decode(void *bin, size_t *binszp, const char *b58, size_t b58sz)
 {
 	size_t binsz = *binszp;
@@ -100,9 +194,20 @@ bool b58_decode(void *bin, size_t *binszp, const char *b58, size_t b58sz)
 	b58_almostmaxint_t zeromask = bytesleft ? (b58_almostmaxint_mask << (bytesleft * 8)) : 0;
 	unsigned zerocount = 0;
 
+	STATS_OP(STATS_B58_DECODE);
+
 	if (!b58sz)
 		b58sz = strlen(b58);
 
+	if (b58sz == B58_ADDRESS_LEN && binsz == B58_ADDRESS_BIN_LEN && b58u[0] != '1') {
+		// No leading zeros, so only leading zero bytes are not canonical
+		if (!b58_decode_address(binu, b58u))
+			return false;
+		for (i = 0; i < binsz && !binu[i]; ++i)
+			--*binszp;
+		return true;
+	}
+
 	for (i = 0; i < outisz; ++i) {
 		outi[i] = 0;
 	}
@@ -0,0 +1,101 @@
+// Base58 encoding benchmark
+//
+//     Compares b58_encode() with the textbook encoder on 40-byte Mina
+//     address payloads, and the 55-character b58_decode() fast path with
+//     the generic decoder.  Run with make b58_bench.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "utils.h"
+#include "b58_reference.h"
+
+#define ADDRESS_PAYLOAD_LEN 40
+#define INPUTS              1024
+#define ROUNDS              200
+
+typedef int (*encode_fn)(const unsigned char *, unsigned char, unsigned char *, const unsigned char);
+
+static unsigned char _inputs[INPUTS][ADDRESS_PAYLOAD_LEN];
+static char          _addresses[INPUTS][MINA_ADDRESS_LEN];
+
+static double bench(encode_fn encode)
+{
+    unsigned char out[MINA_ADDRESS_LEN];
+    struct timespec start, end;
+    unsigned int sum = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < INPUTS; i++) {
+            sum += encode(_inputs[i], ADDRESS_PAYLOAD_LEN, out, sizeof(out));
+            sum += out[0];
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (sum == 0) {
+        printf("unexpected\n");
+    }
+
+    double ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    return ns / (ROUNDS * INPUTS);
+}
+
+// Output buffers of 40 bytes take the fast path, larger ones do not
+static double bench_decode(size_t binsz)
+{
+    uint8_t bin[ADDRESS_PAYLOAD_LEN + 1];
+    struct timespec start, end;
+    unsigned int sum = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < INPUTS; i++) {
+            size_t len = binsz;
+            sum += b58_decode(bin, &len, _addresses[i], MINA_ADDRESS_LEN - 1);
+            sum += bin[binsz - 1];
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (sum == 0) {
+        printf("unexpected\n");
+    }
+
+    double ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    return ns / (ROUNDS * INPUTS);
+}
+
+int main()
+{
+    srand(1);
+    for (size_t i = 0; i < INPUTS; i++) {
+        for (size_t j = 0; j < ADDRESS_PAYLOAD_LEN; j++) {
+            _inputs[i][j] = rand();
+        }
+        // Mina address version bytes
+        _inputs[i][0] = 0xcb;
+        _inputs[i][1] = 0x01;
+        _inputs[i][2] = 0x01;
+        b58_encode(_inputs[i], ADDRESS_PAYLOAD_LEN, (unsigned char *)_addresses[i], MINA_ADDRESS_LEN);
+    }
+
+    double reference = bench(b58_encode_reference);
+    double limbs = bench(b58_encode);
+
+    printf("b58_encode (textbook):  %8.1f ns/address\n", reference);
+    printf("b58_encode (limbs):      %7.1f ns/address\n", limbs);
+    printf("speedup:                 %7.2fx\n", reference / limbs);
+
+    double generic = bench_decode(ADDRESS_PAYLOAD_LEN + 1);
+    double fast = bench_decode(ADDRESS_PAYLOAD_LEN);
+
+    printf("b58_decode (generic):    %7.1f ns/address\n", generic);
+    printf("b58_decode (55 chars):   %7.1f ns/address\n", fast);
+    printf("speedup:                 %7.2fx\n", generic / fast);
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Textbook base58 encoder (one digit per pass over the whole input) that
+// b58_encode() replaced; kept as a reference for tests and benchmarks
+
+#pragma once
+
+#include <string.h>
+
+static int b58_encode_reference(const unsigned char *in, unsigned char length,
+                                unsigned char *out, const unsigned char maxoutlen)
+{
+    static const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    unsigned char tmp[164];
+    unsigned char buffer[328];
+    unsigned short j;
+    unsigned char startAt;
+    unsigned char zeroCount = 0;
+    if (length > sizeof(tmp)) {
+        return -1;
+    }
+    memcpy(tmp, in, length);
+    while ((zeroCount < length) && (tmp[zeroCount] == 0)) {
+        ++zeroCount;
+    }
+    j = 2 * length;
+    startAt = zeroCount;
+    while (startAt < length) {
+        unsigned short remainder = 0;
+        unsigned char divLoop;
+        for (divLoop = startAt; divLoop < length; divLoop++) {
+            unsigned short digit256 = (unsigned short)(tmp[divLoop] & 0xff);
+            unsigned short tmpDiv = remainder * 256 + digit256;
+            tmp[divLoop] = (unsigned char)(tmpDiv / 58);
+            remainder = (tmpDiv % 58);
+        }
+        if (tmp[startAt] == 0) {
+            ++startAt;
+        }
+        buffer[--j] = (unsigned char)alphabet[remainder];
+    }
+    while ((j < (2 * length)) && (buffer[j] == alphabet[0])) {
+        ++j;
+    }
+    while (zeroCount-- > 0) {
+        buffer[--j] = alphabet[0];
+    }
+    length = 2 * length - j;
+    if (maxoutlen < length) {
+        return -1;
+    }
+    memcpy(out, (buffer + j), length);
+    return length;
+}
@@ -0,0 +1,207 @@
+// Crypto micro-benchmarks (host)
+//
+//     Runs the src/benchmark.c cases natively and prints one JSON object
+//     per case for trend tracking.  Cycles and instructions per operation
+//     come from the Linux perf counters when they are available (null
+//     otherwise); times are the best of several runs.
+//
+//     Usage: crypto_bench [-t seconds] [-r runs] [-n iterations] [case...]
+
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "benchmark.h"
+#include "os.h"
+
+#define DEFAULT_RUNS 5
+
+// generate_keypair derives from this seed unless MINA_MNEMONIC is set
+#define TEST_MNEMONIC "course grief vintage slim tell hospital car maze model style " \
+                      "elegant kitchen state purpose matrix gas grid enable frown road " \
+                      "goddess glove canyon key"
+
+typedef struct {
+    double   ns;
+    uint64_t cycles;
+    uint64_t instructions;
+    uint32_t checksum;
+} sample_t;
+
+static int _cycles_fd = -1;
+static int _instructions_fd = -1;
+
+static int perf_open(uint64_t config, int group_fd)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = group_fd < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static void perf_init(void)
+{
+    _cycles_fd = perf_open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (_cycles_fd >= 0) {
+        _instructions_fd = perf_open(PERF_COUNT_HW_INSTRUCTIONS, _cycles_fd);
+    }
+}
+
+static uint64_t perf_read(int fd)
+{
+    uint64_t value = 0;
+    if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value)) {
+        return 0;
+    }
+    return value;
+}
+
+static sample_t run(uint8_t id, uint32_t iterations)
+{
+    struct timespec start, end;
+    sample_t sample;
+
+    if (_cycles_fd >= 0) {
+        ioctl(_cycles_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(_cycles_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    sample.checksum = bench_run(id, iterations);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (_cycles_fd >= 0) {
+        ioctl(_cycles_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    sample.ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+    sample.cycles = perf_read(_cycles_fd);
+    sample.instructions = perf_read(_instructions_fd);
+    return sample;
+}
+
+// Doubles the iterations until one run takes at least target_ns
+static uint32_t calibrate(uint8_t id, double target_ns)
+{
+    uint32_t iterations = 1;
+    while (iterations < (1U << 30)) {
+        sample_t sample = run(id, iterations);
+        if (sample.ns >= target_ns) {
+            break;
+        }
+        iterations *= 2;
+    }
+    return iterations;
+}
+
+static void print_counter(const char *key, uint64_t value, uint32_t iterations)
+{
+    if (value) {
+        printf(", \"%s\": %.1f", key, (double)value / iterations);
+    }
+    else {
+        printf(", \"%s\": null", key);
+    }
+}
+
+static void bench(uint8_t id, double seconds, unsigned runs, uint32_t iterations)
+{
+    if (iterations == 0) {
+        iterations = calibrate(id, seconds * 1e9 / runs);
+    }
+
+    sample_t best = run(id, iterations);
+    for (unsigned r = 1; r < runs; r++) {
+        sample_t sample = run(id, iterations);
+        if (sample.checksum != best.checksum) {
+            fprintf(stderr, "%s: checksum mismatch\n", bench_name(id));
+            exit(1);
+        }
+        if (sample.ns < best.ns) {
+            best = sample;
+        }
+    }
+
+    printf("{\"platform\": \"host\", \"name\": \"%s\", \"iterations\": %u, \"runs\": %u, "
+           "\"ns_per_op\": %.1f", bench_name(id), iterations, runs, best.ns / iterations);
+    print_counter("cycles_per_op", best.cycles, iterations);
+    print_counter("instructions_per_op", best.instructions, iterations);
+    printf(", \"checksum\": \"%08x\"}\n", best.checksum);
+    fflush(stdout);
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "Usage: %s [-t seconds] [-r runs] [-n iterations] [case...]\n", argv0);
+    fprintf(stderr, "Cases:");
+    for (uint8_t id = 0; id < BENCH_COUNT; id++) {
+        fprintf(stderr, " %s", bench_name(id));
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char *argv[])
+{
+    double seconds = 1.0;
+    unsigned runs = DEFAULT_RUNS;
+    uint32_t iterations = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:r:n:h")) != -1) {
+        switch (opt) {
+            case 't':
+                seconds = strtod(optarg, NULL);
+                break;
+            case 'r':
+                runs = strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (runs == 0) {
+        runs = 1;
+    }
+
+    perf_init();
+    if (!getenv("MINA_MNEMONIC")) {
+        host_set_mnemonic(TEST_MNEMONIC, NULL);
+    }
+
+    if (optind == argc) {
+        for (uint8_t id = 0; id < BENCH_COUNT; id++) {
+            bench(id, seconds, runs, iterations);
+        }
+        return 0;
+    }
+
+    for (int i = optind; i < argc; i++) {
+        uint8_t id;
+        for (id = 0; id < BENCH_COUNT; id++) {
+            if (strcmp(argv[i], bench_name(id)) == 0) {
+                break;
+            }
+        }
+        if (id == BENCH_COUNT) {
+            usage(argv[0]);
+            return 2;
+        }
+        bench(id, seconds, runs, iterations);
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+// Crypto operation counts (host)
+//
+//     Runs each src/benchmark.c case once in the operation counting build
+//     (HAVE_OP_COUNTERS) and prints one JSON object per case with the
+//     number of calls of every counted routine.  The counts are exact and
+//     the same in the emulator (mina_apdu op-counts).
+//
+//     Usage: crypto_ops [case...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "op_counters.h"
+#include "os.h"
+
+// generate_keypair derives from this seed unless MINA_MNEMONIC is set
+#define TEST_MNEMONIC "course grief vintage slim tell hospital car maze model style " \
+                      "elegant kitchen state purpose matrix gas grid enable frown road " \
+                      "goddess glove canyon key"
+
+static void count(uint8_t id)
+{
+    op_counters_reset();
+    bench_run(id, 1);
+
+    printf("{\"platform\": \"host\", \"name\": \"%s\", \"ops\": {", bench_name(id));
+    const char *sep = "";
+    for (uint8_t op = 0; op < OP_COUNTER_COUNT; op++) {
+        if (G_op_counts[op]) {
+            printf("%s\"%s\": %u", sep, op_counter_name(op), G_op_counts[op]);
+            sep = ", ";
+        }
+    }
+    printf("}}\n");
+}
+
+int main(int argc, char *argv[])
+{
+    if (!getenv("MINA_MNEMONIC")) {
+        host_set_mnemonic(TEST_MNEMONIC, NULL);
+    }
+
+    if (argc == 1) {
+        for (uint8_t id = 0; id < BENCH_COUNT; id++) {
+            count(id);
+        }
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        uint8_t id;
+        for (id = 0; id < BENCH_COUNT; id++) {
+            if (strcmp(argv[i], bench_name(id)) == 0) {
+                break;
+            }
+        }
+        if (id == BENCH_COUNT) {
+            fprintf(stderr, "Unknown case %s\n", argv[i]);
+            return 2;
+        }
+        count(id);
+    }
+
+    return 0;
+}
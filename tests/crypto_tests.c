@@ -0,0 +1,361 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto.h"
+#include "cx_blake2b_multi.h"
+#include "cx_sha256_multi.h"
+#include "curve_checks.h"
+#include "parse_tx.h"
+#include "random_oracle_input.h"
+#include "utils.h"
+
+static void hex_to_bytes(uint8_t *out, const size_t len, const char *hex)
+{
+    assert(strlen(hex) == 2*len);
+    for (size_t i = 0; i < len; i++) {
+        sscanf(&hex[2*i], "%2hhx", &out[i]);
+    }
+}
+
+static void bytes_to_hex(char *out, const uint8_t *in, const size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        sprintf(&out[2*i], "%02x", in[i]);
+    }
+}
+
+static void write_be(uint8_t *out, uint64_t value, const size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        out[len - 1 - i] = value >> (8 * i);
+    }
+}
+
+static void check_address(const char *priv_hex, const char *expected)
+{
+    Keypair kp;
+    char address[MINA_ADDRESS_LEN];
+    Compressed pub;
+
+    hex_to_bytes(kp.priv, sizeof(kp.priv), priv_hex);
+    generate_pubkey(&kp.pub, kp.priv);
+    assert(affine_is_on_curve(&kp.pub));
+    assert(generate_address(address, sizeof(address), &kp.pub));
+    assert(strcmp(address, expected) == 0);
+
+    // Round trip
+    assert(validate_address(address));
+    assert(decode_address(&pub, address));
+    assert(memcmp(pub.x, kp.pub.x, sizeof(pub.x)) == 0);
+    assert(pub.is_odd == field_is_odd(kp.pub.y));
+
+    // Complete formulas agree
+    Affine complete;
+    generate_pubkey_complete(&complete, kp.priv);
+    assert(memcmp(&complete, &kp.pub, sizeof(complete)) == 0);
+
+    // Corrupted checksum
+    address[MINA_ADDRESS_LEN - 2] = address[MINA_ADDRESS_LEN - 2] == 'a' ? 'b' : 'a';
+    assert(!validate_address(address));
+}
+
+static void check_projective(const Affine *a)
+{
+    const Affine affine_zero = { };
+    Projective p, q, r, zero;
+    Affine t, u;
+
+    // Identity
+    affine_to_projective(&zero, &affine_zero);
+    affine_to_projective(&p, a);
+    projective_add(&r, &p, &zero);
+    affine_from_projective(&t, &r);
+    assert(memcmp(&t, a, sizeof(t)) == 0);
+    projective_add(&r, &zero, &zero);
+    affine_from_projective(&t, &r);
+    assert(memcmp(&t, &affine_zero, sizeof(t)) == 0);
+
+    // p + p == 2p, including in place
+    projective_add(&r, &p, &p);
+    projective_dbl(&q, &p);
+    affine_from_projective(&t, &r);
+    affine_from_projective(&u, &q);
+    assert(memcmp(&t, &u, sizeof(t)) == 0);
+    affine_add(&u, a, a);
+    assert(memcmp(&t, &u, sizeof(t)) == 0);
+    q = p;
+    projective_add(&q, &q, &q);
+    affine_from_projective(&t, &q);
+    assert(memcmp(&t, &u, sizeof(t)) == 0);
+
+    // p + -p == 0
+    affine_negate(&u, a);
+    affine_to_projective(&q, &u);
+    projective_add(&r, &p, &q);
+    affine_from_projective(&t, &r);
+    assert(memcmp(&t, &affine_zero, sizeof(t)) == 0);
+}
+
+// The co-Z ladder against the complete formulas, edge scalars included
+static void check_scalar_mul(const char *k_hex)
+{
+    Scalar k;
+    Affine q, want;
+
+    hex_to_bytes(k, sizeof(k), k_hex);
+    generate_pubkey(&q, k);
+    generate_pubkey_complete(&want, k);
+    assert(memcmp(&q, &want, sizeof(q)) == 0);
+
+    // Incrementally
+    PubkeyCtx ctx;
+    size_t steps = 1;
+    pubkey_init(&ctx, k);
+    while (!pubkey_step(&ctx, &q)) {
+        steps++;
+    }
+    assert(steps == SCALAR_BITS / SIGN_COMMIT_STEP_BITS);
+    assert(memcmp(&q, &want, sizeof(q)) == 0);
+}
+
+// The multi-message BLAKE2b against the single one, count lanes of
+// lengths len, len + 1, ...
+static void check_blake2b_multi(const unsigned int len, const unsigned int count)
+{
+    uint8_t msg[CX_BLAKE2B_LANES][320], digest[CX_BLAKE2B_LANES][32], want[32];
+    unsigned char *out[CX_BLAKE2B_LANES];
+    const unsigned char *in[CX_BLAKE2B_LANES];
+    unsigned int lens[CX_BLAKE2B_LANES];
+
+    for (unsigned int l = 0; l < count; l++) {
+        for (size_t i = 0; i < sizeof(msg[l]); i++) {
+            msg[l][i] = 31*l + 7*i;
+        }
+        out[l] = digest[l];
+        in[l] = msg[l];
+        lens[l] = len + l;
+    }
+    assert(cx_blake2b_multi(out, sizeof(want), in, lens, count) == sizeof(want));
+
+    for (unsigned int l = 0; l < count; l++) {
+        cx_blake2b_t ctx;
+        cx_blake2b_init(&ctx, 256);
+        cx_hash(&ctx.header, CX_LAST, msg[l], lens[l], want, sizeof(want));
+        assert(memcmp(digest[l], want, sizeof(want)) == 0);
+    }
+}
+
+// The multi-message double SHA-256 against two single hashes, count
+// messages of len bytes
+static void check_sha256d_multi(const unsigned int len, const unsigned int count)
+{
+    uint8_t msg[CX_SHA256_LANES][CX_SHA256D_MULTI_MAX_LEN], digest[CX_SHA256_LANES][32];
+    uint8_t hash[32], want[32];
+    unsigned char *out[CX_SHA256_LANES];
+    const unsigned char *in[CX_SHA256_LANES];
+
+    for (unsigned int l = 0; l < count; l++) {
+        for (size_t i = 0; i < sizeof(msg[l]); i++) {
+            msg[l][i] = 17*l + 5*i + len;
+        }
+        out[l] = digest[l];
+        in[l] = msg[l];
+    }
+    assert(cx_sha256d_multi(out, in, len, count) == CX_SHA256_SIZE);
+
+    for (unsigned int l = 0; l < count; l++) {
+        cx_hash_sha256(msg[l], len, hash, sizeof(hash));
+        cx_hash_sha256(hash, sizeof(hash), want, sizeof(want));
+        assert(memcmp(digest[l], want, sizeof(want)) == 0);
+    }
+}
+
+static void check_bip32(const uint32_t *path, const size_t len, const char *expected)
+{
+    uint8_t key[32], chain[32], want[32];
+
+    hex_to_bytes(want, sizeof(want), expected);
+    os_perso_derive_node_bip32(CX_CURVE_256K1, path, len, key, chain);
+    assert(memcmp(key, want, sizeof(key)) == 0);
+}
+
+static void check_sign(const char *priv_hex, uint32_t account, const char *from,
+                       const char *to, uint64_t amount, uint64_t fee, uint32_t nonce,
+                       uint32_t valid_until, const char *memo, uint8_t tag,
+                       uint8_t network_id, const char *expected)
+{
+    uint8_t buffer[172] = { };
+    tx_t tx;
+
+    write_be(buffer, account, 4);
+    memcpy(buffer + 4, from, MINA_ADDRESS_LEN - 1);
+    memcpy(buffer + 59, to, MINA_ADDRESS_LEN - 1);
+    write_be(buffer + 114, amount, 8);
+    write_be(buffer + 122, fee, 8);
+    write_be(buffer + 130, nonce, 4);
+    write_be(buffer + 134, valid_until, 4);
+    memcpy(buffer + 138, memo, strlen(memo));
+    buffer[170] = tag;
+    buffer[171] = network_id;
+    assert(parse_tx(buffer, sizeof(buffer), &tx));
+
+    // The review fields are formatted back from the parsed values
+    char field[TX_FIELD_MAX_LEN];
+    assert(format_tx_field(field, sizeof(field), &tx, TX_FIELD_FROM));
+    assert(strcmp(field, from) == 0);
+    assert(format_tx_field(field, sizeof(field), &tx, TX_FIELD_TO));
+    assert(strcmp(field, to) == 0);
+    assert(format_tx_field(field, sizeof(field), &tx, TX_FIELD_MEMO));
+    assert(strcmp(field, memo) == 0);
+
+    ROInput input = roinput_create(tx.input_fields, tx.input_bits);
+    transaction_to_roinput(&input, &tx.tx);
+
+    Keypair kp;
+    hex_to_bytes(kp.priv, sizeof(kp.priv), priv_hex);
+    generate_pubkey(&kp.pub, kp.priv);
+
+    Signature sig;
+    assert(sign(&sig, &kp, &input, tx.network_id));
+
+    char hex[2*sizeof(sig) + 1];
+    bytes_to_hex(hex, sig.rx, sizeof(sig.rx));
+    bytes_to_hex(hex + 2*sizeof(sig.rx), sig.s, sizeof(sig.s));
+    assert(strcmp(hex, expected) == 0);
+
+    assert(verify(&sig, &kp.pub, &input, tx.network_id));
+    assert(verify_complete(&sig, &kp.pub, &input, tx.network_id));
+    sig.s[31] ^= 1;
+    assert(!verify(&sig, &kp.pub, &input, tx.network_id));
+    assert(!verify_complete(&sig, &kp.pub, &input, tx.network_id));
+}
+
+int main()
+{
+    const char *priv0 = "164244176fddb5d769b7de2027469d027ad428fadcc0c02396e6280142efb718";
+    const char *addr0 = "B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uzV";
+    const char *priv3 = "1dee867358d4000f1dafa5978341fb515f89eeddbe450bd57df091f1e63d4444";
+    const char *addr3 = "B62qoqiAgERjCjXhofXiD7cMLJSKD8hE8ZtMh4jX5MPNgKB4CFxxm1N";
+    const char *priv12586 = "3414fc16e86e6ac272fda03cf8dcb4d7d47af91b4b726494dab43bf773ce1779";
+    const char *addr12586 = "B62qoG5Yk4iVxpyczUrBNpwtx2xunhL48dydN53A2VjoRwF8NUTbVr4";
+
+    assert(curve_checks());
+
+    // SHA-256 with and without the SHA extensions
+    uint8_t sha_digest[32], sha_want[32], sha_long[200];
+    for (size_t i = 0; i < sizeof(sha_long); i++) {
+        sha_long[i] = i;
+    }
+    for (int sha_ni = 1; sha_ni >= 0; sha_ni--) {
+        cx_sha256_set_sha_ni(sha_ni);
+        hex_to_bytes(sha_want, sizeof(sha_want),
+                     "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        cx_hash_sha256((const unsigned char *)"abc", 3, sha_digest, sizeof(sha_digest));
+        assert(memcmp(sha_digest, sha_want, sizeof(sha_want)) == 0);
+        hex_to_bytes(sha_want, sizeof(sha_want),
+                     "5df6e0e2761359d30a8275058e299fcc0381534545f55cf43e41983f5d4c9456");
+        unsigned char *sha_out[] = { sha_digest };
+        const unsigned char *sha_in[] = { sha_long };
+        assert(cx_sha256d_multi(sha_out, sha_in, 0, 1) == CX_SHA256_SIZE);
+        assert(memcmp(sha_digest, sha_want, sizeof(sha_want)) == 0);
+        assert(cx_sha256d_multi(sha_out, sha_in, CX_SHA256D_MULTI_MAX_LEN + 1, 1) == 0);
+        assert(cx_sha256d_multi(sha_out, sha_in, 0, CX_SHA256_LANES + 1) == 0);
+
+        for (unsigned int len = 0; len <= CX_SHA256D_MULTI_MAX_LEN; len++) {
+            for (unsigned int count = 1; count <= CX_SHA256_LANES; count++) {
+                check_sha256d_multi(len, count);
+            }
+        }
+        hex_to_bytes(sha_want, sizeof(sha_want),
+                     "1901da1c9f699b48f6b2636e65cbf73abf99d0441ef67f5c540a42f7051dec6f");
+        cx_hash_sha256(sha_long, sizeof(sha_long), sha_digest, sizeof(sha_digest));
+        assert(memcmp(sha_digest, sha_want, sizeof(sha_want)) == 0);
+    }
+    cx_sha256_set_sha_ni(1);
+
+    // Multi-message BLAKE2b
+    const unsigned int blake2b_lens[] = { 0, 1, 127, 128, 129, 255, 256, 268, 300 };
+    for (size_t i = 0; i < sizeof(blake2b_lens)/sizeof(blake2b_lens[0]); i++) {
+        for (unsigned int count = 1; count <= CX_BLAKE2B_LANES; count++) {
+            check_blake2b_multi(blake2b_lens[i], count);
+        }
+    }
+    uint8_t abc_digest[64], abc_want[64];
+    unsigned char *abc_out[] = { abc_digest };
+    const unsigned char *abc_in[] = { (const unsigned char *)"abc" };
+    const unsigned int abc_len[] = { 3 };
+    hex_to_bytes(abc_want, sizeof(abc_want),
+                 "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+                 "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+    assert(cx_blake2b_multi(abc_out, sizeof(abc_digest), abc_in, abc_len, 1) == sizeof(abc_digest));
+    assert(memcmp(abc_digest, abc_want, sizeof(abc_want)) == 0);
+    assert(cx_blake2b_multi(abc_out, 0, abc_in, abc_len, 1) == 0);
+    assert(cx_blake2b_multi(abc_out, 65, abc_in, abc_len, 1) == 0);
+    assert(cx_blake2b_multi(abc_out, 32, abc_in, abc_len, CX_BLAKE2B_LANES + 1) == 0);
+
+    // BIP32 test vector 1
+    uint8_t seed[16];
+    hex_to_bytes(seed, sizeof(seed), "000102030405060708090a0b0c0d0e0f");
+    host_set_seed(seed, sizeof(seed));
+    const uint32_t path[] = { 0 | BIP32_HARDENED_OFFSET, 1, 2 | BIP32_HARDENED_OFFSET };
+    check_bip32(path, 0, "e8f32e723decf4051aefac8e2c93c9c5b214313817cdb01a1494b917c8436b35");
+    check_bip32(path, 1, "edb2e14f9ee77d26dd93b4ecede8d16ed408ce149b6cd80b0715a2d911a0afea");
+    check_bip32(path, 2, "3c6cb8d0f6a264c91ea8b5030fadaa8e538b020f0a387421a12de9319dc93368");
+    check_bip32(path, 3, "cbce0d719ecf7431d88e6a89fa1483e02e35092af60c042b1df2ff59fa424dca");
+
+    // Keys derived from the test mnemonic (see tests/Makefile)
+    host_set_mnemonic("course grief vintage slim tell hospital car maze model style "
+                      "elegant kitchen state purpose matrix gas grid enable frown road "
+                      "goddess glove canyon key", NULL);
+    Keypair kp;
+    uint8_t priv[32];
+    generate_keypair(&kp, 0);
+    hex_to_bytes(priv, sizeof(priv), priv0);
+    assert(memcmp(kp.priv, priv, sizeof(priv)) == 0);
+    generate_keypair(&kp, 3);
+    hex_to_bytes(priv, sizeof(priv), priv3);
+    assert(memcmp(kp.priv, priv, sizeof(priv)) == 0);
+    generate_keypair(&kp, 12586);
+    hex_to_bytes(priv, sizeof(priv), priv12586);
+    assert(memcmp(kp.priv, priv, sizeof(priv)) == 0);
+
+    check_address(priv0, addr0);
+    check_address(priv3, addr3);
+    check_address(priv12586, addr12586);
+    check_projective(&kp.pub);
+
+    check_scalar_mul("0000000000000000000000000000000000000000000000000000000000000000");
+    check_scalar_mul("0000000000000000000000000000000000000000000000000000000000000001");
+    check_scalar_mul("0000000000000000000000000000000000000000000000000000000000000002");
+    check_scalar_mul("0000000000000000000000000000000000000000000000000000000000000003");
+    check_scalar_mul("40000000000000000000000000000000224698fc0994a8dd8c46eb2100000001"); // n
+    check_scalar_mul("40000000000000000000000000000000224698fc0994a8dd8c46eb2100000000"); // n - 1
+    check_scalar_mul("40000000000000000000000000000000224698fc0994a8dd8c46eb20ffffffff"); // n - 2
+    check_scalar_mul("3fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    check_scalar_mul("7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    check_scalar_mul("8000000000000000000000000000000000000000000000000000000000000005");
+
+    assert(!validate_address(""));
+    assert(!validate_address("B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uz"));
+    assert(!validate_address("B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uzVV"));
+    assert(!validate_address("B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uz0"));
+
+    // Payment
+    check_sign(priv0, 0, addr0, "B62qicipYxyEHu7QjUqS7QvBipTs5CzgkYZZZkPoKVYBu6tnDUcE9Zt",
+               1729000000000, 2000000000, 16, 271828, "Hello Mina!", PAYMENT_TX, TESTNET_ID,
+               "11a36a8dfe5b857b95a2a7b7b17c62c3ea33411ae6f4eb3a907064aecae353c6"
+               "0794f1d0288322fe3f8bb69d6fabd4fd7c15f8d09f8783b2f087a80407e299af");
+    check_sign(priv12586, 12586, addr12586, "B62qrKG4Z8hnzZqp1AL8WsQhQYah3quN1qUj3SyfJA8Lw135qWWg1mi",
+               314159265359, 1618033988, 0, 4294967295, "", PAYMENT_TX, TESTNET_ID,
+               "23a9e2375dd3d0cd061e05c33361e0ba270bf689c4945262abdcc81d7083d8c3"
+               "11ae46b8bebfc98c584e2fb54566851919b58cf0917a256d2c1113daa1ccb27f");
+
+    // Delegation
+    check_sign(priv0, 0, addr0, "B62qicipYxyEHu7QjUqS7QvBipTs5CzgkYZZZkPoKVYBu6tnDUcE9Zt",
+               0, 2000000000, 16, 1337, "Delewho?", DELEGATION_TX, TESTNET_ID,
+               "30797d7d0426e54ff195d1f94dc412300f900cc9e84990603939a77b3a4d2fc1"
+               "1ebab12857b47c481c182abe147279732549f0fd49e68d5541f825e9d1e6fa04");
+
+    return 0;
+}
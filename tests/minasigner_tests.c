@@ -0,0 +1,163 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "minasigner.h"
+
+static void hex_to_bytes(uint8_t *out, const size_t len, const char *hex)
+{
+    assert(strlen(hex) == 2*len);
+    for (size_t i = 0; i < len; i++) {
+        sscanf(&hex[2*i], "%2hhx", &out[i]);
+    }
+}
+
+int main()
+{
+    minasigner_keypair_t kp;
+    minasigner_signature_t sig, expected;
+    char address[MINASIGNER_ADDRESS_LEN];
+    uint8_t secret[MINASIGNER_SCALAR_BYTES];
+
+    assert(minasigner_api_version() == MINASIGNER_API_VERSION);
+
+    // Keys and addresses
+    hex_to_bytes(secret, sizeof(secret), "164244176fddb5d769b7de2027469d027ad428fadcc0c02396e6280142efb718");
+    assert(minasigner_keypair_from_secret(&kp, secret) == MINASIGNER_OK);
+    assert(minasigner_address(address, &kp.pub) == MINASIGNER_OK);
+    assert(strcmp(address, "B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uzV") == 0);
+    assert(minasigner_address_validate(address) == MINASIGNER_OK);
+    assert(minasigner_address_validate("B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uzW") == MINASIGNER_ERR_ADDRESS);
+
+    uint8_t bad_secret[MINASIGNER_SCALAR_BYTES] = { };
+    assert(minasigner_keypair_from_secret(&kp, bad_secret) == MINASIGNER_ERR_KEY);
+    memset(bad_secret, 0xff, sizeof(bad_secret));
+    assert(minasigner_keypair_from_secret(&kp, bad_secret) == MINASIGNER_ERR_KEY);
+    assert(minasigner_keypair_from_secret(&kp, secret) == MINASIGNER_OK);
+
+    minasigner_keypair_t derived;
+    assert(minasigner_set_mnemonic("course grief vintage slim tell hospital car maze model style "
+                                   "elegant kitchen state purpose matrix gas grid enable frown road "
+                                   "goddess glove canyon key", NULL) == MINASIGNER_OK);
+    assert(minasigner_keypair_from_account(&derived, 0) == MINASIGNER_OK);
+    assert(memcmp(&derived, &kp, sizeof(kp)) == 0);
+    assert(minasigner_keypair_from_account(&derived, 3) == MINASIGNER_OK);
+    assert(minasigner_address(address, &derived.pub) == MINASIGNER_OK);
+    assert(strcmp(address, "B62qoqiAgERjCjXhofXiD7cMLJSKD8hE8ZtMh4jX5MPNgKB4CFxxm1N") == 0);
+
+    minasigner_public_key_t off_curve = kp.pub;
+    off_curve.y[31] ^= 1;
+    assert(minasigner_address(address, &off_curve) == MINASIGNER_ERR_KEY);
+
+    // Payment
+    minasigner_transaction_t tx = {
+        .tag = MINASIGNER_PAYMENT,
+        .from = "B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uzV",
+        .to = "B62qicipYxyEHu7QjUqS7QvBipTs5CzgkYZZZkPoKVYBu6tnDUcE9Zt",
+        .amount = 1729000000000,
+        .fee = 2000000000,
+        .nonce = 16,
+        .valid_until = 271828,
+        .memo = "Hello Mina!"
+    };
+    hex_to_bytes((uint8_t *)&expected, sizeof(expected),
+                 "11a36a8dfe5b857b95a2a7b7b17c62c3ea33411ae6f4eb3a907064aecae353c6"
+                 "0794f1d0288322fe3f8bb69d6fabd4fd7c15f8d09f8783b2f087a80407e299af");
+    assert(minasigner_sign_transaction(&sig, &kp, &tx, MINASIGNER_TESTNET) == MINASIGNER_OK);
+    assert(memcmp(&sig, &expected, sizeof(sig)) == 0);
+    assert(minasigner_verify_transaction(&sig, &kp.pub, &tx, MINASIGNER_TESTNET) == MINASIGNER_OK);
+    assert(minasigner_verify_transaction(&sig, &kp.pub, &tx, MINASIGNER_MAINNET) == MINASIGNER_ERR_SIGNATURE);
+
+    tx.amount++;
+    assert(minasigner_verify_transaction(&sig, &kp.pub, &tx, MINASIGNER_TESTNET) == MINASIGNER_ERR_SIGNATURE);
+    tx.amount--;
+
+    sig.s[31] ^= 1;
+    assert(minasigner_verify_transaction(&sig, &kp.pub, &tx, MINASIGNER_TESTNET) == MINASIGNER_ERR_SIGNATURE);
+
+    // Delegation
+    tx.tag = MINASIGNER_DELEGATION;
+    tx.amount = 0;
+    tx.valid_until = 1337;
+    strcpy(tx.memo, "Delewho?");
+    hex_to_bytes((uint8_t *)&expected, sizeof(expected),
+                 "30797d7d0426e54ff195d1f94dc412300f900cc9e84990603939a77b3a4d2fc1"
+                 "1ebab12857b47c481c182abe147279732549f0fd49e68d5541f825e9d1e6fa04");
+    assert(minasigner_sign_transaction(&sig, &kp, &tx, MINASIGNER_TESTNET) == MINASIGNER_OK);
+    assert(memcmp(&sig, &expected, sizeof(sig)) == 0);
+    assert(minasigner_verify_transaction(&sig, &kp.pub, &tx, MINASIGNER_TESTNET) == MINASIGNER_OK);
+
+    // Keys that do not sign for the source
+    minasigner_keypair_t bad_kp = kp;
+    memset(bad_kp.secret, 0, sizeof(bad_kp.secret));
+    assert(minasigner_sign_transaction(&sig, &bad_kp, &tx, MINASIGNER_TESTNET) == MINASIGNER_ERR_KEY);
+    bad_kp = kp;
+    bad_kp.pub = derived.pub;
+    assert(minasigner_sign_transaction(&sig, &bad_kp, &tx, MINASIGNER_TESTNET) == MINASIGNER_ERR_KEY);
+    assert(minasigner_sign_transaction(&sig, &derived, &tx, MINASIGNER_TESTNET) == MINASIGNER_ERR_KEY);
+
+    // Batch, mixed with single signing
+    minasigner_transaction_t batch[11];
+    const minasigner_keypair_t *batch_kps[11];
+    uint8_t batch_networks[11];
+    minasigner_signature_t batch_sigs[11];
+    minasigner_status_t batch_status[11];
+    for (size_t i = 0; i < 11; i++) {
+        batch[i] = tx;
+        batch[i].tag = i % 3 ? MINASIGNER_PAYMENT : MINASIGNER_DELEGATION;
+        batch[i].amount = batch[i].tag == MINASIGNER_PAYMENT ? 1000000000 * i : 0;
+        batch[i].nonce = i;
+        snprintf(batch[i].memo, sizeof(batch[i].memo), "batch %zu", i);
+        batch_kps[i] = i % 2 ? &derived : &kp;
+        if (i % 2) {
+            strcpy(batch[i].from, "B62qoqiAgERjCjXhofXiD7cMLJSKD8hE8ZtMh4jX5MPNgKB4CFxxm1N");
+        }
+        batch_networks[i] = i % 4 ? MINASIGNER_TESTNET : MINASIGNER_MAINNET;
+    }
+    batch[9].tag = 0x01;
+    strcpy(batch[10].from, batch[1].from);
+    assert(minasigner_sign_transactions(batch_sigs, batch_status, batch_kps, batch,
+                                        batch_networks, 11) == MINASIGNER_ERR_ARGUMENT);
+    for (size_t i = 0; i < 11; i++) {
+        minasigner_status_t status = minasigner_sign_transaction(&sig, batch_kps[i], &batch[i],
+                                                                 batch_networks[i]);
+        assert(batch_status[i] == status);
+        if (status == MINASIGNER_OK) {
+            assert(memcmp(&batch_sigs[i], &sig, sizeof(sig)) == 0);
+            assert(minasigner_verify_transaction(&sig, &batch_kps[i]->pub, &batch[i],
+                                                 batch_networks[i]) == MINASIGNER_OK);
+        }
+    }
+    assert(batch_status[9] == MINASIGNER_ERR_ARGUMENT);
+    assert(batch_status[10] == MINASIGNER_ERR_KEY);
+    assert(minasigner_sign_transactions(batch_sigs, batch_status, batch_kps, batch,
+                                        batch_networks, 9) == MINASIGNER_OK);
+    assert(minasigner_sign_transactions(NULL, NULL, NULL, NULL, NULL, 0) == MINASIGNER_OK);
+
+    // Malformed transactions
+    tx.tag = 0x01;
+    assert(minasigner_sign_transaction(&sig, &kp, &tx, MINASIGNER_TESTNET) == MINASIGNER_ERR_ARGUMENT);
+    tx.tag = MINASIGNER_DELEGATION;
+    tx.to[10] = '0';
+    assert(minasigner_sign_transaction(&sig, &kp, &tx, MINASIGNER_TESTNET) == MINASIGNER_ERR_ADDRESS);
+    assert(minasigner_sign_transaction(&sig, &kp, &tx, 2) == MINASIGNER_ERR_ADDRESS);
+
+    // Poseidon
+    uint8_t in[2][MINASIGNER_FIELD_BYTES] = { };
+    uint8_t h1[MINASIGNER_FIELD_BYTES], h2[MINASIGNER_FIELD_BYTES];
+    in[1][31] = 1;
+    assert(minasigner_poseidon(h1, in, 2, MINASIGNER_TESTNET) == MINASIGNER_OK);
+    assert(minasigner_poseidon(h2, in, 2, MINASIGNER_TESTNET) == MINASIGNER_OK);
+    assert(memcmp(h1, h2, sizeof(h1)) == 0);
+    assert(minasigner_poseidon(h2, in, 2, MINASIGNER_MAINNET) == MINASIGNER_OK);
+    assert(memcmp(h1, h2, sizeof(h1)) != 0);
+    assert(minasigner_poseidon(h2, in, 1, MINASIGNER_TESTNET) == MINASIGNER_OK);
+    assert(memcmp(h1, h2, sizeof(h1)) != 0);
+    memset(in[0], 0xff, sizeof(in[0]));
+    assert(minasigner_poseidon(h1, in, 2, MINASIGNER_TESTNET) == MINASIGNER_ERR_ARGUMENT);
+    assert(minasigner_poseidon(h1, in, 2, 7) == MINASIGNER_ERR_ARGUMENT);
+
+    printf("minasigner tests completed successfully!\n");
+
+    return 0;
+}
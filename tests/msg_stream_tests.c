@@ -0,0 +1,122 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto.h"
+#include "msg_stream.h"
+#include "random_oracle_input.h"
+
+#define ACCOUNT 3
+
+// Streams both passes of msg in chunks of chunk bytes and signs
+static bool stream_sign(Signature *sig, const Keypair *kp, const uint8_t *msg,
+                        const size_t len, const size_t chunk, const uint8_t network_id)
+{
+    msg_stream_t s;
+
+    msg_stream_init(&s, ACCOUNT, network_id, len, &kp->pub);
+    for (size_t i = 0; i == 0 || i < len; i += chunk) {
+        size_t n = len - i < chunk ? len - i : chunk;
+        assert(msg_stream_derive(&s, msg + i, n));
+    }
+    assert(s.state == MSG_STREAM_COMMITTED);
+
+    // No signature before the hash pass is complete
+    Signature early;
+    msg_stream_t copy = s;
+    assert(!msg_stream_sign(&copy, &early));
+
+    assert(msg_stream_hash_init(&s));
+    for (size_t i = 0; i == 0 || i < len; i += chunk) {
+        size_t n = len - i < chunk ? len - i : chunk;
+        if (!msg_stream_hash(&s, msg + i, n)) {
+            return false;
+        }
+    }
+    assert(s.state == MSG_STREAM_DONE);
+
+    return msg_stream_sign(&s, sig);
+}
+
+// The streamed signature against sign() over the same ROInput
+static void check_sign(const Keypair *kp, const uint8_t *msg, const size_t len,
+                       const uint8_t network_id)
+{
+    const size_t chunks[] = { 1, 7, 32, 33, 255 };
+    Field   fields[1];
+    uint8_t bits[160];
+    ROInput input = roinput_create(fields, bits);
+    Signature sig, want;
+
+    assert(len <= sizeof(bits));
+    roinput_add_bytes(&input, msg, len);
+    assert(sign(&want, kp, &input, network_id));
+    assert(verify(&want, &kp->pub, &input, network_id));
+
+    for (size_t i = 0; i < ARRAY_LEN(chunks); i++) {
+        assert(stream_sign(&sig, kp, msg, len, chunks[i], network_id));
+        assert(memcmp(&sig, &want, sizeof(sig)) == 0);
+    }
+}
+
+int main()
+{
+    Keypair kp;
+    uint8_t msg[5000];
+    Signature sig, want;
+    msg_stream_t s;
+
+    host_set_mnemonic("course grief vintage slim tell hospital car maze model style "
+                      "elegant kitchen state purpose matrix gas grid enable frown road "
+                      "goddess glove canyon key", NULL);
+    generate_keypair(&kp, ACCOUNT);
+
+    for (size_t i = 0; i < sizeof(msg); i++) {
+        msg[i] = 13*i + 5;
+    }
+    memcpy(msg, "Hello Mina!", 11);
+
+    // Short messages, which sign() can also sign
+    const size_t lens[] = { 0, 1, 11, 31, 32, 33, 64, 127, 160 };
+    for (size_t i = 0; i < ARRAY_LEN(lens); i++) {
+        check_sign(&kp, msg, lens[i], TESTNET_ID);
+        check_sign(&kp, msg, lens[i], MAINNET_ID);
+    }
+
+    // Long messages do not depend on the chunking
+    assert(stream_sign(&want, &kp, msg, sizeof(msg), 255, MAINNET_ID));
+    assert(stream_sign(&sig, &kp, msg, sizeof(msg), 100, MAINNET_ID));
+    assert(memcmp(&sig, &want, sizeof(sig)) == 0);
+
+    // A different message in the hash pass
+    msg_stream_init(&s, ACCOUNT, TESTNET_ID, 64, &kp.pub);
+    assert(msg_stream_derive(&s, msg, 64));
+    assert(msg_stream_hash_init(&s));
+    msg[10] ^= 1;
+    assert(!msg_stream_hash(&s, msg, 64));
+    msg[10] ^= 1;
+
+    // More than the announced length
+    msg_stream_init(&s, ACCOUNT, TESTNET_ID, 64, &kp.pub);
+    assert(!msg_stream_derive(&s, msg, 65));
+    assert(msg_stream_derive(&s, msg, 32));
+    assert(!msg_stream_hash_init(&s));
+    assert(!msg_stream_derive(&s, msg, 33));
+    assert(msg_stream_derive(&s, msg, 32));
+    assert(!msg_stream_derive(&s, msg, 1));
+    assert(msg_stream_hash_init(&s));
+    assert(!msg_stream_hash(&s, msg, 65));
+
+    // The stream is cleared once signed
+    msg_stream_init(&s, ACCOUNT, TESTNET_ID, 0, &kp.pub);
+    assert(msg_stream_derive(&s, msg, 0));
+    assert(msg_stream_hash_init(&s));
+    assert(msg_stream_hash(&s, msg, 0));
+    assert(msg_stream_sign(&s, &sig));
+    assert(s.state == MSG_STREAM_IDLE);
+    assert(!msg_stream_sign(&s, &sig));
+
+    printf("Message stream tests completed successfully!\n");
+
+    return 0;
+}
@@ -311,5 +311,96 @@ int main()
         assert(memcmp(this_hash_msg, target_hash_msg, sizeof(target_hash_msg)) == 0);
     }
 
+    {
+        // Streaming packers must match roinput_to_bytes() and roinput_to_fields()
+        const char *msg = "Streaming packers produce the same random oracle input "
+                          "as roinput_to_bytes() and roinput_to_fields() do";
+        const size_t msg_len = strlen(msg);
+        const uint8_t network_id = 0x01;
+
+        Keypair kp;
+        Field rx;
+        for (size_t i = 0; i < FIELD_BYTES; i++) {
+            kp.pub.x[i] = 7 * i + 1;
+            kp.pub.y[i] = 13 * i + 5;
+            kp.priv[i] = 19 * i + 11;
+            rx[i] = 17 * i + 3;
+        }
+        kp.pub.x[0] &= 0x3f;
+        kp.pub.y[0] &= 0x3f;
+        kp.priv[0] &= 0x3f;
+        rx[0] &= 0x3f;
+
+        Field   msg_fields[1];
+        uint8_t msg_bits[128];
+        ROInput msg_input = roinput_create(msg_fields, msg_bits);
+        roinput_add_bytes(&msg_input, (const uint8_t *)msg, msg_len);
+
+        // Derive message layout: pub.x, pub.y | msg, priv, network_id
+        uint8_t target_bytes[256];
+        int target_len = roinput_derive_message(target_bytes, sizeof(target_bytes), &kp, &msg_input, network_id);
+        assert(target_len > 0);
+
+        uint8_t le[FIELD_BYTES];
+        uint8_t stream_bytes[256];
+        size_t stream_len = 0;
+        ROInputPacker packer;
+        roinput_packer_init(&packer);
+        for (size_t i = 0; i < FIELD_BYTES; i++) {
+            le[i] = kp.pub.x[FIELD_BYTES - i - 1];
+        }
+        stream_len += roinput_pack_bits(&packer, stream_bytes + stream_len, le, FIELD_BITS);
+        for (size_t i = 0; i < FIELD_BYTES; i++) {
+            le[i] = kp.pub.y[FIELD_BYTES - i - 1];
+        }
+        stream_len += roinput_pack_bits(&packer, stream_bytes + stream_len, le, FIELD_BITS);
+        for (size_t i = 0; i < msg_len; i += 5) {
+            size_t chunk = msg_len - i < 5 ? msg_len - i : 5;
+            stream_len += roinput_pack_bits(&packer, stream_bytes + stream_len,
+                                            (const uint8_t *)msg + i, 8 * chunk);
+        }
+        for (size_t i = 0; i < SCALAR_BYTES; i++) {
+            le[i] = kp.priv[SCALAR_BYTES - i - 1];
+        }
+        stream_len += roinput_pack_bits(&packer, stream_bytes + stream_len, le, FIELD_BITS);
+        stream_len += roinput_pack_bits(&packer, stream_bytes + stream_len, &network_id, 8);
+        stream_len += roinput_pack_flush(&packer, stream_bytes + stream_len);
+
+        assert(stream_len == (size_t)target_len);
+        assert(memcmp(stream_bytes, target_bytes, target_len) == 0);
+
+        // Hash message layout: pub.x, pub.y, rx | msg
+        Field target_fields[8];
+        int target_fields_len = roinput_hash_message(target_fields, ARRAY_LEN(target_fields), &kp.pub, rx, &msg_input);
+        assert(target_fields_len == 7);
+
+        Field stream_fields[8];
+        size_t stream_fields_len = 0;
+        memcpy(stream_fields[stream_fields_len++], kp.pub.x, FIELD_BYTES);
+        memcpy(stream_fields[stream_fields_len++], kp.pub.y, FIELD_BYTES);
+        memcpy(stream_fields[stream_fields_len++], rx, FIELD_BYTES);
+
+        ROInputFieldPacker field_packer;
+        roinput_field_packer_init(&field_packer);
+        for (size_t i = 0; i < msg_len; i += 7) {
+            size_t chunk = msg_len - i < 7 ? msg_len - i : 7;
+            size_t offset = 0;
+            while (offset < 8 * chunk) {
+                bool ready;
+                offset += roinput_field_pack_bits(&field_packer, stream_fields[stream_fields_len], &ready,
+                                                  (const uint8_t *)msg + i, offset, 8 * chunk - offset);
+                if (ready) {
+                    stream_fields_len++;
+                }
+            }
+        }
+        if (roinput_field_pack_flush(&field_packer, stream_fields[stream_fields_len])) {
+            stream_fields_len++;
+        }
+
+        assert(stream_fields_len == (size_t)target_fields_len);
+        assert(memcmp(stream_fields, target_fields, FIELD_BYTES * stream_fields_len) == 0);
+    }
+
     printf("Random oracle input tests completed successfully!\n");
 }
@@ -0,0 +1,85 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "signd_pool.h"
+
+#define COUNT 10000
+
+typedef struct {
+    atomic_int hits[COUNT];
+    size_t     out[COUNT];
+} ctx_t;
+
+static void square(void *arg, size_t begin, size_t end)
+{
+    ctx_t *ctx = arg;
+    for (size_t i = begin; i < end; i++) {
+        atomic_fetch_add(&ctx->hits[i], 1);
+        ctx->out[i] = i*i;
+    }
+}
+
+typedef struct {
+    signd_pool_t *pool;
+    ctx_t        *ctx;
+    size_t        grain;
+} submitter_t;
+
+static void *submit(void *arg)
+{
+    submitter_t *s = arg;
+    signd_pool_run(s->pool, square, s->ctx, COUNT, s->grain);
+    return NULL;
+}
+
+static void check(ctx_t *ctx, int expected_hits)
+{
+    for (size_t i = 0; i < COUNT; i++) {
+        assert(atomic_load(&ctx->hits[i]) == expected_hits);
+        assert(ctx->out[i] == i*i);
+    }
+}
+
+int main()
+{
+    signd_pool_t *pool = signd_pool_create(4);
+    assert(pool);
+    assert(signd_pool_threads(pool) == 4);
+
+    // Every index runs exactly once, for any grain, including more
+    // ranges than the deques hold
+    size_t grains[] = { 1, 3, 8, 1000, COUNT, 2*COUNT };
+    for (size_t g = 0; g < sizeof(grains)/sizeof(grains[0]); g++) {
+        ctx_t *ctx = calloc(1, sizeof(*ctx));
+        signd_pool_run(pool, square, ctx, COUNT, grains[g]);
+        check(ctx, 1);
+        free(ctx);
+    }
+
+    // Empty job
+    signd_pool_run(pool, square, NULL, 0, 1);
+
+    // Concurrent submitters
+    ctx_t *ctxs[4];
+    pthread_t tids[4];
+    submitter_t subs[4];
+    for (size_t i = 0; i < 4; i++) {
+        ctxs[i] = calloc(1, sizeof(*ctxs[i]));
+        subs[i] = (submitter_t){ pool, ctxs[i], 1 + i*7 };
+        assert(pthread_create(&tids[i], NULL, submit, &subs[i]) == 0);
+    }
+    for (size_t i = 0; i < 4; i++) {
+        pthread_join(tids[i], NULL);
+        check(ctxs[i], 1);
+        free(ctxs[i]);
+    }
+
+    signd_pool_destroy(pool);
+
+    printf("Signing pool tests completed successfully!\n");
+
+    return 0;
+}
@@ -3,6 +3,22 @@
 #include <stdio.h>
 
 #include "utils.h"
+#include "b58_reference.h"
+
+static void check_b58_encode(const char *hex, const char *expected)
+{
+    unsigned char in[64];
+    unsigned char out[128];
+    size_t len = strlen(hex) / 2;
+
+    for (size_t i = 0; i < len; i++) {
+        sscanf(&hex[2*i], "%2hhx", &in[i]);
+    }
+
+    int out_len = b58_encode(in, len, out, sizeof(out));
+    assert(out_len == (int)strlen(expected));
+    assert(memcmp(out, expected, out_len) == 0);
+}
 
 int main()
 {
@@ -44,6 +60,110 @@ int main()
    assert(strcmp(amount_to_string(buf, sizeof(buf), 314159265359), "314.159265359") == 0);
    assert(strcmp(amount_to_string(buf, sizeof(buf), 1618033988750000), "1618033.98875") == 0);
 
+   // Base58 encoding
+   check_b58_encode("", "");
+   check_b58_encode("61", "2g");
+   check_b58_encode("626262", "a3gV");
+   check_b58_encode("636363", "aPEr");
+   check_b58_encode("73696d706c792061206c6f6e6720737472696e67", "2cFupjhnEsSn59qHXstmK2ffpLv2");
+   check_b58_encode("00eb15231dfceb60925886b67d065299925915aeb172c06647", "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L");
+   check_b58_encode("516b6fcd0f", "ABnLTmg");
+   check_b58_encode("bf4f89001e670274dd", "3SEo3LWLoPntC");
+   check_b58_encode("572e4794", "3EFU7m");
+   check_b58_encode("ecac89cad93923c02321", "EJDM8drfXA6uyA");
+   check_b58_encode("10c8511e", "Rt5zm");
+   check_b58_encode("00000000000000000000", "1111111111");
+   check_b58_encode("000000ff", "1115Q");
+
+   // Output buffer too small
+   unsigned char b58[128];
+   assert(b58_encode((const unsigned char *)"bbb", 3, b58, 3) == -1);
+   assert(b58_encode((const unsigned char *)"bbb", 3, b58, 4) == 4);
+
+   // Must agree with the textbook encoder for every length and for runs of
+   // leading zero and 0xff bytes
+   srand(1);
+   for (size_t len = 0; len <= 64; len++) {
+       for (size_t round = 0; round < 64; round++) {
+           unsigned char in[64];
+           unsigned char expected[128];
+           for (size_t i = 0; i < len; i++) {
+               in[i] = rand();
+           }
+           if (round % 4 == 1) {
+               memset(in, 0, len / 3);
+           }
+           if (round % 4 == 2) {
+               memset(in, 0xff, len);
+           }
+           if (round % 4 == 3) {
+               memset(in, 0, len);
+           }
+
+           int expected_len = b58_encode_reference(in, len, expected, sizeof(expected));
+           int b58_len = b58_encode(in, len, b58, sizeof(b58));
+           assert(b58_len == expected_len);
+           assert(memcmp(b58, expected, b58_len) == 0);
+       }
+   }
+
+   // Base58 decoding of 55-character addresses (fast path) must agree with
+   // the generic decoder (used for a 41-byte output buffer)
+   for (size_t round = 0; round < 256; round++) {
+       unsigned char in[40];
+       for (size_t i = 0; i < sizeof(in); i++) {
+           in[i] = rand();
+       }
+       in[0] = 0xcb;
+       in[1] = 0x01;
+       in[2] = 0x01;
+
+       char address[56] = { };
+       assert(b58_encode(in, sizeof(in), (unsigned char *)address, 55) == 55);
+
+       uint8_t bytes[40];
+       size_t bytes_len = sizeof(bytes);
+       assert(b58_decode(bytes, &bytes_len, address, 55));
+       assert(bytes_len == sizeof(bytes));
+       assert(memcmp(bytes, in, sizeof(in)) == 0);
+
+       uint8_t generic[41];
+       size_t generic_len = sizeof(generic);
+       assert(b58_decode(generic, &generic_len, address, 55));
+       assert(generic_len == sizeof(bytes));
+       assert(memcmp(generic + 1, bytes, sizeof(bytes)) == 0);
+
+       // Invalid digits are rejected at any position
+       char invalid[] = { '0', 'O', 'I', 'l', '+', (char)0x80, (char)0xcf };
+       size_t pos = round % 55;
+       char c = address[pos];
+       address[pos] = invalid[round % sizeof(invalid)];
+       bytes_len = sizeof(bytes);
+       assert(!b58_decode(bytes, &bytes_len, address, 55));
+       address[pos] = c;
+   }
+
+   {
+       // Too big for 40 bytes
+       const char *big = "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz";
+       uint8_t bytes[40];
+       size_t bytes_len = sizeof(bytes);
+       assert(!b58_decode(bytes, &bytes_len, big, 55));
+
+       // Leading '1' (zero byte) takes the generic path
+       const char *ones = "1111111111111111111111111111111111111111111111111111112";
+       bytes_len = sizeof(bytes);
+       assert(b58_decode(bytes, &bytes_len, ones, 55));
+       assert(bytes[39] == 1);
+
+       // Mina address
+       const char *address = "B62qnzbXmRNo9q32n4SNu2mpB8e7FYYLH8NmaX6oFCBYjjQ8SbD7uzV";
+       bytes_len = sizeof(bytes);
+       assert(b58_decode(bytes, &bytes_len, address, 0));
+       assert(bytes_len == sizeof(bytes));
+       assert(bytes[0] == 0xcb && bytes[1] == 0x01 && bytes[2] == 0x01);
+   }
+
    printf("Utils tests completed successfully!\n");
 
    return 0;
@@ -0,0 +1,288 @@
+#!/usr/bin/env python3
+
+# APDU session record and replay
+#
+#     record   Proxies the Speculos APDU port and logs every exchange
+#     replay   Sends a recorded session to the app, checks the responses
+#              and reports per-INS latency (optionally against a baseline)
+#     report   Prints per-INS latency percentiles of a session log
+#
+#     Session logs are JSON lines, one exchange per line:
+#
+#         {"t": 0.1234, "apdu": "e002000004...", "response": "...9000", "us": 5123.4}
+#
+#     t is the offset from the start of the session in seconds, response is
+#     the response data followed by the status word and us is the time from
+#     sending the command to receiving the complete response.
+#
+#     Both record and replay speak the Speculos APDU TCP framing, so they
+#     work with any server that implements it.  Run the emulator with
+#     AUTOMATION=1 (emulator_automation.json) so that prompts are approved.
+
+import argparse
+import json
+import os
+import socket
+import struct
+import sys
+import time
+
+__version__ = "1.0.0"
+
+DEFAULT_ADDRESS = "127.0.0.1"
+DEFAULT_PORT    = 9999
+
+INS_NAMES = {
+    0x01: "get-conf",
+    0x02: "get-addr",
+    0x03: "sign-tx",
+    0x04: "test-crypto",
+    0x05: "sign-msg",
+}
+
+# Exit codes
+EXIT_MISMATCH   = 3
+EXIT_REGRESSION = 4
+
+def recv_exact(sock, n):
+    data = bytearray()
+    while len(data) < n:
+        chunk = sock.recv(n - len(data))
+        if not chunk:
+            raise EOFError("Connection closed")
+        data += chunk
+    return bytes(data)
+
+def recv_command(sock):
+    # Command: length (4, BE) | APDU
+    (length,) = struct.unpack(">I", recv_exact(sock, 4))
+    return recv_exact(sock, length)
+
+def recv_response(sock):
+    # Response: length of data (4, BE) | data | SW (2)
+    (length,) = struct.unpack(">I", recv_exact(sock, 4))
+    return recv_exact(sock, length + 2)
+
+def send_command(sock, apdu):
+    sock.sendall(struct.pack(">I", len(apdu)) + apdu)
+
+def send_response(sock, response):
+    sock.sendall(struct.pack(">I", len(response) - 2) + response)
+
+def connect(address, port):
+    sock = socket.create_connection((address, port))
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    return sock
+
+def ins_name(ins):
+    return "{} ({:02x})".format(INS_NAMES.get(ins, "ins"), ins)
+
+def load_session(path):
+    records = []
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            try:
+                record = json.loads(line)
+                record["apdu"] = bytes.fromhex(record["apdu"])
+                if len(record["apdu"]) < 4:
+                    raise ValueError("APDU too short")
+            except (ValueError, KeyError) as ex:
+                raise ValueError("{}:{}: {}".format(path, lineno, ex))
+            records.append(record)
+    return records
+
+def log_record(f, t, apdu, response, us):
+    f.write(json.dumps({ "t": round(t, 6),
+                         "apdu": apdu.hex(),
+                         "response": response.hex(),
+                         "us": round(us, 1) }) + "\n")
+    f.flush()
+
+def percentile(sorted_values, p):
+    # Same nearest-rank convention as mina_apdu batch
+    return sorted_values[len(sorted_values)*p//100]
+
+def latency_stats(records):
+    by_ins = {}
+    for record in records:
+        by_ins.setdefault(record["apdu"][1], []).append(record["us"])
+
+    stats = {}
+    for ins, values in by_ins.items():
+        values.sort()
+        stats[ins] = { "count": len(values),
+                       "min": values[0],
+                       "avg": sum(values)/len(values),
+                       "p50": percentile(values, 50),
+                       "p90": percentile(values, 90),
+                       "p99": percentile(values, 99),
+                       "max": values[-1] }
+    return stats
+
+def print_stats(stats, out=sys.stdout):
+    out.write("{:<18} {:>6} {:>9} {:>9} {:>9} {:>9} {:>9} {:>9}\n".format(
+              "INS", "count", "min ms", "avg ms", "p50 ms", "p90 ms", "p99 ms", "max ms"))
+    for ins in sorted(stats):
+        s = stats[ins]
+        out.write("{:<18} {:>6} {:>9.2f} {:>9.2f} {:>9.2f} {:>9.2f} {:>9.2f} {:>9.2f}\n".format(
+                  ins_name(ins), s["count"], s["min"]/1e3, s["avg"]/1e3, s["p50"]/1e3,
+                  s["p90"]/1e3, s["p99"]/1e3, s["max"]/1e3))
+
+def record(args):
+    # Serve one client at a time; each client gets its own connection to
+    # the app and all exchanges go to the same log
+    listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    listener.bind((args.listen_address, args.listen_port))
+    listener.listen(1)
+
+    out = open(args.session, "a" if args.append else "w")
+    start = time.monotonic()
+    count = 0
+
+    print("Recording {}:{} -> {}:{} to {}".format(args.listen_address, args.listen_port,
+          args.address, args.port, args.session), file=sys.stderr)
+    try:
+        while True:
+            client, _ = listener.accept()
+            client.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            app = connect(args.address, args.port)
+            try:
+                while True:
+                    apdu = recv_command(client)
+                    t = time.monotonic()
+                    send_command(app, apdu)
+                    response = recv_response(app)
+                    us = (time.monotonic() - t)*1e6
+                    send_response(client, response)
+                    log_record(out, t - start, apdu, response, us)
+                    count += 1
+            except EOFError:
+                pass
+            finally:
+                client.close()
+                app.close()
+            if args.max_clients > 0:
+                args.max_clients -= 1
+                if args.max_clients == 0:
+                    break
+    except KeyboardInterrupt:
+        pass
+    finally:
+        out.close()
+        listener.close()
+
+    print("Recorded {} APDUs".format(count), file=sys.stderr)
+    return 0
+
+def replay(args):
+    records = load_session(args.session)
+    out = open(args.output, "w") if args.output else None
+    sock = connect(args.address, args.port)
+
+    replayed = []
+    mismatches = 0
+    start = time.monotonic()
+    for _ in range(args.repeat):
+        for i, rec in enumerate(records):
+            if args.pace and "t" in rec and i > 0:
+                # Keep the recorded gaps between commands
+                delay = rec["t"] - records[i - 1]["t"] - records[i - 1].get("us", 0)/1e6
+                if delay > 0:
+                    time.sleep(delay)
+            t = time.monotonic()
+            send_command(sock, rec["apdu"])
+            response = recv_response(sock)
+            us = (time.monotonic() - t)*1e6
+
+            expected = rec.get("response")
+            if expected is not None and response.hex() != expected and not args.no_check:
+                mismatches += 1
+                if args.verbose:
+                    print("mismatch {}: {}\n  expected {}\n  got      {}".format(
+                          ins_name(rec["apdu"][1]), rec["apdu"].hex(), expected,
+                          response.hex()), file=sys.stderr)
+            if out:
+                log_record(out, t - start, rec["apdu"], response, us)
+            replayed.append({ "apdu": rec["apdu"], "us": us })
+    elapsed = time.monotonic() - start
+    sock.close()
+    if out:
+        out.close()
+
+    stats = latency_stats(replayed)
+    print_stats(stats)
+    print("{} APDUs ({} mismatches) in {:.3f} s".format(len(replayed), mismatches, elapsed),
+          file=sys.stderr)
+
+    if args.baseline:
+        base = latency_stats(load_session(args.baseline))
+        regressions = 0
+        for ins in sorted(stats):
+            if ins not in base:
+                continue
+            ratio = stats[ins]["p50"]/base[ins]["p50"] if base[ins]["p50"] > 0 else 1.0
+            flag = ratio > 1 + args.tolerance
+            regressions += flag
+            print("{:<18} p50 {:9.2f} ms vs {:9.2f} ms ({:+.1f}%){}".format(
+                  ins_name(ins), stats[ins]["p50"]/1e3, base[ins]["p50"]/1e3,
+                  (ratio - 1)*100, "  REGRESSION" if flag else ""))
+        if regressions:
+            return EXIT_REGRESSION
+
+    return EXIT_MISMATCH if mismatches else 0
+
+def report(args):
+    stats = latency_stats(load_session(args.session))
+    if args.json:
+        print(json.dumps({ INS_NAMES.get(ins, "{:02x}".format(ins)): s
+                           for ins, s in sorted(stats.items()) }, indent=2))
+    else:
+        print_stats(stats)
+    return 0
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Record and replay APDU sessions")
+    parser.add_argument('--version', action='version', version='%(prog)s {version}'.format(version=__version__))
+    parser.add_argument('--address', default=os.environ.get("LEDGER_PROXY_ADDRESS", DEFAULT_ADDRESS),
+                        help='App APDU address (default LEDGER_PROXY_ADDRESS or {})'.format(DEFAULT_ADDRESS))
+    parser.add_argument('--port', type=int, default=int(os.environ.get("LEDGER_PROXY_PORT", DEFAULT_PORT)),
+                        help='App APDU port (default LEDGER_PROXY_PORT or {})'.format(DEFAULT_PORT))
+    subparsers = parser.add_subparsers(dest="operation")
+    subparsers.required = True
+
+    record_parser = subparsers.add_parser('record', help='Proxy the APDU port and record the session')
+    record_parser.add_argument('session', help='Session log to write')
+    record_parser.add_argument('--listen_address', default="127.0.0.1", help='Proxy address (default 127.0.0.1)')
+    record_parser.add_argument('--listen_port', type=int, default=9998, help='Proxy port (default 9998)')
+    record_parser.add_argument('--append', default=False, action="store_true", help='Append to the session log')
+    record_parser.add_argument('--max_clients', type=int, default=0, help='Exit after this many clients (default unlimited)')
+
+    replay_parser = subparsers.add_parser('replay', help='Replay a session and report latency')
+    replay_parser.add_argument('session', help='Session log to replay')
+    replay_parser.add_argument('-n', '--repeat', type=int, default=1, help='Number of times to replay the session')
+    replay_parser.add_argument('-o', '--output', help='Write the replayed session log (usable as a baseline)')
+    replay_parser.add_argument('--baseline', help='Session log to compare p50 latency against')
+    replay_parser.add_argument('--tolerance', type=float, default=0.10, help='Allowed p50 slowdown vs baseline (default 0.10)')
+    replay_parser.add_argument('--pace', default=False, action="store_true", help='Keep the recorded gaps between APDUs')
+    replay_parser.add_argument('--no_check', default=False, action="store_true", help='Do not compare responses')
+    replay_parser.add_argument('--verbose', default=False, action="store_true", help='Print mismatching responses')
+
+    report_parser = subparsers.add_parser('report', help='Print per-INS latency of a session log')
+    report_parser.add_argument('session', help='Session log')
+    report_parser.add_argument('--json', default=False, action="store_true", help='Output JSON')
+
+    args = parser.parse_args()
+    try:
+        if args.operation == "record":
+            sys.exit(record(args))
+        elif args.operation == "replay":
+            sys.exit(replay(args))
+        else:
+            sys.exit(report(args))
+    except (OSError, ValueError, EOFError) as ex:
+        print("Error: {}".format(ex), file=sys.stderr)
+        sys.exit(1)
@@ -9,6 +9,7 @@ import binascii
 import ctypes
 import string
 import os
+import struct
 
 COIN = 1000000000
 
@@ -25,6 +26,8 @@ MAX_AMOUNT         = ctypes.c_uint64(-1).value
 MAX_VALID_UNTIL    = ctypes.c_uint32(-1).value
 MAX_NONCE          = ctypes.c_uint32(-1).value
 MAX_MEMO_LEN       = 32
+MAX_MESSAGE_LEN    = 4096
+MAX_APDU_DATA_LEN  = 255
 ADDRESS_LEN        = 55
 
 DONGLE = None
@@ -78,6 +81,12 @@ def valid_memo(memo):
     else:
         return memo
 
+def valid_message(message):
+    if message is None or len(message.encode()) > MAX_MESSAGE_LEN:
+        raise argparse.ArgumentTypeError("Length must be at most {} bytes".format(MAX_MESSAGE_LEN))
+    else:
+        return message
+
 def valid_valid_until(valid_until):
     try:
         value = int(valid_until)
@@ -123,6 +132,10 @@ if __name__ == "__main__":
     delegate_parser.add_argument('--valid_until', type=valid_valid_until, help='Valid until')
     delegate_parser.add_argument('--memo', type=valid_memo, help='Transaction memo (publicly visible)')
     delegate_parser.add_argument('--offline', default=False, action="store_true", help='Offline mode')
+    sign_message_parser = subparsers.add_parser('sign-message')
+    sign_message_parser.add_argument('account_number', type=valid_account, help='BIP44 account to sign with (e.g. 42)')
+    sign_message_parser.add_argument('message', type=valid_message, help='Message to sign')
+    sign_message_parser.add_argument('--network', help='Network override')
     test_transaction_parser = subparsers.add_parser('test-transaction')
     test_transaction_parser.add_argument('account_number', type=valid_account, help='BIP44 account generate test transaction with. e.g. 42.')
     test_transaction_parser.add_argument('account_address', type=valid_address("Account"), help='Mina address corresponding to BIP44 account')
@@ -799,6 +812,32 @@ def ledger_sign_tx(tx_type, sender_account, sender_address, receiver, amount, fe
     apdu = bytearray.fromhex(apduMessage)
     return DONGLE.exchange(apdu).hex()
 
+def ledger_sign_message(account, message, network_id):
+    # The message is sent twice (see src/sign_msg.c), first to derive the
+    # nonce and then to compute the challenge.
+    #     CLA 0xe0 CLA
+    #     INS 0x05 INS_SIGN_MSG
+    #     P1  0x00 P1_FIRST or 0x80 P1_MORE
+    #     P2  0x00 derive or 0x01 hash
+    header = struct.pack(">IBI", account, network_id, len(message))
+    for p2 in [0x00, 0x01]:
+        data = header + message if p2 == 0x00 else message
+        p1 = 0x00
+        while True:
+            chunk = data[:MAX_APDU_DATA_LEN]
+            data = data[MAX_APDU_DATA_LEN:]
+            apdu = bytearray([0xe0, 0x05, p1, p2, len(chunk)]) + chunk
+
+            if VERBOSE:
+                print("\n\napduMessage hex ({}) = {}\n".format(len(chunk), apdu.hex()))
+
+            response = DONGLE.exchange(apdu)
+            p1 = 0x80
+            if len(data) == 0:
+                break
+
+    return response.hex()
+
 def print_transaction(operation, account, balance, locked_balance, sender, receiver, amount, fee, nonce, valid_until, memo):
     if network_id_from_string(NETWORK) == TESTNET_ID:
         print("    Network:     testnet")
@@ -882,7 +921,7 @@ def check_tx(tx_type, tx, sender, receiver, amount, fee, valid_until, nonce, mem
                tx["new_delegate"] == receiver and \
                common_tx_check(tx, fee, valid_until, nonce, memo)
 
-__all__ = [TESTNET_ID, MAINNET_ID, TX_TYPE_PAYMENT, TX_TYPE_DELEGATION, ledger_init, ledger_get_address, ledger_sign_tx]
+__all__ = [TESTNET_ID, MAINNET_ID, TX_TYPE_PAYMENT, TX_TYPE_DELEGATION, ledger_init, ledger_get_address, ledger_sign_tx, ledger_sign_message]
 
 if __name__ == "__main__":
     try:
@@ -1234,6 +1273,20 @@ if __name__ == "__main__":
             print("")
             print(json.dumps(transaction_json, indent=2))
 
+        elif args.operation == "sign-message":
+            ledger_init()
+
+            account = args.account_number
+            message = args.message.encode()
+
+            if args.network is not None:
+                NETWORK = args.network
+
+            print("Signing message (please confirm on Ledger device)... ", end="", flush=True)
+            signature = ledger_sign_message(account, message, network_id_from_string(NETWORK))
+            print("done")
+            print("Signature: {}".format(signature))
+
         elif args.operation == "test-transaction":
             ledger_init()
 